@@ -9,15 +9,108 @@
 #define __SI_INCLUDE_H__
 
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <ostream>
 
 
+//! Version number of this library (major version * 100 + minor version), e.g. 100 for version 1.00.
+#define SI_VERSION 101
+
+
 namespace SystemIndicator
 {
 
 
+/**
+\brief Fixed-size bit set of enumeration values.
+\tparam T Specifies the enumeration type.
+\tparam Count Specifies the number of enumeration values.
+*/
+template <typename T, int Count>
+class EnumSet
+{
+
+    public:
+
+        EnumSet()
+        {
+            for (int i = 0; i < numWords; ++i)
+                bits_[i] = 0;
+        }
+
+        //! Returns a set that contains all enumeration values.
+        static EnumSet All()
+        {
+            EnumSet set;
+            for (int i = 0; i < Count; ++i)
+                set.Add(static_cast<T>(i));
+            return set;
+        }
+
+        //! Returns true if the specified value is contained in this set.
+        bool Has(const T value) const
+        {
+            return ((bits_[value / 32] >> (value % 32)) & 0x1) != 0;
+        }
+
+        //! Returns true if all values of the specified set are contained in this set.
+        bool HasAll(const EnumSet& values) const
+        {
+            for (int i = 0; i < numWords; ++i)
+            {
+                if ((bits_[i] & values.bits_[i]) != values.bits_[i])
+                    return false;
+            }
+            return true;
+        }
+
+        //! Returns true if any value of the specified set is contained in this set.
+        bool HasAny(const EnumSet& values) const
+        {
+            for (int i = 0; i < numWords; ++i)
+            {
+                if ((bits_[i] & values.bits_[i]) != 0)
+                    return true;
+            }
+            return false;
+        }
+
+        //! Adds the specified value to this set.
+        EnumSet& Add(const T value)
+        {
+            bits_[value / 32] |= (1u << (value % 32));
+            return *this;
+        }
+
+        //! Removes the specified value from this set.
+        EnumSet& Remove(const T value)
+        {
+            bits_[value / 32] &= ~(1u << (value % 32));
+            return *this;
+        }
+
+        //! Returns true if this set is empty.
+        bool Empty() const
+        {
+            for (int i = 0; i < numWords; ++i)
+            {
+                if (bits_[i] != 0)
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+
+        static const int numWords = (Count + 31) / 32;
+
+        unsigned int bits_[numWords];
+
+};
+
+
 //! Entry enumeration of all available system information.
 enum InformationEntry
 {
@@ -33,7 +126,8 @@ enum InformationEntry
 
     ENTRY_PROCESSORS,           //!< Number of processors.
     ENTRY_LOGICAL_PROCESSORS,   //!< Number of logical processors (this is larger than 'ENTRY_PROCESSORS' if hyper-threading is supported).
-    ENTRY_PROCESSOR_SPEED,      //!< Processor speed (in MHz).
+    ENTRY_PROCESSOR_SPEED,      //!< Processor speed (in MHz). This entry is volatile.
+    ENTRY_EFFECTIVE_PROCESSORS, //!< Number of logical processors the process can effectively use, limited by its CPU affinity and cgroup CPU quota.
 
     ENTRY_L1CACHES,             //!< Number of L1 caches.
     ENTRY_L1CACHE_SIZE,         //!< Size of L1 cache (in KBs).
@@ -48,7 +142,279 @@ enum InformationEntry
     ENTRY_L3CACHE_LINE_SIZE,    //!< Line size of the L3 cache (in Bytes).
 
     ENTRY_TOTAL_MEMORY,         //!< Total physical memory (in MBs).
-    ENTRY_FREE_MEMORY,          //!< Free physical memory (in MBs).
+    ENTRY_EFFECTIVE_MEMORY,     //!< Physical memory the process can effectively use, limited by its cgroup memory limits (in MBs).
+    ENTRY_FREE_MEMORY,          //!< Free physical memory (in MBs). This entry is volatile.
+    ENTRY_AVAILABLE_MEMORY,     //!< Physical memory available for new allocations without swapping, including reclaimable caches (in MBs). This entry is volatile.
+    ENTRY_CACHED_MEMORY,        //!< Physical memory used for the page cache (in MBs). This entry is volatile.
+    ENTRY_BUFFERED_MEMORY,      //!< Physical memory used for raw disk block buffers (in MBs). This entry is volatile.
+    ENTRY_DIRTY_MEMORY,         //!< Physical memory waiting to be written back to disk (in MBs). This entry is volatile.
+    ENTRY_COMMITTED_MEMORY,     //!< Virtual memory committed by all processes (in MBs). This entry is volatile.
+    ENTRY_TOTAL_SWAP,           //!< Total swap space (in MBs). This entry is volatile.
+    ENTRY_FREE_SWAP,            //!< Free swap space (in MBs). This entry is volatile.
+
+    ENTRY_HUGE_PAGE_SIZE,               //!< Default huge page size (in KBs), e.g. 2048 on x86-64, or 0 if huge pages are not supported.
+    ENTRY_HUGE_PAGES,                   //!< Number of pages in the pool of the default huge page size. This entry is volatile.
+    ENTRY_FREE_HUGE_PAGES,              //!< Number of unallocated pages in the pool of the default huge page size. This entry is volatile.
+    ENTRY_RESERVED_HUGE_PAGES,          //!< Number of free pages in the pool of the default huge page size that are already promised to mappings. This entry is volatile.
+    ENTRY_ANON_HUGE_PAGE_MEMORY,        //!< Anonymous memory backed by transparent huge pages (in MBs). This entry is volatile.
+    ENTRY_TRANSPARENT_HUGE_PAGES,       //!< Mode of transparent huge pages, e.g. "always", "madvise", or "never". This entry is volatile.
+    ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG, //!< Defragmentation policy of transparent huge pages, e.g. "madvise" or "defer". This entry is volatile.
+    ENTRY_FREE_HUGE_PAGE_BLOCKS,        //!< Number of free physically contiguous blocks of the default huge page size, i.e. huge pages that can be allocated without compaction. This entry is volatile.
+
+    ENTRY_DISK_READS,                    //!< Number of completed read requests of all physical disks since boot. This entry is volatile.
+    ENTRY_DISK_WRITES,                   //!< Number of completed write requests of all physical disks since boot. This entry is volatile.
+    ENTRY_DISK_BYTES_READ,               //!< Data read from all physical disks since boot (in MBs). This entry is volatile.
+    ENTRY_DISK_BYTES_WRITTEN,            //!< Data written to all physical disks since boot (in MBs). This entry is volatile.
+    ENTRY_DISK_IN_FLIGHT,                //!< Number of I/O requests currently in flight on all physical disks. This entry is volatile.
+    ENTRY_DISK_IO_TIME,                  //!< Time in which at least one request was in flight, summed over all physical disks (in milliseconds). This entry is volatile.
+    ENTRY_DISK_WEIGHTED_IO_TIME,         //!< Sum of the time all requests were in flight on all physical disks, i.e. the integral of the queue depth (in milliseconds). This entry is volatile.
+
+    ENTRY_ROOT_DISK,                     //!< Block device of the root file system, e.g. "nvme0n1" (the whole device for partitions).
+    ENTRY_ROOT_DISK_ROTATIONAL,          //!< 1 if the root disk is a spinning disk, 0 for SSDs and NVMe devices.
+    ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE,  //!< Logical block size of the root disk, i.e. the smallest addressable unit (in Bytes).
+    ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE, //!< Physical block size of the root disk, i.e. the smallest unit written without read-modify-write (in Bytes).
+    ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE,     //!< Preferred I/O size of the root disk, e.g. the stripe width of a RAID (in Bytes). Only available if the device reports it.
+    ENTRY_ROOT_DISK_MAX_IO_SIZE,         //!< Largest request the kernel sends to the root disk (in KBs).
+    ENTRY_ROOT_DISK_READ_AHEAD,          //!< Read-ahead window of the root disk (in KBs).
+    ENTRY_ROOT_DISK_QUEUE_REQUESTS,      //!< Number of requests that can be queued per hardware queue of the root disk.
+    ENTRY_ROOT_DISK_SCHEDULER,           //!< Active I/O scheduler of the root disk, e.g. "mq-deadline" or "none".
+
+    ENTRY_NETWORK_BYTES_RECEIVED,   //!< Data received by all network interfaces except loopback (in MBs). This entry is volatile.
+    ENTRY_NETWORK_BYTES_SENT,       //!< Data sent by all network interfaces except loopback (in MBs). This entry is volatile.
+    ENTRY_NETWORK_PACKETS_RECEIVED, //!< Number of packets received by all network interfaces except loopback. This entry is volatile.
+    ENTRY_NETWORK_PACKETS_SENT,     //!< Number of packets sent by all network interfaces except loopback. This entry is volatile.
+    ENTRY_NETWORK_RECEIVE_ERRORS,   //!< Number of receive errors of all network interfaces except loopback. This entry is volatile.
+    ENTRY_NETWORK_SEND_ERRORS,      //!< Number of transmit errors of all network interfaces except loopback. This entry is volatile.
+    ENTRY_NETWORK_RECEIVE_DROPS,    //!< Number of received packets dropped by all network interfaces except loopback. This entry is volatile.
+    ENTRY_NETWORK_SEND_DROPS,       //!< Number of packets dropped before transmission by all network interfaces except loopback. This entry is volatile.
+
+    ENTRY_TCP_SEGMENTS_SENT,          //!< Number of TCP segments sent since boot, excluding retransmissions. This entry is volatile.
+    ENTRY_TCP_RETRANSMITTED_SEGMENTS, //!< Number of TCP segments retransmitted since boot. This entry is volatile.
+    ENTRY_TCP_LISTEN_OVERFLOWS,       //!< Number of times the accept queue of a listening TCP socket was full since boot. This entry is volatile.
+    ENTRY_TCP_LISTEN_DROPS,           //!< Number of connection requests dropped by listening TCP sockets since boot. This entry is volatile.
+    ENTRY_TCP_BACKLOG_DROPS,          //!< Number of TCP segments dropped because the socket backlog was full since boot. This entry is volatile.
+    ENTRY_TCP_ESTABLISHED,            //!< Number of currently established TCP connections. This entry is volatile.
+    ENTRY_TCP_SOCKETS,                //!< Number of TCP sockets in use, excluding time-wait sockets. This entry is volatile.
+    ENTRY_TCP_TIME_WAIT,              //!< Number of TCP sockets in time-wait state. This entry is volatile.
+    ENTRY_TCP_MEMORY,                 //!< Memory used by TCP socket buffers (in KBs). This entry is volatile.
+    ENTRY_UDP_SOCKETS,                //!< Number of UDP sockets in use. This entry is volatile.
+    ENTRY_UDP_MEMORY,                 //!< Memory used by UDP socket buffers (in KBs). This entry is volatile.
+    ENTRY_UDP_RECEIVE_BUFFER_ERRORS,  //!< Number of UDP datagrams dropped because the receive buffer was full since boot. This entry is volatile.
+    ENTRY_SOCKETS,                    //!< Number of sockets of all protocols. This entry is volatile.
+
+    ENTRY_PROCESS_VIRTUAL_MEMORY,       //!< Size of the virtual address space of the current process (in MBs). This entry is volatile.
+    ENTRY_PROCESS_RESIDENT_MEMORY,      //!< Resident set size (RSS) of the current process (in MBs). This entry is volatile.
+    ENTRY_PROCESS_PEAK_RESIDENT_MEMORY, //!< Peak resident set size of the current process (in MBs). This entry is volatile.
+    ENTRY_PROCESS_SWAPPED_MEMORY,       //!< Memory of the current process that was swapped out (in MBs). This entry is volatile.
+    ENTRY_PROCESS_MINOR_FAULTS,         //!< Number of minor page faults of the current process. This entry is volatile.
+    ENTRY_PROCESS_MAJOR_FAULTS,         //!< Number of major page faults (that required I/O) of the current process. This entry is volatile.
+    ENTRY_PROCESS_VOLUNTARY_SWITCHES,   //!< Number of voluntary context switches (e.g. waiting for I/O or a lock) of the current process. This entry is volatile.
+    ENTRY_PROCESS_INVOLUNTARY_SWITCHES, //!< Number of involuntary context switches (preemptions) of the current process. This entry is volatile.
+    ENTRY_PROCESS_USER_TIME,            //!< CPU time of the current process in user mode (in milliseconds). This entry is volatile.
+    ENTRY_PROCESS_SYSTEM_TIME,          //!< CPU time of the current process in kernel mode (in milliseconds). This entry is volatile.
+    ENTRY_PROCESS_THREADS,              //!< Number of threads of the current process. This entry is volatile.
+    ENTRY_PROCESS_OPEN_FILES,           //!< Number of open file descriptors of the current process. This entry is volatile.
+
+    ENTRY_CPU_PRESSURE_SOME_AVG10,     //!< Share of time in which at least one task was stalled on CPU, averaged over 10 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_CPU_PRESSURE_SOME_AVG60,     //!< Share of time in which at least one task was stalled on CPU, averaged over 60 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_CPU_PRESSURE_SOME_AVG300,    //!< Share of time in which at least one task was stalled on CPU, averaged over 300 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_CPU_PRESSURE_SOME_TOTAL,     //!< Total time in which at least one task was stalled on CPU (in microseconds). This entry is volatile.
+
+    ENTRY_MEMORY_PRESSURE_SOME_AVG10,  //!< Share of time in which at least one task was stalled on memory, averaged over 10 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_SOME_AVG60,  //!< Share of time in which at least one task was stalled on memory, averaged over 60 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_SOME_AVG300, //!< Share of time in which at least one task was stalled on memory, averaged over 300 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_SOME_TOTAL,  //!< Total time in which at least one task was stalled on memory (in microseconds). This entry is volatile.
+
+    ENTRY_MEMORY_PRESSURE_FULL_AVG10,  //!< Share of time in which all non-idle tasks were stalled on memory, averaged over 10 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_FULL_AVG60,  //!< Share of time in which all non-idle tasks were stalled on memory, averaged over 60 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_FULL_AVG300, //!< Share of time in which all non-idle tasks were stalled on memory, averaged over 300 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_MEMORY_PRESSURE_FULL_TOTAL,  //!< Total time in which all non-idle tasks were stalled on memory (in microseconds). This entry is volatile.
+
+    ENTRY_IO_PRESSURE_SOME_AVG10,      //!< Share of time in which at least one task was stalled on I/O, averaged over 10 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_SOME_AVG60,      //!< Share of time in which at least one task was stalled on I/O, averaged over 60 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_SOME_AVG300,     //!< Share of time in which at least one task was stalled on I/O, averaged over 300 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_SOME_TOTAL,      //!< Total time in which at least one task was stalled on I/O (in microseconds). This entry is volatile.
+
+    ENTRY_IO_PRESSURE_FULL_AVG10,      //!< Share of time in which all non-idle tasks were stalled on I/O, averaged over 10 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_FULL_AVG60,      //!< Share of time in which all non-idle tasks were stalled on I/O, averaged over 60 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_FULL_AVG300,     //!< Share of time in which all non-idle tasks were stalled on I/O, averaged over 300 seconds (in 0.01 %). This entry is volatile.
+    ENTRY_IO_PRESSURE_FULL_TOTAL,      //!< Total time in which all non-idle tasks were stalled on I/O (in microseconds). This entry is volatile.
+
+    ENTRY_COUNT,                //!< Number of information entries (not an entry itself).
+};
+
+
+//! Set of information entries, e.g. to query only specific entries.
+typedef EnumSet<InformationEntry, ENTRY_COUNT> InformationEntrySet;
+
+
+/**
+\brief Cost enumeration of information entries, ordered from cheapest to most expensive.
+\see GetEntryCost
+*/
+enum InformationEntryCost
+{
+    ENTRY_COST_UNAVAILABLE, //!< The entry is not available on the host platform.
+    ENTRY_COST_CONSTANT,    //!< The entry is a compile-time constant.
+    ENTRY_COST_INSTRUCTION, //!< The entry is queried with CPU instructions only (e.g. CPUID).
+    ENTRY_COST_SYSCALL,     //!< The entry is queried with a single system call.
+    ENTRY_COST_FILE_IO,     //!< The entry is read from one or a few files (or registry keys).
+    ENTRY_COST_ENUMERATION, //!< The entry is accumulated by enumerating many objects, files, or directories.
+};
+
+
+/**
+\brief CPU feature enumeration.
+\remarks Features that require operating system support (e.g. AVX and AVX-512) are only reported if the OS saves the respective register state.
+\see CPUFeatureSet
+*/
+enum CPUFeature
+{
+    CPU_FEATURE_MMX,            //!< IA MMX.
+    CPU_FEATURE_EXT_MMX,        //!< AMD extended MMX.
+    CPU_FEATURE_3DNOW,          //!< AMD 3DNow!
+    CPU_FEATURE_EXT_3DNOW,      //!< AMD extended 3DNow!
+
+    CPU_FEATURE_SSE,            //!< IA SSE.
+    CPU_FEATURE_SSE2,           //!< IA SSE2.
+    CPU_FEATURE_SSE3,           //!< IA SSE3.
+    CPU_FEATURE_SSSE3,          //!< IA supplemental SSE3.
+    CPU_FEATURE_SSE4_1,         //!< IA SSE4.1.
+    CPU_FEATURE_SSE4_2,         //!< IA SSE4.2.
+    CPU_FEATURE_SSE4A,          //!< AMD SSE4a.
+
+    CPU_FEATURE_AVX,            //!< Advanced Vector Extensions.
+    CPU_FEATURE_AVX2,           //!< Advanced Vector Extensions 2.
+    CPU_FEATURE_FMA,            //!< Fused multiply-add (FMA3).
+    CPU_FEATURE_FMA4,           //!< AMD fused multiply-add (FMA4).
+    CPU_FEATURE_F16C,           //!< Half-precision conversion.
+
+    CPU_FEATURE_AVX512F,        //!< AVX-512 foundation.
+    CPU_FEATURE_AVX512CD,       //!< AVX-512 conflict detection.
+    CPU_FEATURE_AVX512DQ,       //!< AVX-512 doubleword and quadword instructions.
+    CPU_FEATURE_AVX512BW,       //!< AVX-512 byte and word instructions.
+    CPU_FEATURE_AVX512VL,       //!< AVX-512 vector length extensions.
+    CPU_FEATURE_AVX512IFMA,     //!< AVX-512 integer fused multiply-add.
+    CPU_FEATURE_AVX512VBMI,     //!< AVX-512 vector byte manipulation instructions.
+    CPU_FEATURE_AVX512VBMI2,    //!< AVX-512 vector byte manipulation instructions 2.
+    CPU_FEATURE_AVX512VNNI,     //!< AVX-512 vector neural network instructions.
+    CPU_FEATURE_AVX512BITALG,   //!< AVX-512 bit algorithms.
+    CPU_FEATURE_AVX512VPOPCNTDQ,//!< AVX-512 vector population count.
+
+    CPU_FEATURE_POPCNT,         //!< Population count instruction.
+    CPU_FEATURE_LZCNT,          //!< Leading zero count instruction (ABM).
+    CPU_FEATURE_BMI1,           //!< Bit manipulation instructions 1.
+    CPU_FEATURE_BMI2,           //!< Bit manipulation instructions 2.
+    CPU_FEATURE_ADX,            //!< Multi-precision add-carry instructions.
+    CPU_FEATURE_MOVBE,          //!< Move data after swapping bytes.
+
+    CPU_FEATURE_AES,            //!< AES instruction set.
+    CPU_FEATURE_PCLMULQDQ,      //!< Carry-less multiplication.
+    CPU_FEATURE_SHA,            //!< SHA extensions.
+    CPU_FEATURE_RDRAND,         //!< On-chip random number generator.
+    CPU_FEATURE_RDSEED,         //!< On-chip random seed generator.
+
+    CPU_FEATURE_HTT,            //!< Hyper-threading.
+    CPU_FEATURE_INVARIANT_TSC,  //!< Time stamp counter runs at a constant rate in all ACPI P-, C- and T-states.
+
+    CPU_FEATURE_NEON,           //!< ARM Advanced SIMD (NEON).
+    CPU_FEATURE_SVE,            //!< ARM Scalable Vector Extension.
+
+    CPU_FEATURE_COUNT,          //!< Number of CPU features (not a feature itself).
+};
+
+
+
+/**
+\brief Bit set of CPU features.
+\remarks This can be used to branch on CPU features in performance critical code, without any string comparisons.
+\see QueryCPUFeatures
+*/
+typedef EnumSet<CPUFeature, CPU_FEATURE_COUNT> CPUFeatureSet;
+
+
+//! Value type enumeration of an information entry inside an 'InformationSnapshot'.
+enum InformationValueType
+{
+    VALUE_NONE,     //!< The entry is not available.
+    VALUE_NUMBER,   //!< The entry is an unsigned integral number.
+    VALUE_TEXT,     //!< The entry is a null-terminated string.
+};
+
+
+/**
+\brief Fixed-layout snapshot of all information entries, indexed by 'InformationEntry'.
+\remarks Numbers are stored as numbers and strings are stored in an internal fixed-size text buffer,
+so a snapshot can be filled without any heap allocations and copied with a plain memory copy.
+\see QueryInformation(InformationSnapshot&)
+*/
+class InformationSnapshot
+{
+
+    public:
+
+        //! Capacity (in bytes) of the internal text buffer, shared by all text entries.
+        static const std::size_t textCapacity = 2048;
+
+        InformationSnapshot();
+
+        //! Removes all entries from this snapshot.
+        void Clear();
+
+        //! Returns true if the specified entry is available.
+        bool Has(const InformationEntry entry) const
+        {
+            return (values_[entry].type != VALUE_NONE);
+        }
+
+        //! Returns the value type of the specified entry.
+        InformationValueType GetType(const InformationEntry entry) const
+        {
+            return static_cast<InformationValueType>(values_[entry].type);
+        }
+
+        //! Returns the number of the specified entry, or 0 if the entry is not a number.
+        unsigned long long GetNumber(const InformationEntry entry) const
+        {
+            return (values_[entry].type == VALUE_NUMBER ? values_[entry].number : 0);
+        }
+
+        //! Returns the null-terminated string of the specified entry, or an empty string if the entry is not a text.
+        const char* GetText(const InformationEntry entry) const
+        {
+            return (values_[entry].type == VALUE_TEXT ? text_ + values_[entry].textOffset : "");
+        }
+
+        //! Sets the specified entry to a number.
+        void SetNumber(const InformationEntry entry, unsigned long long number);
+
+        /**
+        \brief Sets the specified entry to a copy of the specified string.
+        \return False if the text buffer is exhausted, in which case the string is truncated.
+        */
+        bool SetText(const InformationEntry entry, const char* text, std::size_t length);
+
+        //! Sets the specified entry to a copy of the specified null-terminated string.
+        bool SetText(const InformationEntry entry, const char* text);
+
+        //! Removes the specified entry from this snapshot. Its text slot is kept, so a new text for this entry can reuse it.
+        void Remove(const InformationEntry entry);
+
+    private:
+
+        struct Value
+        {
+            unsigned long long  number;
+            unsigned short      textOffset;
+            unsigned short      textLength;
+            unsigned short      textSlot;   // Reserved size of the text slot (including the null terminator), kept when the entry is removed or overwritten
+            unsigned char       type;
+        };
+
+        Value       values_[ENTRY_COUNT];
+        std::size_t textSize_;
+        char        text_[textCapacity];
+
 };
 
 
@@ -62,9 +428,152 @@ typedef std::map<InformationEntry, std::string> InformationEntryMap;
 /**
 \brief Main function to query system information.
 \return Map of all information entries available for the host system.
+\remarks This is a convenience wrapper for 'MakeEntryMap' and 'QueryInformation(InformationSnapshot&)'.
 */
 InformationEntryMap QueryInformation();
 
+/**
+\brief Queries all information entries into the specified snapshot.
+\remarks This does not allocate any heap memory, so the snapshot can be reused for continuous queries.
+\see InformationSnapshot
+*/
+void QueryInformation(InformationSnapshot& snapshot);
+
+/**
+\brief Queries only the specified information entries into the specified snapshot.
+\remarks Only the collectors that are required for the specified entries are executed,
+e.g. querying only 'ENTRY_FREE_MEMORY' does not query the CPU or the operating system name.
+All other entries are removed from the snapshot.
+\see GetEntryCost
+*/
+void QueryInformation(InformationSnapshot& snapshot, const InformationEntrySet& entries);
+
+/**
+\brief Returns the cost to query the specified information entry on the host platform.
+\remarks All entries that share the same collector have the same cost, since they are queried together.
+*/
+InformationEntryCost GetEntryCost(const InformationEntry entry);
+
+/**
+\brief Returns true if the specified entry is volatile, i.e. it can change while the process is running (e.g. 'ENTRY_FREE_MEMORY').
+\remarks All other entries are static (e.g. 'ENTRY_CPU_NAME') and are only queried once for the hardware profile.
+\see GetHardwareProfile
+*/
+bool IsVolatileEntry(const InformationEntry entry);
+
+/**
+\brief Returns the hardware profile, which contains all static entries of the host system.
+\remarks The profile is queried only once on the first call (thread-safe) and shared by all subsequent queries,
+i.e. 'QueryInformation' only runs the collectors of volatile entries and copies all static entries from this profile.
+\see IsVolatileEntry
+*/
+const InformationSnapshot& GetHardwareProfile();
+
+/**
+\brief Updates only the volatile entries of the specified snapshot.
+\remarks This is the cheapest way to continuously monitor a system, e.g. free memory:
+\code
+InformationSnapshot snapshot;
+QueryInformation(snapshot);
+for (;;)
+{
+    RefreshInformation(snapshot);
+    // ...
+}
+\endcode
+*/
+void RefreshInformation(InformationSnapshot& snapshot);
+
+/**
+\brief Converts the specified snapshot into an information entry map.
+\remarks Numbers are converted into decimal strings, with decimal places for fixed-point entries (see InformationEntryDecimals).
+*/
+InformationEntryMap MakeEntryMap(const InformationSnapshot& snapshot);
+
+/**
+\brief Returns the features of the host CPU.
+\remarks The features are detected only once (thread-safe) and cached for all subsequent calls.
+This is the same feature set that is listed in the 'ENTRY_CPU_EXT' entry.
+*/
+const CPUFeatureSet& QueryCPUFeatures();
+
+//! Returns the display name of the specified CPU feature, e.g. "AVX-512F".
+const char* CPUFeatureName(const CPUFeature feature);
+
+/**
+\brief Sets the root directory that is prepended to all procfs and sysfs paths, e.g. "/tmp/fake-root" to read "/tmp/fake-root/proc/meminfo".
+\param[in] root Specifies the new root directory. This can be null or empty to read from the real file system again.
+\remarks This is only used on Linux, to query synthetic machine descriptions for testing and benchmarking.
+It is not thread-safe and must not be called while other queries are in progress.
+Files that are kept open for continuous sampling (e.g. "/proc/meminfo") are not affected once they have been opened.
+*/
+void SetFileSystemRoot(const char* root);
+
+//! Returns the root directory for procfs and sysfs paths, or an empty string if the real file system is used.
+const char* GetFileSystemRoot();
+
+//! Returns the display name of the specified entry, e.g. "Free Memory" for 'ENTRY_FREE_MEMORY'.
+const char* InformationEntryName(const InformationEntry entry);
+
+//! Returns the unit of the specified entry, e.g. "MB" for 'ENTRY_FREE_MEMORY', or an empty string if the entry has no unit.
+const char* InformationEntryUnit(const InformationEntry entry);
+
+//! Returns the machine-readable key of the specified entry, including its unit, e.g. "free_memory_mb" for 'ENTRY_FREE_MEMORY'.
+const char* InformationEntryKey(const InformationEntry entry);
+
+/**
+\brief Returns the number of decimal places of the specified numeric entry, which is stored as fixed-point number.
+\remarks For example, 'ENTRY_CPU_PRESSURE_SOME_AVG10' has 2 decimal places, i.e. 1.25 % is stored as 125.
+The formatted output and the text export formats write these entries with decimal places. This is 0 for all integral entries.
+*/
+unsigned int InformationEntryDecimals(const InformationEntry entry);
+
+/**
+\brief Returns true if the specified entry is a monotonic counter, e.g. 'ENTRY_DISK_READS' counts all reads since boot.
+\remarks Counters only decrease on a reset (e.g. a reboot or a restart of the process), so their rates are computed from the difference of two snapshots.
+All other numeric entries are gauges, i.e. the current value of a quantity.
+*/
+bool InformationEntryIsCounter(const InformationEntry entry);
+
+/**
+\brief Output function for the formatted text of a snapshot.
+\param[in] text Specifies the next part of the formatted text. This is not null-terminated.
+\param[in] length Specifies the length of the text.
+\param[in] userData Specifies the user data that was passed to 'FormatInformation'.
+*/
+typedef void (*FormatSink)(const char* text, std::size_t length, void* userData);
+
+/**
+\brief Formats all available entries of the specified snapshot in clearly arranged format and passes the text to the specified sink.
+\remarks This does not allocate any heap memory. The text is passed to the sink in chunks of up to 256 characters.
+\see operator << (std::ostream&, const InformationSnapshot&)
+*/
+void FormatInformation(const InformationSnapshot& snapshot, FormatSink sink, void* userData);
+
+/**
+\brief Formats all available entries of the specified snapshot into the specified buffer.
+\return Length of the entire formatted text (without the null terminator), like 'snprintf'.
+The text is truncated if this is greater than or equal to the buffer size.
+\remarks This does not allocate any heap memory, so it can be used when the heap is exhausted or corrupted.
+It is not async-signal-safe, though; for a crash report, format the text in advance and only write the buffer in the signal handler:
+\code
+static char buffer[4096];
+static std::size_t length = 0;
+InformationSnapshot snapshot;
+QueryInformation(snapshot);
+length = std::min(FormatInformation(snapshot, buffer, sizeof(buffer)), sizeof(buffer) - 1);
+// In the signal handler:
+write(STDERR_FILENO, buffer, length);
+\endcode
+*/
+std::size_t FormatInformation(const InformationSnapshot& snapshot, char* buffer, std::size_t size);
+
+/**
+\brief Outputs all available entries of the specified snapshot in clearly arranged format.
+\remarks This is a wrapper for 'FormatInformation' and does not allocate any heap memory itself.
+*/
+std::ostream& operator << (std::ostream& stream, const InformationSnapshot& snapshot);
+
 /**
 \brief Outputs the specified entries in clearly arranged format.
 \see QueryInformation
@@ -73,8 +582,9 @@ InformationEntryMap QueryInformation();
 InformationEntryMap entries = QueryInformation();
 std::cout << entries;
 \endcode
+This is a wrapper for 'FormatInformation'.
 */
-std::ostream& operator << (std::ostream& stream, InformationEntryMap entries);
+std::ostream& operator << (std::ostream& stream, const InformationEntryMap& entries);
 
 
 } // /namespace SystemIndicator
@@ -0,0 +1,164 @@
+/*
+ * SystemIndicatorCollector.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_BACKGROUND_COLLECTOR_H__
+#define __SI_BACKGROUND_COLLECTOR_H__
+
+
+#include "SystemIndicator.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+namespace SystemIndicator
+{
+
+
+//! Configuration of a 'BackgroundCollector'.
+struct BackgroundCollectorConfig
+{
+    BackgroundCollectorConfig() :
+        interval    ( 1000                          ),
+        history     ( 4                             ),
+        entries     ( InformationEntrySet::All()    )
+    {
+    }
+
+    unsigned int        interval;   //!< Sampling interval (in milliseconds). By default 1000.
+    std::size_t         history;    //!< Number of snapshots that are kept in the ring buffer (at least 2). By default 4.
+    InformationEntrySet entries;    //!< Entries that are queried for each snapshot. By default all entries.
+};
+
+/**
+\brief Background thread that periodically queries the system information and publishes the snapshots to any number of reader threads.
+\remarks The snapshots are published through a ring buffer of the last N snapshots, where each slot is guarded by a sequence lock.
+Readers never block the collector thread and never block each other: a read is a plain memory copy of the latest slot
+without any locks or system calls, which is only repeated in the rare case that the collector overwrote the slot during the copy.
+\code
+BackgroundCollectorConfig config;
+config.interval = 100;
+BackgroundCollector collector(config);
+collector.Start();
+
+// On any request-handling thread:
+InformationSnapshot snapshot;
+if (collector.Read(snapshot))
+    // use snapshot.GetNumber(ENTRY_FREE_MEMORY) ...
+\endcode
+*/
+class BackgroundCollector
+{
+
+    public:
+
+        //! Allocates the ring buffer. The collector thread is not started until 'Start' is called.
+        BackgroundCollector(const BackgroundCollectorConfig& config = BackgroundCollectorConfig());
+
+        //! Stops the collector thread.
+        ~BackgroundCollector();
+
+        BackgroundCollector(const BackgroundCollector&) = delete;
+        BackgroundCollector& operator = (const BackgroundCollector&) = delete;
+
+        /**
+        \brief Starts the collector thread, which takes the first snapshot immediately.
+        \remarks This is not thread-safe with respect to 'Stop'; both must be called by the thread that owns the collector.
+        \return False if the collector thread is already running.
+        */
+        bool Start();
+
+        //! Stops the collector thread and waits until it has finished. The published snapshots remain readable.
+        void Stop();
+
+        //! Returns true if the collector thread is running.
+        bool IsRunning() const
+        {
+            return thread_.joinable();
+        }
+
+        /**
+        \brief Copies the latest snapshot. This is thread-safe and lock-free.
+        \param[out] timestamp Optional pointer to receive the time (in nanoseconds of 'std::chrono::steady_clock') when the snapshot was taken.
+        \return False if no snapshot has been published yet.
+        */
+        bool Read(InformationSnapshot& snapshot, unsigned long long* timestamp = NULL) const;
+
+        /**
+        \brief Copies an older snapshot from the ring buffer. This is thread-safe and lock-free.
+        \param[in] age Specifies the age of the snapshot, where 0 is the latest snapshot and 'GetHistorySize() - 1' is the oldest one.
+        \return False if the snapshot of the specified age has not been published yet or if it was overwritten during the copy.
+        */
+        bool ReadHistory(std::size_t age, InformationSnapshot& snapshot, unsigned long long* timestamp = NULL) const;
+
+        /**
+        \brief Returns the number of the specified entry of the latest snapshot without copying the entire snapshot.
+        \remarks This is the cheapest way to read a single number from the collector, e.g. 'ENTRY_FREE_MEMORY'.
+        \return The number of the specified entry, or 0 if the entry is not a number or no snapshot has been published yet.
+        */
+        unsigned long long GetNumber(const InformationEntry entry) const;
+
+        //! Returns the number of snapshots that have been published since the collector was created.
+        unsigned long long GetSampleCount() const
+        {
+            return published_.load(std::memory_order_acquire);
+        }
+
+        //! Returns the number of snapshots the ring buffer can hold.
+        std::size_t GetHistorySize() const
+        {
+            return numSlots_;
+        }
+
+        //! Returns the configuration of this collector.
+        const BackgroundCollectorConfig& GetConfig() const
+        {
+            return config_;
+        }
+
+    private:
+
+        //! Slot of the ring buffer. The sequence number is odd while the slot is being written.
+        struct Slot
+        {
+            std::atomic<unsigned long long> sequence;
+            unsigned long long              timestamp;
+            InformationSnapshot             snapshot;
+        };
+
+        void Run();
+        void Publish(const InformationSnapshot& snapshot, unsigned long long timestamp);
+
+        bool ReadSlot(unsigned long long sample, InformationSnapshot& snapshot, unsigned long long* timestamp) const;
+
+        BackgroundCollectorConfig       config_;
+        std::size_t                     numSlots_;
+        std::unique_ptr<Slot[]>         slots_;
+
+        //! Number of published snapshots; the latest snapshot is in slot '(published_ - 1) % numSlots_'. Padded to its own cache line.
+        char                            padding0_[64];
+        std::atomic<unsigned long long> published_;
+        char                            padding1_[64];
+
+        std::thread                     thread_;
+        std::mutex                      mutex_;
+        std::condition_variable         stopSignal_;
+        bool                            stopRequested_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,167 @@
+/*
+ * SystemIndicatorDispatch.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_DISPATCH_H__
+#define __SI_DISPATCH_H__
+
+
+#include "SystemIndicator.h"
+#include <atomic>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+\brief Dispatch tier enumeration, ordered from lowest to highest.
+\remarks Each tier requires all CPU features of the lower tiers.
+\see GetDispatchTierFeatures
+*/
+enum DispatchTier
+{
+    DISPATCH_TIER_SCALAR,   //!< Portable scalar code, no CPU features required.
+    DISPATCH_TIER_SSE4_2,   //!< SSE up to SSE4.2 and POPCNT (x86-64-v2).
+    DISPATCH_TIER_AVX2,     //!< AVX, AVX2, FMA, F16C, BMI1, BMI2, LZCNT, and MOVBE (x86-64-v3).
+    DISPATCH_TIER_AVX512,   //!< AVX-512 F, CD, BW, DQ, and VL (x86-64-v4).
+
+    DISPATCH_TIER_COUNT,    //!< Number of dispatch tiers (not a tier itself).
+};
+
+
+//! Returns the name of the specified dispatch tier, e.g. "AVX2".
+const char* DispatchTierName(const DispatchTier tier);
+
+//! Returns the set of CPU features the specified dispatch tier requires.
+CPUFeatureSet GetDispatchTierFeatures(const DispatchTier tier);
+
+/**
+\brief Returns the highest dispatch tier the host CPU supports, limited by the current dispatch tier limit.
+\see SetDispatchTierLimit
+*/
+DispatchTier GetSupportedDispatchTier();
+
+/**
+\brief Limits the dispatch tier for all dispatchers that are bound afterwards.
+\remarks This can be used to test and benchmark lower tiers on a machine that supports higher tiers.
+Dispatchers which are already bound keep their function until 'FunctionDispatcher::Rebind' is called.
+The initial limit can also be set with the environment variable "SI_DISPATCH_TIER" (e.g. "SI_DISPATCH_TIER=sse4.2").
+*/
+void SetDispatchTierLimit(const DispatchTier tier);
+
+//! Returns the current dispatch tier limit. By default DISPATCH_TIER_AVX512, or the value of the "SI_DISPATCH_TIER" environment variable.
+DispatchTier GetDispatchTierLimit();
+
+
+template <typename Signature>
+class FunctionDispatcher;
+
+/**
+\brief Runtime dispatcher for multiple implementations of the same kernel.
+\remarks The best registered implementation is bound on first use. Subsequent calls only cost one indirect call.
+Registration is not thread-safe and should be done during static initialization or before the first call.
+\code
+static float SumScalar(const float* data, std::size_t n);
+static float SumAVX2(const float* data, std::size_t n);
+
+static FunctionDispatcher<float(const float*, std::size_t)> Sum(SumScalar);
+
+Sum.Register(DISPATCH_TIER_AVX2, SumAVX2);
+float s = Sum(data, n);
+\endcode
+*/
+template <typename R, typename... Args>
+class FunctionDispatcher<R(Args...)>
+{
+
+    public:
+
+        typedef R (*Function)(Args...);
+
+        //! Constructs the dispatcher with the scalar fallback implementation, which must not be null.
+        explicit FunctionDispatcher(Function scalarFunction) :
+            bound_      ( nullptr              ),
+            boundTier_  ( DISPATCH_TIER_SCALAR )
+        {
+            for (int i = 0; i < DISPATCH_TIER_COUNT; ++i)
+                functions_[i] = nullptr;
+            functions_[DISPATCH_TIER_SCALAR] = scalarFunction;
+        }
+
+        FunctionDispatcher(const FunctionDispatcher&) = delete;
+        FunctionDispatcher& operator = (const FunctionDispatcher&) = delete;
+
+        //! Registers the implementation for the specified tier and resets the current binding.
+        FunctionDispatcher& Register(const DispatchTier tier, Function function)
+        {
+            functions_[tier] = function;
+            bound_.store(nullptr, std::memory_order_release);
+            return *this;
+        }
+
+        //! Returns the bound function and binds the best implementation on first use.
+        Function Get() const
+        {
+            Function function = bound_.load(std::memory_order_acquire);
+            return (function != nullptr ? function : Rebind());
+        }
+
+        //! Calls the bound function.
+        R operator () (Args... args) const
+        {
+            return Get()(args...);
+        }
+
+        //! Binds the best implementation for the supported dispatch tier and returns it.
+        Function Rebind() const
+        {
+            return Rebind(GetSupportedDispatchTier());
+        }
+
+        /**
+        \brief Binds the best implementation that does not exceed the specified tier and returns it.
+        \remarks The specified tier is clamped to the tier that is supported by the host CPU.
+        */
+        Function Rebind(DispatchTier maxTier) const
+        {
+            const DispatchTier supportedTier = GetSupportedDispatchTier();
+            if (maxTier > supportedTier)
+                maxTier = supportedTier;
+
+            int tier = static_cast<int>(maxTier);
+            while (tier > DISPATCH_TIER_SCALAR && functions_[tier] == nullptr)
+                --tier;
+
+            boundTier_.store(tier, std::memory_order_relaxed);
+            bound_.store(functions_[tier], std::memory_order_release);
+
+            return functions_[tier];
+        }
+
+        //! Returns the tier of the currently bound implementation. Only valid after the first call.
+        DispatchTier GetBoundTier() const
+        {
+            return static_cast<DispatchTier>(boundTier_.load(std::memory_order_relaxed));
+        }
+
+    private:
+
+        Function                        functions_[DISPATCH_TIER_COUNT];
+        mutable std::atomic<Function>   bound_;
+        mutable std::atomic<int>        boundTier_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
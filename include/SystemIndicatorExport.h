@@ -0,0 +1,77 @@
+/*
+ * SystemIndicatorExport.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_EXPORT_H__
+#define __SI_EXPORT_H__
+
+
+#include "SystemIndicator.h"
+
+
+namespace SystemIndicator
+{
+
+
+//! Machine-readable export formats of an 'InformationSnapshot'.
+enum ExportFormat
+{
+    /**
+    Single JSON object in one line, terminated by a new-line character, e.g. {"os_family":"LINUX","free_memory_mb":2048}.
+    The keys are from 'InformationEntryKey'.
+    */
+    EXPORT_FORMAT_JSON,
+
+    /**
+    Prometheus text exposition format (version 0.0.4).
+    Each number is exported as gauge named "systemindicator_<key>", e.g. "systemindicator_free_memory_mb 2048",
+    except for monotonic counters (see 'InformationEntryIsCounter'), which are exported as counter named "systemindicator_<key>_total",
+    e.g. "systemindicator_disk_reads_total 6866". All texts are exported as labels of the info metric "systemindicator_info", which always has the value 1.
+    */
+    EXPORT_FORMAT_PROMETHEUS,
+
+    /**
+    Compact length-prefixed binary record. All integers are in little-endian byte order:
+    - u32 record length in bytes (including this field)
+    - u8 magic number 'S', u8 format version (1), u16 value of 'ENTRY_COUNT' of the writer
+    - u16 number of fields, followed by the fields
+    Each field is: u8 entry ('InformationEntry'), u8 type ('InformationValueType'),
+    and either a u64 number or a u16 text length followed by the text (without null terminator).
+    The entry values are only compatible between writers and readers of the same library version.
+    \see ReadBinaryRecord
+    */
+    EXPORT_FORMAT_BINARY,
+};
+
+/**
+\brief Writes all available entries of the specified snapshot in the specified format to the specified sink.
+\remarks This writes directly from the snapshot into the sink without any intermediate strings and does not allocate any heap memory.
+\see FormatSink
+*/
+void ExportInformation(const InformationSnapshot& snapshot, const ExportFormat format, FormatSink sink, void* userData);
+
+/**
+\brief Writes all available entries of the specified snapshot in the specified format into the specified buffer.
+\return Length of the entire record (without the null terminator), like 'snprintf'. The record is truncated if this is greater than or equal to the buffer size.
+\remarks A null terminator is appended in all formats, but binary records can also contain null characters inside.
+*/
+std::size_t ExportInformation(const InformationSnapshot& snapshot, const ExportFormat format, char* buffer, std::size_t size);
+
+/**
+\brief Reads a binary record that was written with 'EXPORT_FORMAT_BINARY' into the specified snapshot.
+\return Length of the record, or 0 if the record is incomplete, malformed, or from an incompatible library version.
+*/
+std::size_t ReadBinaryRecord(const char* data, std::size_t size, InformationSnapshot& snapshot);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
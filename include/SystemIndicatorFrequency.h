@@ -0,0 +1,127 @@
+/*
+ * SystemIndicatorFrequency.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_FREQUENCY_H__
+#define __SI_FREQUENCY_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+/* Declare the RDTSC intrinsic directly, so this header does not pull all intrinsics headers into the client code */
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+extern "C" unsigned __int64 __rdtsc();
+#   pragma intrinsic(__rdtsc)
+#   define SI_RDTSC() __rdtsc()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#   define SI_RDTSC() __builtin_ia32_rdtsc()
+#endif
+
+
+namespace SystemIndicator
+{
+
+
+//! Frequency state of a single logical CPU. All frequencies are in kHz and 0 if they are not available.
+struct CPUFrequency
+{
+    CPUFrequency() :
+        cpu         ( 0 ),
+        current     ( 0 ),
+        minimum     ( 0 ),
+        maximum     ( 0 ),
+        hardwareMin ( 0 ),
+        hardwareMax ( 0 )
+    {
+        governor[0] = '\0';
+    }
+
+    unsigned int        cpu;            //!< Logical CPU number.
+    unsigned long long  current;        //!< Current frequency.
+    unsigned long long  minimum;        //!< Minimum frequency the governor may select.
+    unsigned long long  maximum;        //!< Maximum frequency the governor may select.
+    unsigned long long  hardwareMin;    //!< Minimum frequency supported by the hardware.
+    unsigned long long  hardwareMax;    //!< Maximum frequency supported by the hardware (including turbo frequencies, if reported by the driver).
+    char                governor[32];   //!< Name of the frequency governor, e.g. "performance" or "schedutil". Empty if not available.
+};
+
+/**
+\brief Queries the frequency state of all online logical CPUs.
+\remarks On Linux this reads "/sys/devices/system/cpu/cpuN/cpufreq". If cpufreq is not available (e.g. inside most virtual machines),
+only the current frequencies are read from "/proc/cpuinfo". The vector is only resized if the number of CPUs has changed,
+so repeated queries with the same vector do not allocate any heap memory.
+\return False if no frequency could be queried.
+*/
+bool QueryCPUFrequencies(std::vector<CPUFrequency>& frequencies);
+
+
+//! Source of the time-stamp counter (TSC) frequency.
+enum TSCSource
+{
+    TSC_SOURCE_NONE,        //!< The TSC frequency is not available.
+    TSC_SOURCE_CPUID,       //!< Crystal clock frequency and ratio from CPUID leaf 0x15.
+    TSC_SOURCE_CPUID_BASE,  //!< Processor base frequency from CPUID leaf 0x16.
+    TSC_SOURCE_HYPERVISOR,  //!< Frequency reported by the hypervisor through CPUID leaf 0x40000010.
+    TSC_SOURCE_CALIBRATED,  //!< Measured against a raw monotonic clock of the operating system.
+};
+
+//! Time-stamp counter (TSC) information of the host CPU.
+struct TSCInfo
+{
+    TSCInfo() :
+        frequency   ( 0                 ),
+        source      ( TSC_SOURCE_NONE   ),
+        invariant   ( false             )
+    {
+    }
+
+    //! Converts the specified number of TSC ticks into nanoseconds.
+    double ToNanoseconds(unsigned long long ticks) const
+    {
+        return (frequency > 0 ? static_cast<double>(ticks) * 1.0e9 / static_cast<double>(frequency) : 0.0);
+    }
+
+    unsigned long long  frequency;  //!< TSC frequency (in Hz), or 0 if not available.
+    TSCSource           source;     //!< Source of the TSC frequency.
+    bool                invariant;  //!< Specifies whether the TSC runs at a constant rate in all power states (see 'CPU_FEATURE_INVARIANT_TSC').
+};
+
+/**
+\brief Returns the TSC frequency of the host CPU.
+\remarks The frequency is taken from CPUID where available, otherwise it is calibrated against 'CLOCK_MONOTONIC_RAW' (on Linux)
+or the performance counter (on Windows) for about 20 milliseconds. It is determined only once (thread-safe) and cached for all subsequent calls.
+\code
+const TSCInfo& tsc = QueryTSCInfo();
+const unsigned long long start = ReadTimestampCounter();
+// ...
+const double ns = tsc.ToNanoseconds(ReadTimestampCounter() - start);
+\endcode
+*/
+const TSCInfo& QueryTSCInfo();
+
+//! Returns the name of the specified TSC source, e.g. "CPUID 0x15".
+const char* TSCSourceName(const TSCSource source);
+
+//! Reads the time-stamp counter with the RDTSC instruction, or returns 0 on architectures without TSC.
+inline unsigned long long ReadTimestampCounter()
+{
+    #ifdef SI_RDTSC
+    return static_cast<unsigned long long>(SI_RDTSC());
+    #else
+    return 0;
+    #endif
+}
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,76 @@
+/*
+ * SystemIndicatorLimits.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_LIMITS_H__
+#define __SI_LIMITS_H__
+
+
+#include "SystemIndicatorTopology.h"
+
+
+namespace SystemIndicator
+{
+
+
+/**
+\brief Effective resource limits of the current process, e.g. inside a container, next to the raw host values.
+\remarks All memory sizes are in KBs. Limits are 0 if they are unlimited or not available on the host platform.
+*/
+struct ResourceLimits
+{
+    ResourceLimits() :
+        hostCPUs            ( 0 ),
+        hostMemory          ( 0 ),
+        cgroupVersion       ( 0 ),
+        cpuQuota            ( 0 ),
+        memoryMax           ( 0 ),
+        memoryHigh          ( 0 ),
+        effectiveCPUs       ( 0 ),
+        effectiveMemory     ( 0 ),
+        periods             ( 0 ),
+        throttledPeriods    ( 0 ),
+        throttledTime       ( 0 )
+    {
+    }
+
+    unsigned int        hostCPUs;           //!< Number of online logical CPUs of the host.
+    unsigned long long  hostMemory;         //!< Total physical memory of the host.
+
+    unsigned int        cgroupVersion;      //!< Version of the cgroup hierarchy the limits are read from (1 or 2), or 0 if not available.
+    double              cpuQuota;           //!< CPU bandwidth limit in number of CPUs, e.g. 2.5 for "250000 100000" in "cpu.max".
+    CPUSet              cpus;               //!< Logical CPUs the process is allowed to run on (cpuset and process affinity).
+    unsigned long long  memoryMax;          //!< Hard memory limit ("memory.max", or "memory.limit_in_bytes" for cgroup v1).
+    unsigned long long  memoryHigh;         //!< Memory throttling limit ("memory.high", only for cgroup v2).
+
+    unsigned int        effectiveCPUs;      //!< Number of CPUs a thread pool should use, i.e. the minimum of the host CPUs, allowed CPUs, and CPU quota (rounded up).
+    unsigned long long  effectiveMemory;    //!< Memory the process can use, i.e. the minimum of the host memory and the memory limits.
+
+    unsigned long long  periods;            //!< Number of enforcement periods of the CPU quota ("nr_periods" in "cpu.stat").
+    unsigned long long  throttledPeriods;   //!< Number of periods in which the cgroup was throttled ("nr_throttled" in "cpu.stat").
+    unsigned long long  throttledTime;      //!< Total time the cgroup was throttled (in microseconds).
+};
+
+/**
+\brief Queries the effective CPU and memory limits of the current process.
+\remarks On Linux this reads the cgroup v2 files "cpu.max", "cpuset.cpus.effective", "memory.max", "memory.high", and "cpu.stat",
+or the respective cgroup v1 files ("cpu.cfs_quota_us", "cpuset.effective_cpus", "memory.limit_in_bytes") as fallback.
+The limits of all parent cgroups are taken into account.
+The 'ENTRY_EFFECTIVE_PROCESSORS' and 'ENTRY_EFFECTIVE_MEMORY' entries are queried only once for the hardware profile,
+so call this function to observe changed limits or the throttling counters.
+\return True on success. If no cgroup is available, the effective limits are the host values.
+*/
+bool QueryResourceLimits(ResourceLimits& limits);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,273 @@
+/*
+ * SystemIndicatorMemory.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_MEMORY_H__
+#define __SI_MEMORY_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Detailed physical and virtual memory status. All sizes are in KBs and 0 if not available on the host platform.
+struct MemoryInfo
+{
+    MemoryInfo() :
+        total               ( 0 ),
+        free                ( 0 ),
+        available           ( 0 ),
+        cached              ( 0 ),
+        buffers             ( 0 ),
+        dirty               ( 0 ),
+        swapTotal           ( 0 ),
+        swapFree            ( 0 ),
+        committed           ( 0 ),
+        commitLimit         ( 0 ),
+        anonHugePages       ( 0 ),
+        hugePages           ( 0 ),
+        hugePagesFree       ( 0 ),
+        hugePagesReserved   ( 0 ),
+        hugePageSize        ( 0 )
+    {
+    }
+
+    unsigned long long total;               //!< Total usable physical memory ("MemTotal").
+    unsigned long long free;                //!< Completely unused physical memory ("MemFree").
+    unsigned long long available;           //!< Estimate of memory that is available for new allocations without swapping ("MemAvailable").
+    unsigned long long cached;              //!< Page cache, excluding swap cache ("Cached").
+    unsigned long long buffers;             //!< Temporary storage for raw disk blocks ("Buffers").
+    unsigned long long dirty;               //!< Memory waiting to be written back to disk ("Dirty").
+    unsigned long long swapTotal;           //!< Total swap space ("SwapTotal").
+    unsigned long long swapFree;            //!< Unused swap space ("SwapFree").
+    unsigned long long committed;           //!< Memory currently allocated by all processes, even if not used yet ("Committed_AS").
+    unsigned long long commitLimit;         //!< Total memory that can be allocated under strict overcommit ("CommitLimit").
+    unsigned long long anonHugePages;       //!< Anonymous memory backed by transparent huge pages ("AnonHugePages").
+    unsigned long long hugePages;           //!< Number of pages in the pool of the default huge page size ("HugePages_Total"). This is a page count, not a size.
+    unsigned long long hugePagesFree;       //!< Number of unallocated pages in the default huge page pool ("HugePages_Free"). This is a page count, not a size.
+    unsigned long long hugePagesReserved;   //!< Number of free pages in the default huge page pool that are already promised to mappings ("HugePages_Rsvd"). This is a page count, not a size.
+    unsigned long long hugePageSize;        //!< Default huge page size, e.g. 2048 on x86-64 ("Hugepagesize").
+};
+
+
+/**
+\brief Queries the current memory status.
+\remarks On Linux this parses "/proc/meminfo" (or uses 'sysinfo' as fallback) without any heap allocations,
+so it is suitable for high frequency sampling, e.g. for admission control.
+\return True on success. Otherwise all values are 0.
+*/
+bool QueryMemoryInfo(MemoryInfo& info);
+
+//! Mode of transparent huge pages (THP).
+enum TransparentHugePageMode
+{
+    THP_MODE_UNKNOWN,   //!< Transparent huge pages are not supported or the mode could not be read.
+    THP_MODE_ALWAYS,    //!< Huge pages are used for all eligible anonymous mappings ("always").
+    THP_MODE_MADVISE,   //!< Huge pages are only used for mappings marked with "madvise(MADV_HUGEPAGE)" ("madvise").
+    THP_MODE_NEVER,     //!< Transparent huge pages are disabled ("never").
+};
+
+//! Defragmentation policy of transparent huge pages, i.e. what a page fault does if no huge page is free.
+enum TransparentHugePageDefrag
+{
+    THP_DEFRAG_UNKNOWN,         //!< The policy could not be read.
+    THP_DEFRAG_ALWAYS,          //!< Page faults stall for direct reclaim and compaction ("always").
+    THP_DEFRAG_DEFER,           //!< Page faults fall back to base pages and wake kswapd/kcompactd ("defer").
+    THP_DEFRAG_DEFER_MADVISE,   //!< Like 'THP_DEFRAG_ALWAYS' for "madvise" regions and 'THP_DEFRAG_DEFER' otherwise ("defer+madvise").
+    THP_DEFRAG_MADVISE,         //!< Page faults only stall for "madvise" regions ("madvise").
+    THP_DEFRAG_NEVER,           //!< Page faults never stall and fall back to base pages ("never").
+};
+
+//! Pool of huge pages with a single page size, either system-wide or for a single NUMA node.
+struct HugePagePool
+{
+    HugePagePool() :
+        node        ( -1 ),
+        pageSize    ( 0  ),
+        total       ( 0  ),
+        free        ( 0  ),
+        reserved    ( 0  ),
+        surplus     ( 0  ),
+        overcommit  ( 0  )
+    {
+    }
+
+    int                 node;       //!< NUMA node ID, or -1 for the system-wide pool.
+    unsigned long long  pageSize;   //!< Page size (in KBs), e.g. 2048 or 1048576.
+    unsigned long long  total;      //!< Number of pages in the pool ("nr_hugepages").
+    unsigned long long  free;       //!< Number of unallocated pages ("free_hugepages").
+    unsigned long long  reserved;   //!< Number of free pages that are already promised to mappings ("resv_hugepages"). Only available for system-wide pools.
+    unsigned long long  surplus;    //!< Number of pages allocated beyond 'total' by overcommitment ("surplus_hugepages").
+    unsigned long long  overcommit; //!< Maximum number of surplus pages ("nr_overcommit_hugepages"). Only available for system-wide pools.
+};
+
+//! Status of transparent huge pages (THP).
+struct TransparentHugePageInfo
+{
+    TransparentHugePageInfo() :
+        mode            ( THP_MODE_UNKNOWN   ),
+        defrag          ( THP_DEFRAG_UNKNOWN ),
+        pageSize        ( 0                  ),
+        anonHugePages   ( 0                  ),
+        shmemHugePages  ( 0                  ),
+        fileHugePages   ( 0                  )
+    {
+    }
+
+    TransparentHugePageMode     mode;           //!< Mode for anonymous memory ("enabled").
+    TransparentHugePageDefrag   defrag;         //!< Defragmentation policy ("defrag").
+    unsigned long long          pageSize;       //!< Size of a transparent huge page (in KBs, "hpage_pmd_size"), e.g. 2048 on x86-64.
+    unsigned long long          anonHugePages;  //!< Anonymous memory backed by transparent huge pages (in KBs, "AnonHugePages").
+    unsigned long long          shmemHugePages; //!< Shared memory and tmpfs backed by transparent huge pages (in KBs, "ShmemHugePages").
+    unsigned long long          fileHugePages;  //!< Page cache backed by transparent huge pages (in KBs, "FileHugePages").
+};
+
+//! Report of the supported page sizes, the huge page pools, and transparent huge pages.
+struct HugePageInfo
+{
+    HugePageInfo() :
+        basePageSize        ( 0 ),
+        defaultHugePageSize ( 0 )
+    {
+    }
+
+    unsigned long long          basePageSize;           //!< Size of a base page (in KBs), e.g. 4.
+    unsigned long long          defaultHugePageSize;    //!< Huge page size of "MAP_HUGETLB" without an explicit size (in KBs), or 0 if huge pages are not supported.
+    std::vector<HugePagePool>   pools;                  //!< System-wide pool of each supported huge page size, sorted by page size. The supported page sizes are 'basePageSize' and the page sizes of these pools.
+    std::vector<HugePagePool>   nodePools;              //!< Pool of each supported huge page size per NUMA node, sorted by node and page size. Empty on systems without NUMA support.
+    TransparentHugePageInfo     transparent;            //!< Status of transparent huge pages.
+};
+
+/**
+\brief Number of free blocks of each order in a memory zone, as maintained by the buddy allocator.
+\remarks A block of order N consists of 2^N physically contiguous base pages, e.g. order 9 is 2 MB with 4 KB base pages.
+*/
+struct MemoryZoneFreeBlocks
+{
+    MemoryZoneFreeBlocks() :
+        node    ( -1 ),
+        orders  ( 0  )
+    {
+        zone[0] = '\0';
+        for (unsigned int i = 0; i < maxOrders; ++i)
+            blocks[i] = 0;
+    }
+
+    //! Returns the number of blocks of the specified order that can be allocated from the free blocks without compaction.
+    unsigned long long GetAvailableBlocks(unsigned int order) const
+    {
+        unsigned long long count = 0;
+        for (unsigned int i = order; i < orders; ++i)
+            count += (blocks[i] << (i - order));
+        return count;
+    }
+
+    //! Returns true if this is the "DMA" zone, which is reserved for legacy devices.
+    bool IsDMAZone() const
+    {
+        return (zone[0] == 'D' && zone[1] == 'M' && zone[2] == 'A' && zone[3] == '\0');
+    }
+
+    //! Returns the number of free base pages in this zone.
+    unsigned long long GetFreePages() const
+    {
+        return GetAvailableBlocks(0);
+    }
+
+    /**
+    \brief Returns the share of free memory that is unusable for an allocation of the specified order, between 0 and 1.
+    \remarks This is the "unusable free space index": 0 means all free memory is in blocks of at least this order,
+    and values close to 1 mean that the free memory is fragmented into smaller blocks, so such an allocation requires compaction.
+    */
+    double GetUnusableFreeSpace(unsigned int order) const
+    {
+        const unsigned long long freePages = GetFreePages();
+        if (freePages == 0)
+            return 1.0;
+        const unsigned long long usablePages = (order < orders ? GetAvailableBlocks(order) << order : 0);
+        return static_cast<double>(freePages - usablePages) / static_cast<double>(freePages);
+    }
+
+    static const unsigned int maxOrders = 16;
+
+    int                 node;               //!< NUMA node ID.
+    char                zone[16];           //!< Zone name, e.g. "DMA", "DMA32", "Normal", or "Movable".
+    unsigned int        orders;             //!< Number of valid orders in 'blocks', e.g. 11 for orders 0 to 10.
+    unsigned long long  blocks[maxOrders];  //!< Number of free blocks of each order.
+};
+
+//! Fragmentation report of the physical memory.
+struct MemoryFragmentation
+{
+    /**
+    \brief Returns the number of blocks of the specified order that can be allocated without compaction from all zones except "DMA",
+    which is reserved for legacy devices.
+    \remarks This indicates whether a high-order allocation (e.g. a huge page) is likely to succeed without stalling for compaction.
+    It is only an estimate, since the free blocks change constantly and the kernel keeps a number of free pages in reserve (watermarks).
+    \code
+    // Order of a 2 MB page with 4 KB base pages
+    unsigned int order = 9;
+    if (fragmentation.GetAvailableBlocks(order) < 512)
+        // Fall back to base pages ...
+    \endcode
+    */
+    unsigned long long GetAvailableBlocks(unsigned int order) const
+    {
+        unsigned long long count = 0;
+        for (const auto& z : zones)
+        {
+            if (!z.IsDMAZone())
+                count += z.GetAvailableBlocks(order);
+        }
+        return count;
+    }
+
+    std::vector<MemoryZoneFreeBlocks> zones; //!< Free blocks of each memory zone, sorted by node as reported by the kernel.
+};
+
+/**
+\brief Queries the supported page sizes, the huge page pools of each size (system-wide and per NUMA node), and the status of transparent huge pages.
+\remarks On Linux this reads "/sys/kernel/mm/hugepages", "/sys/devices/system/node/node<N>/hugepages",
+"/sys/kernel/mm/transparent_hugepage", and "/proc/meminfo".
+\return True on success, i.e. if at least the base page size is known.
+*/
+bool QueryHugePageInfo(HugePageInfo& info);
+
+/**
+\brief Queries the status of transparent huge pages only.
+\remarks This is cheaper than 'QueryHugePageInfo', since it does not enumerate the huge page pools.
+*/
+bool QueryTransparentHugePages(TransparentHugePageInfo& info);
+
+/**
+\brief Queries the number of free blocks of each order in each memory zone.
+\remarks On Linux this parses "/proc/buddyinfo". The vector of zones keeps its capacity,
+so repeated queries with the same report do not allocate any heap memory.
+\return True on success.
+*/
+bool QueryMemoryFragmentation(MemoryFragmentation& fragmentation);
+
+/**
+\brief Queries the number of blocks of the specified order that can be allocated without compaction from all zones except "DMA".
+\remarks This is the same as 'MemoryFragmentation::GetAvailableBlocks' after 'QueryMemoryFragmentation',
+but the zones are summed up while parsing, so this does not allocate any heap memory.
+\return True on success.
+*/
+bool QueryAvailableMemoryBlocks(unsigned int order, unsigned long long& blocks);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,388 @@
+/*
+ * SystemIndicatorNetwork.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_NETWORK_H__
+#define __SI_NETWORK_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Network interface and its link properties, e.g. "eth0" or "lo".
+struct NetworkInterface
+{
+    NetworkInterface() :
+        index       ( 0     ),
+        mtu         ( 0     ),
+        speed       ( 0     ),
+        rxQueues    ( 0     ),
+        txQueues    ( 0     ),
+        numaNode    ( -1    ),
+        loopback    ( false ),
+        physical    ( false ),
+        up          ( false ),
+        carrier     ( false )
+    {
+        name[0] = '\0';
+    }
+
+    char            name[32];   //!< Kernel name of the interface, e.g. "enp3s0".
+    unsigned int    index;      //!< Interface index ("ifindex").
+    unsigned int    mtu;        //!< Maximum transmission unit (in bytes, "mtu").
+    unsigned int    speed;      //!< Link speed (in Mbit/s, "speed"), or 0 if the interface does not report it (e.g. loopback and virtual interfaces).
+    unsigned int    rxQueues;   //!< Number of receive queues ("queues/rx-*").
+    unsigned int    txQueues;   //!< Number of transmit queues ("queues/tx-*").
+    int             numaNode;   //!< NUMA node the network adapter is attached to ("device/numa_node"), or -1 if unknown. Network threads should run on this node.
+    bool            loopback;   //!< True for the loopback interface.
+    bool            physical;   //!< True if the interface is backed by hardware, false for virtual interfaces (e.g. "lo", "veth0", or "br0").
+    bool            up;         //!< True if the interface is administratively up.
+    bool            carrier;    //!< True if the interface has a link ("carrier").
+};
+
+//! Cumulative traffic counters of a network interface since it was created, as reported by "/proc/net/dev".
+struct NetworkCounters
+{
+    NetworkCounters() :
+        rxBytes         ( 0 ),
+        rxPackets       ( 0 ),
+        rxErrors        ( 0 ),
+        rxDropped       ( 0 ),
+        rxFIFOErrors    ( 0 ),
+        rxFrameErrors   ( 0 ),
+        rxCompressed    ( 0 ),
+        rxMulticast     ( 0 ),
+        txBytes         ( 0 ),
+        txPackets       ( 0 ),
+        txErrors        ( 0 ),
+        txDropped       ( 0 ),
+        txFIFOErrors    ( 0 ),
+        txCollisions    ( 0 ),
+        txCarrierErrors ( 0 ),
+        txCompressed    ( 0 )
+    {
+    }
+
+    unsigned long long rxBytes;         //!< Number of bytes received.
+    unsigned long long rxPackets;       //!< Number of packets received.
+    unsigned long long rxErrors;        //!< Number of receive errors.
+    unsigned long long rxDropped;       //!< Number of received packets that were dropped, e.g. due to a full receive queue.
+    unsigned long long rxFIFOErrors;    //!< Number of receive FIFO overruns.
+    unsigned long long rxFrameErrors;   //!< Number of frame alignment errors.
+    unsigned long long rxCompressed;    //!< Number of compressed packets received.
+    unsigned long long rxMulticast;     //!< Number of multicast packets received.
+    unsigned long long txBytes;         //!< Number of bytes transmitted.
+    unsigned long long txPackets;       //!< Number of packets transmitted.
+    unsigned long long txErrors;        //!< Number of transmit errors.
+    unsigned long long txDropped;       //!< Number of packets that were dropped before transmission.
+    unsigned long long txFIFOErrors;    //!< Number of transmit FIFO underruns.
+    unsigned long long txCollisions;    //!< Number of collisions.
+    unsigned long long txCarrierErrors; //!< Number of carrier losses.
+    unsigned long long txCompressed;    //!< Number of compressed packets transmitted.
+};
+
+//! Traffic of a network interface between two samples.
+struct NetworkActivity
+{
+    NetworkActivity() :
+        rxThroughput    ( 0 ),
+        txThroughput    ( 0 ),
+        rxPacketRate    ( 0 ),
+        txPacketRate    ( 0 ),
+        rxDropRate      ( 0 ),
+        txDropRate      ( 0 ),
+        rxErrorRate     ( 0 ),
+        txErrorRate     ( 0 )
+    {
+    }
+
+    double rxThroughput;    //!< Bytes received per second.
+    double txThroughput;    //!< Bytes transmitted per second.
+    double rxPacketRate;    //!< Packets received per second.
+    double txPacketRate;    //!< Packets transmitted per second.
+    double rxDropRate;      //!< Received packets dropped per second.
+    double txDropRate;      //!< Transmit packets dropped per second.
+    double rxErrorRate;     //!< Receive errors per second.
+    double txErrorRate;     //!< Transmit errors per second.
+};
+
+/**
+\brief Queries all network interfaces and their link properties.
+\remarks On Linux the interfaces are enumerated from "/proc/net/dev" (i.e. the network namespace of the process)
+and the link properties are read from "/sys/class/net/<name>".
+*/
+bool QueryNetworkInterfaces(std::vector<NetworkInterface>& interfaces);
+
+//! Queries the link properties of the specified network interface, e.g. "lo".
+bool QueryNetworkInterface(const char* name, NetworkInterface& networkInterface);
+
+/**
+\brief Queries the traffic counters of the specified network interface, e.g. "lo".
+\remarks This does not allocate any heap memory.
+\return False if the interface does not exist.
+*/
+bool QueryNetworkInterfaceCounters(const char* name, NetworkCounters& counters);
+
+/**
+\brief Queries the sum of the traffic counters of all network interfaces except the loopback interface.
+\remarks This does not allocate any heap memory.
+*/
+bool QueryNetworkCounters(NetworkCounters& total);
+
+/**
+\brief Sampler for the traffic counters and activity of all network interfaces.
+\remarks The interfaces are enumerated once on construction and sorted by name. On Linux "/proc/net/dev" is kept open and read into a buffer
+that is allocated once; all counters are kept in preallocated arrays, so sampling does not allocate any heap memory.
+Interfaces that are added after construction are ignored.
+\code
+NetworkSampler sampler;
+for (;;)
+{
+    sleep(1);
+    sampler.Sample();
+    for (std::size_t i = 0; i < sampler.GetInterfaceCount(); ++i)
+        printf("%s: %.0f bytes/s\n", sampler.GetInterface(i).name, sampler.GetActivity(i).rxThroughput);
+}
+\endcode
+*/
+class NetworkSampler
+{
+
+    public:
+
+        //! Enumerates all network interfaces and takes the initial sample.
+        NetworkSampler();
+        ~NetworkSampler();
+
+        NetworkSampler(const NetworkSampler&) = delete;
+        NetworkSampler& operator = (const NetworkSampler&) = delete;
+
+        /**
+        \brief Reads the current traffic counters and computes the activity since the previous sample.
+        \return False if the counters could not be read. In this case the previous activity is kept.
+        */
+        bool Sample();
+
+        //! Returns the number of network interfaces.
+        std::size_t GetInterfaceCount() const
+        {
+            return interfaces_.size();
+        }
+
+        //! Returns the specified network interface.
+        const NetworkInterface& GetInterface(std::size_t index) const
+        {
+            return interfaces_[index];
+        }
+
+        //! Returns the cumulative counters of the specified network interface from the last sample.
+        const NetworkCounters& GetCounters(std::size_t index) const
+        {
+            return counters_[index];
+        }
+
+        //! Returns the activity of the specified network interface between the last two samples.
+        const NetworkActivity& GetActivity(std::size_t index) const
+        {
+            return activity_[index];
+        }
+
+    private:
+
+        int                             fd_;            //!< File descriptor of "/proc/net/dev" (only used on Linux).
+        std::vector<char>               buffer_;
+        unsigned long long              timestamp_;     //!< Time of the last sample (in nanoseconds).
+        std::vector<NetworkInterface>   interfaces_;
+        std::vector<NetworkCounters>    counters_;
+        std::vector<NetworkActivity>    activity_;
+
+};
+
+//! TCP counters since boot, as reported by "/proc/net/snmp" ("Tcp") and "/proc/net/netstat" ("TcpExt").
+struct TCPCounters
+{
+    TCPCounters() :
+        activeOpens             ( 0 ),
+        passiveOpens            ( 0 ),
+        attemptFails            ( 0 ),
+        establishedResets       ( 0 ),
+        currentEstablished      ( 0 ),
+        inSegments              ( 0 ),
+        outSegments             ( 0 ),
+        retransmittedSegments   ( 0 ),
+        inErrors                ( 0 ),
+        outResets               ( 0 ),
+        listenOverflows         ( 0 ),
+        listenDrops             ( 0 ),
+        backlogDrops            ( 0 ),
+        synRetransmits          ( 0 ),
+        timeouts                ( 0 ),
+        abortsOnMemory          ( 0 ),
+        pruneCalls              ( 0 )
+    {
+    }
+
+    unsigned long long activeOpens;             //!< Number of outgoing connection attempts ("ActiveOpens").
+    unsigned long long passiveOpens;            //!< Number of accepted connection attempts ("PassiveOpens").
+    unsigned long long attemptFails;            //!< Number of failed connection attempts ("AttemptFails").
+    unsigned long long establishedResets;       //!< Number of resets of established connections ("EstabResets").
+    unsigned long long currentEstablished;      //!< Number of currently established connections ("CurrEstab"). This is not cumulative.
+    unsigned long long inSegments;              //!< Number of received segments ("InSegs").
+    unsigned long long outSegments;             //!< Number of sent segments, excluding retransmissions ("OutSegs").
+    unsigned long long retransmittedSegments;   //!< Number of retransmitted segments ("RetransSegs").
+    unsigned long long inErrors;                //!< Number of segments received with errors ("InErrs").
+    unsigned long long outResets;               //!< Number of sent resets ("OutRsts").
+    unsigned long long listenOverflows;         //!< Number of times the accept queue of a listening socket was full ("ListenOverflows").
+    unsigned long long listenDrops;             //!< Number of connection requests dropped by listening sockets, including overflows ("ListenDrops").
+    unsigned long long backlogDrops;            //!< Number of segments dropped because the socket backlog was full ("TCPBacklogDrop").
+    unsigned long long synRetransmits;          //!< Number of retransmitted SYN and SYN-ACK segments ("TCPSynRetrans").
+    unsigned long long timeouts;                //!< Number of retransmission timeouts ("TCPTimeouts").
+    unsigned long long abortsOnMemory;          //!< Number of connections aborted due to memory pressure ("TCPAbortOnMemory").
+    unsigned long long pruneCalls;              //!< Number of times the receive queue was pruned due to socket memory pressure ("PruneCalled").
+};
+
+//! UDP counters since boot, as reported by "/proc/net/snmp" ("Udp").
+struct UDPCounters
+{
+    UDPCounters() :
+        inDatagrams         ( 0 ),
+        outDatagrams        ( 0 ),
+        noPorts             ( 0 ),
+        inErrors            ( 0 ),
+        receiveBufferErrors ( 0 ),
+        sendBufferErrors    ( 0 )
+    {
+    }
+
+    unsigned long long inDatagrams;         //!< Number of received datagrams ("InDatagrams").
+    unsigned long long outDatagrams;        //!< Number of sent datagrams ("OutDatagrams").
+    unsigned long long noPorts;             //!< Number of datagrams received for ports without a socket ("NoPorts").
+    unsigned long long inErrors;            //!< Number of datagrams that could not be delivered, including buffer errors ("InErrors").
+    unsigned long long receiveBufferErrors; //!< Number of datagrams dropped because the receive buffer was full ("RcvbufErrors").
+    unsigned long long sendBufferErrors;    //!< Number of datagrams dropped because the send buffer was full ("SndbufErrors").
+};
+
+//! Socket usage of the network namespace, as reported by "/proc/net/sockstat". These values are not cumulative.
+struct SocketUsage
+{
+    SocketUsage() :
+        sockets         ( 0 ),
+        tcpInUse        ( 0 ),
+        tcpOrphans      ( 0 ),
+        tcpTimeWait     ( 0 ),
+        tcpAllocated    ( 0 ),
+        tcpMemory       ( 0 ),
+        udpInUse        ( 0 ),
+        udpMemory       ( 0 )
+    {
+    }
+
+    unsigned long long sockets;         //!< Number of sockets of all protocols ("sockets: used").
+    unsigned long long tcpInUse;        //!< Number of TCP sockets in use, excluding time-wait sockets ("TCP: inuse").
+    unsigned long long tcpOrphans;      //!< Number of TCP sockets that are no longer attached to a file descriptor ("TCP: orphan").
+    unsigned long long tcpTimeWait;     //!< Number of TCP sockets in time-wait state ("TCP: tw").
+    unsigned long long tcpAllocated;    //!< Number of allocated TCP sockets ("TCP: alloc").
+    unsigned long long tcpMemory;       //!< Memory used by TCP socket buffers (in pages, "TCP: mem"). This is compared against "net.ipv4.tcp_mem".
+    unsigned long long udpInUse;        //!< Number of UDP sockets in use ("UDP: inuse").
+    unsigned long long udpMemory;       //!< Memory used by UDP socket buffers (in pages, "UDP: mem"). This is compared against "net.ipv4.udp_mem".
+};
+
+//! Health counters of the TCP/IP stack, e.g. to correlate tail latency with retransmits or accept queue overflows.
+struct NetworkStackCounters
+{
+    TCPCounters tcp;        //!< TCP counters.
+    UDPCounters udp;        //!< UDP counters.
+    SocketUsage sockets;    //!< Socket usage.
+};
+
+/**
+rief Queries the health counters of the TCP/IP stack once.
+emarks On Linux this reads "/proc/net/snmp", "/proc/net/netstat", and "/proc/net/sockstat" of the network namespace of the process.
+This does not allocate any heap memory. Use 'NetworkStackSampler' for continuous monitoring.
+eturn False if none of the files could be read.
+*/
+bool QueryNetworkStackCounters(NetworkStackCounters& counters);
+
+/**
+rief Sampler for the health counters of the TCP/IP stack and their changes between two samples.
+emarks On Linux the files are opened once and kept open, and they are read into a buffer that is allocated once,
+so sampling does not allocate any heap memory.
+\code
+NetworkStackSampler sampler;
+for (;;)
+{
+    sleep(1);
+    sampler.Sample();
+    if (sampler.GetDelta().tcp.listenOverflows > 0)
+        printf("accept queue overflows: %llu\n", sampler.GetDelta().tcp.listenOverflows);
+}
+\endcode
+*/
+class NetworkStackSampler
+{
+
+    public:
+
+        //! Opens the files and takes the initial sample.
+        NetworkStackSampler();
+        ~NetworkStackSampler();
+
+        NetworkStackSampler(const NetworkStackSampler&) = delete;
+        NetworkStackSampler& operator = (const NetworkStackSampler&) = delete;
+
+        /**
+        rief Reads the current counters and computes the changes since the previous sample.
+        eturn False if none of the files could be read. In this case the previous values are kept.
+        */
+        bool Sample();
+
+        //! Returns the counters of the last sample.
+        const NetworkStackCounters& GetCounters() const
+        {
+            return counters_;
+        }
+
+        /**
+        rief Returns the change of all cumulative counters between the last two samples.
+        emarks Values that are not cumulative (i.e. 'TCPCounters::currentEstablished' and all of 'SocketUsage') are the values of the last sample.
+        */
+        const NetworkStackCounters& GetDelta() const
+        {
+            return delta_;
+        }
+
+        //! Returns the time between the last two samples (in seconds).
+        double GetInterval() const
+        {
+            return interval_;
+        }
+
+    private:
+
+        int                     fds_[3];        //!< File descriptors of "/proc/net/snmp", "/proc/net/netstat", and "/proc/net/sockstat" (only used on Linux).
+        std::vector<char>       buffer_;
+        unsigned long long      timestamp_;     //!< Time of the last sample (in nanoseconds).
+        double                  interval_;
+        NetworkStackCounters    counters_;
+        NetworkStackCounters    delta_;
+
+};
+
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,118 @@
+/*
+ * SystemIndicatorPlacement.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PLACEMENT_H__
+#define __SI_PLACEMENT_H__
+
+
+#include "SystemIndicatorTopology.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Thread placement policy enumeration.
+enum PlacementPolicy
+{
+    /**
+    One worker per physical core. Each worker gets all SMT siblings of its core,
+    so no two workers share a core unless there are more workers than cores.
+    */
+    PLACEMENT_ONE_PER_CORE,
+
+    /**
+    One logical CPU per worker. The first SMT sibling of every core is used before
+    the second sibling of any core, i.e. SMT siblings are only shared when all cores are busy.
+    */
+    PLACEMENT_SMT_LAST,
+
+    /**
+    One logical CPU per worker, distributed round-robin across the L3 cache domains (or packages if there is no L3 cache),
+    to maximize the total cache capacity and memory bandwidth. SMT siblings are used last within each domain.
+    */
+    PLACEMENT_SPREAD_L3,
+
+    /**
+    One logical CPU per worker, all within a single NUMA node, so all workers allocate local memory.
+    SMT siblings are used last. If there are more workers than CPUs in the node, the CPUs are shared.
+    */
+    PLACEMENT_COMPACT_NODE,
+};
+
+//! Thread placement request.
+struct PlacementRequest
+{
+    PlacementRequest() :
+        workers ( 0                  ),
+        policy  ( PLACEMENT_SMT_LAST ),
+        node    ( -1                 )
+    {
+    }
+
+    unsigned int    workers;    //!< Number of workers.
+    PlacementPolicy policy;     //!< Placement policy.
+    int             node;       //!< Node index for PLACEMENT_COMPACT_NODE, or -1 to use the node with the most allowed CPUs.
+    CPUSet          allowed;    //!< Allowed logical CPUs, e.g. the current affinity. An empty set allows all online CPUs.
+};
+
+//! Returns the name of the specified placement policy, e.g. "smt-last".
+const char* PlacementPolicyName(const PlacementPolicy policy);
+
+/**
+\brief Computes the CPU affinity mask for each worker of the specified request.
+\param[in] topology Specifies the CPU topology, e.g. from 'QueryCPUTopology'.
+\param[in] caches Specifies the cache hierarchy, e.g. from 'QueryCacheInfo'. This is only used for PLACEMENT_SPREAD_L3.
+\param[in] request Specifies the number of workers and the placement policy.
+\param[out] masks Specifies the output list with one affinity mask for each worker.
+\remarks This does not query the host system, so it can be used with synthetic topologies as well.
+Workers wrap around if there are more workers than available CPUs (or cores).
+\return False if there are no allowed CPUs.
+*/
+bool PlanThreadPlacement(
+    const CPUTopology&              topology,
+    const std::vector<CacheInfo>&   caches,
+    const PlacementRequest&         request,
+    std::vector<CPUSet>&            masks
+);
+
+/**
+\brief Computes the CPU affinity mask for each worker of the specified request on the host system.
+\remarks This queries the CPU topology and cache hierarchy of the host system.
+If the request does not specify any allowed CPUs, the affinity of the calling thread is used,
+so the placement respects restrictions such as 'taskset' or cgroup cpusets.
+*/
+bool PlanThreadPlacement(const PlacementRequest& request, std::vector<CPUSet>& masks);
+
+/**
+\brief Pins the calling thread to the specified logical CPUs.
+\remarks On Linux this uses 'pthread_setaffinity_np' and supports any number of CPUs.
+On Windows only the CPUs of the current processor group (up to 64) are supported.
+\return True on success.
+*/
+bool SetThreadAffinity(const CPUSet& cpus);
+
+//! Returns the logical CPUs the calling thread is allowed to run on.
+bool GetThreadAffinity(CPUSet& cpus);
+
+/**
+\brief Returns the logical CPUs the current process is allowed to run on, independent of the calling thread.
+\remarks On Linux this is the affinity of the main thread (e.g. from 'taskset'), which is inherited by new threads.
+On Windows this is the process affinity mask of the current processor group.
+*/
+bool GetProcessAffinity(CPUSet& cpus);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
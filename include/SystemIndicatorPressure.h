@@ -0,0 +1,128 @@
+/*
+ * SystemIndicatorPressure.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PRESSURE_H__
+#define __SI_PRESSURE_H__
+
+
+#include "SystemIndicator.h"
+
+
+namespace SystemIndicator
+{
+
+
+//! Stall information of a single line of a pressure file, e.g. "some avg10=1.25 avg60=0.50 avg300=0.10 total=123456".
+struct PressureStall
+{
+    PressureStall() :
+        avg10   ( 0 ),
+        avg60   ( 0 ),
+        avg300  ( 0 ),
+        total   ( 0 )
+    {
+    }
+
+    double              avg10;  //!< Share of time (in percent) the tasks were stalled, averaged over the last 10 seconds.
+    double              avg60;  //!< Share of time (in percent) the tasks were stalled, averaged over the last 60 seconds.
+    double              avg300; //!< Share of time (in percent) the tasks were stalled, averaged over the last 300 seconds.
+    unsigned long long  total;  //!< Total stall time (in microseconds). Use the difference of two samples for custom time windows.
+};
+
+//! Pressure stall information of a single resource.
+struct ResourcePressure
+{
+    ResourcePressure() :
+        available ( false )
+    {
+    }
+
+    bool            available;  //!< True if the pressure file of this resource could be read.
+    PressureStall   some;       //!< Time in which at least one task was stalled on this resource.
+    PressureStall   full;       //!< Time in which all non-idle tasks were stalled on this resource at the same time, i.e. no progress was made.
+};
+
+//! Pressure stall information of the CPU, memory, and I/O.
+struct PressureInfo
+{
+    ResourcePressure cpu;       //!< CPU pressure. The "full" line is only reported for cgroups (and is always zero for the whole system).
+    ResourcePressure memory;    //!< Memory pressure, e.g. tasks waiting for page reclaim or swap-in.
+    ResourcePressure io;        //!< I/O pressure, e.g. tasks waiting for block devices.
+};
+
+//! Scope of the pressure stall information.
+enum PressureScope
+{
+    PRESSURE_SCOPE_SYSTEM,  //!< Pressure of the whole system ("/proc/pressure/cpu", "/proc/pressure/memory", "/proc/pressure/io").
+    PRESSURE_SCOPE_CGROUP,  //!< Pressure of the cgroup v2 of the current process ("cpu.pressure", "memory.pressure", "io.pressure").
+};
+
+/**
+\brief Monitor for the pressure stall information (PSI), which is used to detect resource contention before it becomes a failure,
+e.g. to apply back-pressure when tasks start to wait for memory or I/O.
+\remarks On Linux (4.20 or later, with PSI enabled) the pressure files are opened once and kept open,
+so each call to 'Read' only reads and parses the files without any heap allocations.
+The cgroup of the current process is resolved once in 'Open'.
+\code
+PressureMonitor monitor;
+monitor.Open(PRESSURE_SCOPE_CGROUP);
+PressureInfo info;
+if (monitor.Read(info) && info.memory.some.avg10 > 10.0)
+    // shed load ...
+\endcode
+*/
+class PressureMonitor
+{
+
+    public:
+
+        PressureMonitor();
+        ~PressureMonitor();
+
+        PressureMonitor(const PressureMonitor&) = delete;
+        PressureMonitor& operator = (const PressureMonitor&) = delete;
+
+        /**
+        \brief Opens the pressure files of the specified scope.
+        \return False if none of the pressure files is available, e.g. if PSI is disabled ("psi=0" kernel parameter).
+        */
+        bool Open(const PressureScope scope = PRESSURE_SCOPE_SYSTEM);
+
+        //! Closes all pressure files.
+        void Close();
+
+        /**
+        \brief Reads the current pressure stall information of all resources.
+        \return False if none of the pressure files could be read.
+        */
+        bool Read(PressureInfo& info);
+
+        //! Returns true if at least one pressure file is open.
+        bool IsOpen() const;
+
+    private:
+
+        int fds_[3]; //!< File descriptors of the CPU, memory, and I/O pressure files (only used on Linux).
+
+};
+
+/**
+\brief Queries the pressure stall information of the specified scope once.
+\remarks This opens and closes all pressure files. Use 'PressureMonitor' for continuous monitoring.
+\see PressureMonitor
+*/
+bool QueryPressure(PressureInfo& info, const PressureScope scope = PRESSURE_SCOPE_SYSTEM);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,110 @@
+/*
+ * SystemIndicatorProbe.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROBE_H__
+#define __SI_PROBE_H__
+
+
+#include "SystemIndicatorTopology.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Configuration of the memory hierarchy probe.
+struct MemoryProbeConfig
+{
+    MemoryProbeConfig() :
+        maxWorkingSet   ( 256ull * 1024 * 1024  ),
+        bandwidthSize   ( 64ull * 1024 * 1024   ),
+        threads         ( 0                     ),
+        latencyCurve    ( false                 )
+    {
+    }
+
+    unsigned long long  maxWorkingSet;  //!< Largest working set (in bytes) for the latency measurements. By default 256 MB.
+    unsigned long long  bandwidthSize;  //!< Total size (in bytes) of the source array for the bandwidth measurements, shared by all threads. By default 64 MB.
+    unsigned int        threads;        //!< Number of threads for the multi-threaded bandwidth. By default 0, to use one thread per CPU of the process affinity.
+    bool                latencyCurve;   //!< Specifies whether to measure the latency for all power-of-two working sets from 4 KB up to 'maxWorkingSet'. By default false.
+};
+
+//! Measured load-to-use latency of a single level of the memory hierarchy.
+struct MemoryLevelLatency
+{
+    MemoryLevelLatency() :
+        level       ( 0 ),
+        nominalSize ( 0 ),
+        workingSet  ( 0 ),
+        latency     ( 0 )
+    {
+    }
+
+    unsigned int        level;          //!< Cache level (1 to 3), or 0 for the main memory (DRAM).
+    unsigned long long  nominalSize;    //!< Nominal size (in bytes) of the data or unified cache of this level from 'QueryCacheInfo', or 0 for the main memory.
+    unsigned long long  workingSet;     //!< Working set (in bytes) that was used to measure this level.
+    double              latency;        //!< Average latency (in nanoseconds) of a dependent load.
+};
+
+//! Measured latency for a single working set size.
+struct LatencySample
+{
+    unsigned long long  workingSet;     //!< Working set (in bytes).
+    double              latency;        //!< Average latency (in nanoseconds) of a dependent load.
+};
+
+//! Measured memory bandwidth (in GB/s, i.e. 10^9 bytes per second). Copy bandwidth counts both the read and the written bytes.
+struct MemoryBandwidth
+{
+    MemoryBandwidth() :
+        read    ( 0 ),
+        write   ( 0 ),
+        copy    ( 0 )
+    {
+    }
+
+    double read;
+    double write;
+    double copy;
+};
+
+//! Results of the memory hierarchy probe.
+struct MemoryProbe
+{
+    MemoryProbe() :
+        threads ( 0 )
+    {
+    }
+
+    std::vector<MemoryLevelLatency> levels;         //!< Latency of each cache level and the main memory, ordered from L1 to DRAM.
+    std::vector<LatencySample>      latencyCurve;   //!< Latency for each power-of-two working set (only if 'MemoryProbeConfig::latencyCurve' is enabled).
+    MemoryBandwidth                 singleThread;   //!< Bandwidth of a single thread.
+    MemoryBandwidth                 allThreads;     //!< Total bandwidth of all threads.
+    unsigned int                    threads;        //!< Number of threads that were used for 'allThreads'.
+};
+
+/**
+\brief Measures the real latency and bandwidth of the memory hierarchy.
+\remarks The latency is measured with randomized pointer chasing over cache-line sized nodes, so hardware prefetchers cannot predict the next load.
+For each cache level of 'QueryCacheInfo', the working set is half of the nominal cache size; the main memory is measured with the largest working set.
+The bandwidth is measured with streaming read, write, and copy kernels, single-threaded and with one pinned thread per CPU ('PLACEMENT_ONE_PER_CORE').
+This is an expensive operation that takes a few seconds (depending on the configuration and the host) and allocates the working sets on the heap.
+It is never run implicitly; the results should be computed once and cached by the caller.
+\return False if the memory for the working sets could not be allocated.
+*/
+bool MeasureMemoryHierarchy(MemoryProbe& probe, const MemoryProbeConfig& config = MemoryProbeConfig());
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,243 @@
+/*
+ * SystemIndicatorProcess.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROCESS_H__
+#define __SI_PROCESS_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Resource usage of the current process.
+struct ProcessUsage
+{
+    ProcessUsage() :
+        virtualMemory               ( 0 ),
+        residentMemory              ( 0 ),
+        sharedMemory                ( 0 ),
+        peakResidentMemory          ( 0 ),
+        swappedMemory               ( 0 ),
+        minorFaults                 ( 0 ),
+        majorFaults                 ( 0 ),
+        voluntaryContextSwitches    ( 0 ),
+        involuntaryContextSwitches  ( 0 ),
+        userTime                    ( 0 ),
+        systemTime                  ( 0 ),
+        threads                     ( 0 ),
+        openFiles                   ( 0 )
+    {
+    }
+
+    unsigned long long virtualMemory;               //!< Size of the virtual address space (in bytes).
+    unsigned long long residentMemory;              //!< Resident set size (RSS), i.e. physical memory mapped by the process (in bytes).
+    unsigned long long sharedMemory;                //!< Resident memory that is backed by files or shared memory (in bytes).
+    unsigned long long peakResidentMemory;          //!< Peak resident set size (in bytes).
+    unsigned long long swappedMemory;               //!< Anonymous memory that was swapped out (in bytes).
+    unsigned long long minorFaults;                 //!< Number of page faults that were served without I/O, e.g. on first touch of an allocation.
+    unsigned long long majorFaults;                 //!< Number of page faults that required I/O, e.g. reading a page from disk or swap.
+    unsigned long long voluntaryContextSwitches;    //!< Number of context switches because a thread waited, e.g. for I/O or a lock.
+    unsigned long long involuntaryContextSwitches;  //!< Number of context switches because a thread was preempted, e.g. when its time slice expired.
+    unsigned long long userTime;                    //!< CPU time spent in user mode by all threads (in microseconds).
+    unsigned long long systemTime;                  //!< CPU time spent in kernel mode by all threads (in microseconds).
+    unsigned int       threads;                     //!< Number of threads.
+    unsigned int       openFiles;                   //!< Number of open file descriptors.
+};
+
+//! Activity of the current process between two samples.
+struct ProcessActivity
+{
+    ProcessActivity() :
+        cpuUsage                    ( 0 ),
+        minorFaultRate              ( 0 ),
+        majorFaultRate              ( 0 ),
+        voluntarySwitchRate         ( 0 ),
+        involuntarySwitchRate       ( 0 )
+    {
+    }
+
+    double cpuUsage;                //!< CPU time of all threads as percentage of one logical CPU, e.g. 250 if 2.5 CPUs were busy.
+    double minorFaultRate;          //!< Minor page faults per second.
+    double majorFaultRate;          //!< Major page faults per second.
+    double voluntarySwitchRate;     //!< Voluntary context switches per second.
+    double involuntarySwitchRate;   //!< Involuntary context switches per second.
+};
+
+//! CPU usage of a single thread of the current process.
+struct ThreadUsage
+{
+    ThreadUsage() :
+        id          ( 0   ),
+        state       ( '?' ),
+        processor   ( -1  ),
+        minorFaults ( 0   ),
+        majorFaults ( 0   ),
+        userTime    ( 0   ),
+        systemTime  ( 0   ),
+        cpuUsage    ( 0   )
+    {
+        name[0] = '\0';
+    }
+
+    int                 id;             //!< Thread ID (TID).
+    char                name[16];       //!< Thread name, e.g. as set by "pthread_setname_np" (at most 15 characters on Linux).
+    char                state;          //!< Scheduling state, e.g. 'R' (running), 'S' (sleeping), or 'D' (uninterruptible wait).
+    int                 processor;      //!< Logical CPU the thread ran on last, or -1 if unknown.
+    unsigned long long  minorFaults;    //!< Number of minor page faults of this thread.
+    unsigned long long  majorFaults;    //!< Number of major page faults of this thread.
+    unsigned long long  userTime;       //!< CPU time spent in user mode (in microseconds, with the resolution of the scheduler clock tick).
+    unsigned long long  systemTime;     //!< CPU time spent in kernel mode (in microseconds, with the resolution of the scheduler clock tick).
+    double              cpuUsage;       //!< CPU time between the last two samples as percentage of one logical CPU (0 for new threads).
+};
+
+/**
+\brief Detailed memory usage of the current process, as reported by "/proc/self/smaps_rollup" (Linux 4.14 or later).
+\remarks The proportional set size (PSS) divides shared pages by the number of processes that map them,
+so the PSS of all processes adds up to the used physical memory.
+*/
+struct ProcessMemoryDetails
+{
+    ProcessMemoryDetails() :
+        rss             ( 0 ),
+        pss             ( 0 ),
+        pssAnonymous    ( 0 ),
+        pssFile         ( 0 ),
+        pssShared       ( 0 ),
+        sharedClean     ( 0 ),
+        sharedDirty     ( 0 ),
+        privateClean    ( 0 ),
+        privateDirty    ( 0 ),
+        swap            ( 0 ),
+        swapPss         ( 0 ),
+        anonHugePages   ( 0 )
+    {
+    }
+
+    unsigned long long rss;             //!< Resident set size (in bytes, "Rss").
+    unsigned long long pss;             //!< Proportional set size (in bytes, "Pss").
+    unsigned long long pssAnonymous;    //!< Proportional set size of anonymous memory (in bytes, "Pss_Anon", Linux 5.7 or later).
+    unsigned long long pssFile;         //!< Proportional set size of file-backed memory (in bytes, "Pss_File", Linux 5.7 or later).
+    unsigned long long pssShared;       //!< Proportional set size of shared memory (in bytes, "Pss_Shmem", Linux 5.7 or later).
+    unsigned long long sharedClean;     //!< Unmodified pages shared with other processes (in bytes, "Shared_Clean").
+    unsigned long long sharedDirty;     //!< Modified pages shared with other processes (in bytes, "Shared_Dirty").
+    unsigned long long privateClean;    //!< Unmodified pages only mapped by this process (in bytes, "Private_Clean").
+    unsigned long long privateDirty;    //!< Modified pages only mapped by this process (in bytes, "Private_Dirty").
+    unsigned long long swap;            //!< Anonymous memory that was swapped out (in bytes, "Swap").
+    unsigned long long swapPss;         //!< Proportional share of swapped out memory (in bytes, "SwapPss").
+    unsigned long long anonHugePages;   //!< Anonymous memory backed by transparent huge pages (in bytes, "AnonHugePages").
+};
+
+/**
+\brief Queries the resource usage of the current process once.
+\param[out] usage Specifies the output resource usage.
+\param[in] countOpenFiles Specifies whether to count the open file descriptors. Otherwise 'ProcessUsage::openFiles' is 0.
+\remarks On Linux this combines "getrusage", "/proc/self/statm", "/proc/self/status", and the entries of "/proc/self/fd".
+Counting the open files enumerates a directory, which is considerably more expensive than the rest.
+Use 'ProcessSampler' for continuous monitoring.
+*/
+bool QueryProcessUsage(ProcessUsage& usage, bool countOpenFiles = true);
+
+/**
+\brief Queries the number of open file descriptors of the current process.
+\remarks On Linux this counts the entries of "/proc/self/fd", excluding the descriptor of the directory itself.
+*/
+bool QueryProcessOpenFiles(unsigned int& count);
+
+/**
+\brief Queries the detailed memory usage (including PSS) of the current process.
+\remarks This is considerably more expensive than 'QueryProcessUsage', since the kernel walks the page tables of all mappings
+while holding the memory map lock of the process. Don't call this on a hot path.
+*/
+bool QueryProcessMemoryDetails(ProcessMemoryDetails& details);
+
+/**
+\brief Sampler for the resource usage of the current process and the CPU usage of each of its threads.
+\remarks On Linux "/proc/self/statm", "/proc/self/status", and the "/proc/self/task" and "/proc/self/fd" directories are kept open.
+These files are excluded from 'ProcessUsage::openFiles'. The "stat" file of each thread is opened relative to the "task" directory
+on every sample, so the number of open files does not grow with the number of threads.
+Sampling only allocates heap memory when the number of threads exceeds all previous samples.
+\code
+ProcessSampler sampler;
+for (;;)
+{
+    sleep(1);
+    sampler.Sample();
+    for (std::size_t i = 0; i < sampler.GetThreadCount(); ++i)
+        printf("%s: %.1f%%\n", sampler.GetThread(i).name, sampler.GetThread(i).cpuUsage);
+}
+\endcode
+*/
+class ProcessSampler
+{
+
+    public:
+
+        //! Opens the files of the current process and takes the initial sample.
+        ProcessSampler();
+        ~ProcessSampler();
+
+        ProcessSampler(const ProcessSampler&) = delete;
+        ProcessSampler& operator = (const ProcessSampler&) = delete;
+
+        /**
+        \brief Reads the current resource usage of the process and its threads, and computes the activity since the previous sample.
+        \return False if the resource usage could not be read. In this case the previous values are kept.
+        */
+        bool Sample();
+
+        //! Returns the resource usage of the process from the last sample.
+        const ProcessUsage& GetUsage() const
+        {
+            return usage_;
+        }
+
+        //! Returns the activity of the process between the last two samples.
+        const ProcessActivity& GetActivity() const
+        {
+            return activity_;
+        }
+
+        //! Returns the number of threads from the last sample.
+        std::size_t GetThreadCount() const
+        {
+            return threads_.size();
+        }
+
+        //! Returns the specified thread from the last sample. Threads are sorted by their ID.
+        const ThreadUsage& GetThread(std::size_t index) const
+        {
+            return threads_[index];
+        }
+
+    private:
+
+        int                         statmFd_;       //!< File descriptor of "/proc/self/statm" (only used on Linux).
+        int                         statusFd_;      //!< File descriptor of "/proc/self/status" (only used on Linux).
+        int                         taskDirFd_;     //!< File descriptor of the "/proc/self/task" directory (only used on Linux).
+        int                         fdDirFd_;       //!< File descriptor of the "/proc/self/fd" directory (only used on Linux).
+        unsigned long long          timestamp_;     //!< Time of the last sample (in nanoseconds).
+        ProcessUsage                usage_;
+        ProcessActivity             activity_;
+        std::vector<ThreadUsage>    threads_;
+        std::vector<ThreadUsage>    nextThreads_;
+        std::vector<int>            threadIds_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
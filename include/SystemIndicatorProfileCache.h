@@ -0,0 +1,67 @@
+/*
+ * SystemIndicatorProfileCache.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROFILE_CACHE_H__
+#define __SI_PROFILE_CACHE_H__
+
+
+#include "SystemIndicator.h"
+
+
+namespace SystemIndicator
+{
+
+
+/**
+\brief Enables the persistent cache file for the hardware profile of this process.
+\param[in] filename Specifies the cache file, or null to use the default file (see 'GetDefaultProfileCachePath').
+\remarks This must be called before the first call of 'GetHardwareProfile' (and any 'QueryInformation'), e.g. at the beginning of 'main'.
+The first process after a reboot queries the hardware profile as usual and stores it in the cache file.
+All subsequent processes load the profile from this file instead of querying the static entries again.
+Entries that depend on the calling process ('ENTRY_EFFECTIVE_PROCESSORS' and 'ENTRY_EFFECTIVE_MEMORY') are never cached.
+The cache file is discarded if it was written before the last reboot or by another library version.
+Hardware changes without a reboot (e.g. CPU hot-plugging) are not detected.
+\return False if the filename is too long, or if no default filename is available on the host platform.
+\see GetHardwareProfile
+*/
+bool EnableProfileCache(const char* filename = NULL);
+
+//! Returns true if the hardware profile of this process was loaded from the cache file.
+bool IsHardwareProfileCached();
+
+/**
+\brief Returns the default filename of the profile cache.
+\remarks On Linux this is "$XDG_RUNTIME_DIR/systemindicator-profile.bin", or "/tmp/systemindicator-<uid>-profile.bin"
+if the environment variable "XDG_RUNTIME_DIR" is not set.
+\return False if the cache is not available on the host platform or the buffer is too small.
+*/
+bool GetDefaultProfileCachePath(char* buffer, std::size_t size);
+
+/**
+\brief Writes the specified hardware profile to the specified cache file.
+\remarks The file starts with a small header (magic number, cache format version, 'SI_VERSION', and boot ID),
+followed by the profile in the 'EXPORT_FORMAT_BINARY' record format.
+The file is written to a temporary file first and then renamed, so concurrent readers never see a partial file.
+\see SystemIndicatorExport.h
+*/
+bool SaveHardwareProfile(const char* filename, const InformationSnapshot& profile);
+
+/**
+\brief Loads a hardware profile from the specified cache file, which is mapped into memory with a single 'mmap'.
+\return False if the file does not exist, is not owned by the current user, was written before the last reboot, or by another library version.
+*/
+bool LoadHardwareProfile(const char* filename, InformationSnapshot& profile);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,124 @@
+/*
+ * SystemIndicatorSampler.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_SAMPLER_H__
+#define __SI_SAMPLER_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! CPU utilization between two samples. All values are percentages (0 to 100) of the elapsed CPU time.
+struct CPUUsage
+{
+    CPUUsage() :
+        busy    ( 0 ),
+        user    ( 0 ),
+        nice    ( 0 ),
+        system  ( 0 ),
+        idle    ( 0 ),
+        iowait  ( 0 ),
+        irq     ( 0 ),
+        softirq ( 0 ),
+        steal   ( 0 )
+    {
+    }
+
+    double busy;    //!< Time spent in any state other than idle and I/O wait.
+    double user;    //!< Time spent in user mode (including guests).
+    double nice;    //!< Time spent in user mode with low priority.
+    double system;  //!< Time spent in kernel mode.
+    double idle;    //!< Time spent idle.
+    double iowait;  //!< Time spent idle while waiting for I/O to complete.
+    double irq;     //!< Time spent servicing hardware interrupts.
+    double softirq; //!< Time spent servicing software interrupts.
+    double steal;   //!< Time stolen by the hypervisor for other virtual machines.
+};
+
+/**
+\brief Sampler for the CPU utilization of the whole system and of each logical CPU.
+\remarks Each call to 'Sample' computes the utilization since the previous call. On Linux this reads "/proc/stat",
+which is kept open, into a buffer that is allocated once; all counters are kept in preallocated arrays,
+so sampling does not allocate any heap memory. On Windows only the total utilization is available.
+\code
+CPUSampler sampler;
+for (;;)
+{
+    sleep(1);
+    sampler.Sample();
+    if (sampler.GetTotalUsage().busy > 90.0)
+        // shed load ...
+}
+\endcode
+*/
+class CPUSampler
+{
+
+    public:
+
+        //! Allocates all counters for the possible logical CPUs of the host system (including offline CPUs) and takes the initial sample.
+        CPUSampler();
+        ~CPUSampler();
+
+        CPUSampler(const CPUSampler&) = delete;
+        CPUSampler& operator = (const CPUSampler&) = delete;
+
+        /**
+        \brief Reads the current CPU counters and computes the utilization since the previous sample.
+        \return False if the counters could not be read. In this case the previous utilization is kept.
+        */
+        bool Sample();
+
+        //! Returns the utilization of all CPUs combined.
+        const CPUUsage& GetTotalUsage() const
+        {
+            return total_;
+        }
+
+        //! Returns the utilization of the specified logical CPU. CPUs that are offline have zero utilization.
+        const CPUUsage& GetUsage(std::size_t cpu) const
+        {
+            return usage_[cpu];
+        }
+
+        //! Returns the number of possible logical CPUs, i.e. the highest CPU number that can be brought online plus one.
+        std::size_t GetCPUCount() const
+        {
+            return usage_.size();
+        }
+
+    private:
+
+        //! Number of time counters per CPU: user, nice, system, idle, iowait, irq, softirq, steal.
+        static const std::size_t numCounters = 8;
+
+        //! Computes the utilization from the previous counters and updates them with the current counters.
+        static void UpdateUsage(unsigned long long* counters, const unsigned long long* current, CPUUsage& usage);
+
+        int                             fd_;                        //!< File descriptor of "/proc/stat" (only used on Linux).
+        std::vector<char>               buffer_;
+        unsigned long long              totalCounters_[numCounters];
+        std::vector<unsigned long long> counters_;                  //!< Previous counters of each CPU ('numCounters' per CPU).
+        CPUUsage                        total_;
+        std::vector<CPUUsage>           usage_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
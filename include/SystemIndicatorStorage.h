@@ -0,0 +1,230 @@
+/*
+ * SystemIndicatorStorage.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_STORAGE_H__
+#define __SI_STORAGE_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+//! Request queue properties of a block device, e.g. to size write batches and read-ahead.
+struct BlockDeviceQueue
+{
+    BlockDeviceQueue() :
+        rotational          ( false ),
+        logicalBlockSize    ( 0     ),
+        physicalBlockSize   ( 0     ),
+        optimalIOSize       ( 0     ),
+        maxIOSize           ( 0     ),
+        readAhead           ( 0     ),
+        requests            ( 0     )
+    {
+        scheduler[0] = '\0';
+    }
+
+    bool                rotational;         //!< True for spinning disks, false for SSDs and NVMe devices ("rotational").
+    unsigned int        logicalBlockSize;   //!< Smallest addressable unit (in bytes), e.g. 512 ("logical_block_size").
+    unsigned int        physicalBlockSize;  //!< Smallest unit the device can write without read-modify-write (in bytes), e.g. 4096 ("physical_block_size").
+    unsigned long long  optimalIOSize;      //!< Preferred I/O size (in bytes), e.g. the stripe width of a RAID, or 0 if not reported ("optimal_io_size").
+    unsigned int        maxIOSize;          //!< Largest request the kernel sends to the device (in KBs, "max_sectors_kb").
+    unsigned int        readAhead;          //!< Read-ahead window (in KBs, "read_ahead_kb").
+    unsigned int        requests;           //!< Number of requests that can be queued per hardware queue ("nr_requests").
+    char                scheduler[32];      //!< Active I/O scheduler, e.g. "mq-deadline", "bfq", or "none" ("scheduler").
+};
+
+//! Whole block device (i.e. no partition), e.g. "sda" or "nvme0n1".
+struct BlockDevice
+{
+    BlockDevice() :
+        major       ( 0     ),
+        minor       ( 0     ),
+        physical    ( false )
+    {
+        name[0] = '\0';
+    }
+
+    char                name[32];   //!< Kernel name of the device, e.g. "nvme0n1".
+    unsigned int        major;      //!< Major device number.
+    unsigned int        minor;      //!< Minor device number.
+    bool                physical;   //!< True if the device is backed by hardware, false for virtual devices (e.g. "loop0", "dm-0", or "zram0").
+    BlockDeviceQueue    queue;      //!< Request queue properties.
+};
+
+/**
+\brief Cumulative I/O counters of a block device since boot, as reported by "/proc/diskstats".
+\remarks Sectors are always 512 bytes, independent of the logical block size of the device. All times are in milliseconds.
+*/
+struct BlockDeviceCounters
+{
+    BlockDeviceCounters() :
+        reads           ( 0 ),
+        readsMerged     ( 0 ),
+        readSectors     ( 0 ),
+        readTime        ( 0 ),
+        writes          ( 0 ),
+        writesMerged    ( 0 ),
+        writeSectors    ( 0 ),
+        writeTime       ( 0 ),
+        inFlight        ( 0 ),
+        ioTime          ( 0 ),
+        weightedIOTime  ( 0 ),
+        discards        ( 0 ),
+        discardSectors  ( 0 ),
+        flushes         ( 0 )
+    {
+    }
+
+    unsigned long long reads;           //!< Number of completed read requests.
+    unsigned long long readsMerged;     //!< Number of read requests merged with adjacent requests.
+    unsigned long long readSectors;     //!< Number of sectors read.
+    unsigned long long readTime;        //!< Total time spent by all read requests.
+    unsigned long long writes;          //!< Number of completed write requests.
+    unsigned long long writesMerged;    //!< Number of write requests merged with adjacent requests.
+    unsigned long long writeSectors;    //!< Number of sectors written.
+    unsigned long long writeTime;       //!< Total time spent by all write requests.
+    unsigned long long inFlight;        //!< Number of requests currently in flight (this is not cumulative).
+    unsigned long long ioTime;          //!< Time in which at least one request was in flight.
+    unsigned long long weightedIOTime;  //!< Sum of the time all requests were in flight, i.e. the integral of 'inFlight' over time.
+    unsigned long long discards;        //!< Number of completed discard requests (Linux 4.18 or later).
+    unsigned long long discardSectors;  //!< Number of sectors discarded (Linux 4.18 or later).
+    unsigned long long flushes;         //!< Number of completed flush requests (Linux 5.5 or later).
+};
+
+//! I/O activity of a block device between two samples.
+struct BlockDeviceActivity
+{
+    BlockDeviceActivity() :
+        readIOPS        ( 0 ),
+        writeIOPS       ( 0 ),
+        readThroughput  ( 0 ),
+        writeThroughput ( 0 ),
+        readLatency     ( 0 ),
+        writeLatency    ( 0 ),
+        utilization     ( 0 ),
+        queueDepth      ( 0 )
+    {
+    }
+
+    double readIOPS;        //!< Completed read requests per second.
+    double writeIOPS;       //!< Completed write requests per second.
+    double readThroughput;  //!< Bytes read per second.
+    double writeThroughput; //!< Bytes written per second.
+    double readLatency;     //!< Average time per completed read request (in milliseconds).
+    double writeLatency;    //!< Average time per completed write request (in milliseconds).
+    double utilization;     //!< Share of time (in percent) in which at least one request was in flight. Devices with parallel queues (e.g. NVMe) can have capacity left at 100%.
+    double queueDepth;      //!< Average number of requests in flight.
+};
+
+/**
+\brief Queries all whole block devices and their queue properties.
+\remarks On Linux the devices are enumerated from "/proc/diskstats" (without partitions) and the queue properties
+are read from "/sys/block/<name>/queue".
+*/
+bool QueryBlockDevices(std::vector<BlockDevice>& devices);
+
+//! Queries the queue properties of the specified whole block device, e.g. "sda".
+bool QueryBlockDeviceQueue(const char* name, BlockDeviceQueue& queue);
+
+/**
+\brief Determines the whole block device that stores the file system of the specified path, e.g. "nvme0n1" for "/var/lib/data".
+\remarks For partitions, this is the device the partition belongs to. File systems without a block device (e.g. "tmpfs" or "overlay") are not supported.
+\return False if the path does not exist or its file system has no block device.
+*/
+bool QueryBlockDeviceOfPath(const char* path, char* name, std::size_t size);
+
+/**
+\brief Queries the sum of the I/O counters of all physical whole block devices.
+\remarks Virtual devices (e.g. device mapper or RAID devices) are excluded, since their requests are also counted by the underlying physical devices.
+On Linux the devices are classified once and cached by device number, so "/sys/block" is only accessed again when the device list changes.
+Apart from this cache, no heap memory is allocated.
+*/
+bool QueryDiskCounters(BlockDeviceCounters& total);
+
+/**
+\brief Sampler for the I/O counters and activity of all whole block devices.
+\remarks The devices are enumerated once on construction and sorted by device number (major and minor). On Linux "/proc/diskstats" is kept open and read into a buffer
+that is allocated once; all counters are kept in preallocated arrays, so sampling does not allocate any heap memory.
+Devices that are added after construction are ignored.
+\code
+DiskSampler sampler;
+for (;;)
+{
+    sleep(1);
+    sampler.Sample();
+    for (std::size_t i = 0; i < sampler.GetDeviceCount(); ++i)
+        printf("%s: %.0f IOPS\n", sampler.GetDevice(i).name, sampler.GetActivity(i).writeIOPS);
+}
+\endcode
+*/
+class DiskSampler
+{
+
+    public:
+
+        //! Enumerates all whole block devices and takes the initial sample.
+        DiskSampler();
+        ~DiskSampler();
+
+        DiskSampler(const DiskSampler&) = delete;
+        DiskSampler& operator = (const DiskSampler&) = delete;
+
+        /**
+        \brief Reads the current I/O counters and computes the activity since the previous sample.
+        \return False if the counters could not be read. In this case the previous activity is kept.
+        */
+        bool Sample();
+
+        //! Returns the number of block devices.
+        std::size_t GetDeviceCount() const
+        {
+            return devices_.size();
+        }
+
+        //! Returns the specified block device.
+        const BlockDevice& GetDevice(std::size_t index) const
+        {
+            return devices_[index];
+        }
+
+        //! Returns the cumulative counters of the specified block device from the last sample.
+        const BlockDeviceCounters& GetCounters(std::size_t index) const
+        {
+            return counters_[index];
+        }
+
+        //! Returns the activity of the specified block device between the last two samples.
+        const BlockDeviceActivity& GetActivity(std::size_t index) const
+        {
+            return activity_[index];
+        }
+
+    private:
+
+        int                                 fd_;            //!< File descriptor of "/proc/diskstats" (only used on Linux).
+        std::vector<char>                   buffer_;
+        unsigned long long                  timestamp_;     //!< Time of the last sample (in nanoseconds).
+        std::vector<BlockDevice>            devices_;
+        std::vector<BlockDeviceCounters>    counters_;
+        std::vector<BlockDeviceActivity>    activity_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,335 @@
+/*
+ * SystemIndicatorTopology.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_TOPOLOGY_H__
+#define __SI_TOPOLOGY_H__
+
+
+#include "SystemIndicator.h"
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+\brief Compact bit set of logical CPU indices.
+\remarks The set grows with the highest CPU index, so it scales to machines with thousands of logical CPUs.
+It can be parsed from and formatted to the kernel's CPU list format, e.g. "0-63,128-191".
+*/
+class CPUSet
+{
+
+    public:
+
+        //! Removes all CPUs from this set.
+        void Clear();
+
+        //! Adds the specified CPU to this set.
+        CPUSet& Add(unsigned int cpu);
+
+        //! Adds all CPUs in the range [first, last] to this set.
+        CPUSet& AddRange(unsigned int first, unsigned int last);
+
+        //! Removes the specified CPU from this set.
+        CPUSet& Remove(unsigned int cpu);
+
+        //! Returns true if the specified CPU is contained in this set.
+        bool Has(unsigned int cpu) const
+        {
+            const std::size_t word = cpu / 64;
+            return (word < words_.size() && ((words_[word] >> (cpu % 64)) & 0x1) != 0);
+        }
+
+        //! Returns the number of CPUs in this set.
+        std::size_t Count() const;
+
+        //! Returns true if this set is empty.
+        bool Empty() const;
+
+        //! Returns the lowest CPU in this set, or -1 if this set is empty.
+        int First() const;
+
+        //! Returns the highest CPU in this set, or -1 if this set is empty.
+        int Last() const;
+
+        //! Returns the next CPU after the specified CPU, or -1 if there is none.
+        int Next(int cpu) const;
+
+        //! Returns true if this set contains any CPU of the specified set.
+        bool Intersects(const CPUSet& rhs) const;
+
+        //! Returns true if this set contains all CPUs of the specified set.
+        bool Contains(const CPUSet& rhs) const;
+
+        //! Adds all CPUs of the specified set to this set.
+        CPUSet& operator |= (const CPUSet& rhs);
+
+        //! Removes all CPUs from this set that are not contained in the specified set.
+        CPUSet& operator &= (const CPUSet& rhs);
+
+        //! Removes all CPUs from this set that are contained in the specified set.
+        CPUSet& Subtract(const CPUSet& rhs);
+
+        bool operator == (const CPUSet& rhs) const;
+        bool operator != (const CPUSet& rhs) const;
+
+        /**
+        \brief Parses the specified CPU list, e.g. "0-3,8,10-11", and adds all CPUs to this set.
+        \remarks Parsing stops at the end of the text or at the first new-line character.
+        \return False if the text contains a syntax error.
+        */
+        bool Parse(const char* text, std::size_t length);
+
+        /**
+        \brief Writes this set as CPU list into the specified buffer, e.g. "0-3,8,10-11".
+        \return Length of the written string (without the null terminator). The string is truncated if the buffer is too small.
+        */
+        std::size_t Format(char* buffer, std::size_t size) const;
+
+        //! Returns the internal 64-bit words of this set. CPU 'i' corresponds to bit (i % 64) of word (i / 64).
+        const std::vector<unsigned long long>& GetWords() const
+        {
+            return words_;
+        }
+
+    private:
+
+        std::vector<unsigned long long> words_;
+
+};
+
+
+//! Cache type enumeration.
+enum CacheType
+{
+    CACHE_TYPE_UNIFIED,     //!< Unified cache for data and instructions.
+    CACHE_TYPE_DATA,        //!< Data cache.
+    CACHE_TYPE_INSTRUCTION, //!< Instruction cache.
+};
+
+//! Single instance of a cache, e.g. one L2 cache of a multi-core processor.
+struct CacheInstance
+{
+    CacheInstance() :
+        id ( -1 )
+    {
+    }
+
+    int     id;     //!< Platform specific cache ID, or -1 if not available.
+    CPUSet  cpus;   //!< Logical CPUs that share this cache instance.
+};
+
+//! Cache descriptor for one cache level and type, e.g. the L1 data caches.
+struct CacheInfo
+{
+    CacheInfo() :
+        level           ( 0                  ),
+        type            ( CACHE_TYPE_UNIFIED ),
+        size            ( 0                  ),
+        lineSize        ( 0                  ),
+        ways            ( 0                  ),
+        sets            ( 0                  ),
+        instanceCount   ( 0                  )
+    {
+    }
+
+    unsigned int                level;          //!< Cache level, e.g. 1 for L1 caches.
+    CacheType                   type;           //!< Cache type.
+    unsigned long long          size;           //!< Size of each instance (in Bytes).
+    unsigned int                lineSize;       //!< Coherency line size (in Bytes).
+    unsigned int                ways;           //!< Ways of associativity, or 0 if not available.
+    unsigned int                sets;           //!< Number of sets, or 0 if not available.
+    unsigned int                instanceCount;  //!< Number of instances, or 0 if not available.
+    std::vector<CacheInstance>  instances;      //!< Instances of this cache. Might be empty if the CPU sharing is not available.
+};
+
+
+/**
+\brief Queries the cache hierarchy of the host system.
+\param[out] caches Specifies the output list of cache descriptors, sorted by level and type.
+\remarks On Linux this reads "/sys/devices/system/cpu/cpu<N>/cache/index<M>" and falls back to 'sysconf' (without CPU sharing information).
+Each cache instance is only read once, i.e. CPUs that are already known to share an instance are skipped.
+\return True on success.
+*/
+bool QueryCacheInfo(std::vector<CacheInfo>& caches);
+
+
+/**
+\brief CPU topology tree of the host system: packages (sockets), dies, physical cores, SMT siblings, and NUMA nodes.
+\remarks All cross references are indices into the respective lists of this structure (or -1 if not available),
+so the topology of each logical CPU can be looked up in constant time, e.g.:
+\code
+const CPUTopology::LogicalCPU& cpu = topology.cpus[index];
+const CPUSet& siblings = topology.cores[cpu.core].cpus;
+\endcode
+*/
+struct CPUTopology
+{
+    //! Physical processor package (socket).
+    struct Package
+    {
+        Package() :
+            id ( -1 )
+        {
+        }
+
+        int     id;     //!< Platform specific package ID.
+        CPUSet  cpus;   //!< Logical CPUs of this package.
+    };
+
+    //! Die within a package. Packages without multiple dies have a single die.
+    struct Die
+    {
+        Die() :
+            id      ( -1 ),
+            package ( -1 )
+        {
+        }
+
+        int     id;         //!< Platform specific die ID (unique within its package).
+        int     package;    //!< Index of the package this die belongs to.
+        CPUSet  cpus;       //!< Logical CPUs of this die.
+    };
+
+    //! Physical core.
+    struct Core
+    {
+        Core() :
+            id      ( -1 ),
+            package ( -1 ),
+            die     ( -1 )
+        {
+        }
+
+        int     id;         //!< Platform specific core ID (unique within its die).
+        int     package;    //!< Index of the package this core belongs to.
+        int     die;        //!< Index of the die this core belongs to.
+        CPUSet  cpus;       //!< Logical CPUs of this core, i.e. the SMT siblings.
+    };
+
+    //! NUMA node.
+    struct Node
+    {
+        Node() :
+            id ( -1 )
+        {
+        }
+
+        int     id;     //!< Platform specific node ID.
+        CPUSet  cpus;   //!< Logical CPUs of this node.
+    };
+
+    //! Topology of a single logical CPU. All members are -1 for CPUs that are not online.
+    struct LogicalCPU
+    {
+        LogicalCPU() :
+            package     ( -1 ),
+            die         ( -1 ),
+            core        ( -1 ),
+            node        ( -1 ),
+            smtIndex    ( -1 )
+        {
+        }
+
+        int package;    //!< Index into 'CPUTopology::packages'.
+        int die;        //!< Index into 'CPUTopology::dies'.
+        int core;       //!< Index into 'CPUTopology::cores'.
+        int node;       //!< Index into 'CPUTopology::nodes'.
+        int smtIndex;   //!< Index of this CPU within its core, i.e. 0 for the first SMT sibling.
+    };
+
+    CPUSet                  online;     //!< All online logical CPUs.
+    std::vector<Package>    packages;   //!< Packages in the order of their first logical CPU.
+    std::vector<Die>        dies;       //!< Dies in the order of their first logical CPU.
+    std::vector<Core>       cores;      //!< Cores in the order of their first logical CPU.
+    std::vector<Node>       nodes;      //!< NUMA nodes sorted by ID. Systems without NUMA support have a single node.
+    std::vector<LogicalCPU> cpus;       //!< Logical CPUs indexed by the CPU number (up to the highest online CPU).
+};
+
+/**
+\brief Queries the CPU topology of the host system.
+\remarks On Linux this reads "/sys/devices/system/cpu/cpu<N>/topology" and "/sys/devices/system/node".
+The CPU list and ID of each package ("package_cpus_list") and die ("die_cpus_list") are read only once, from its first CPU,
+and only one CPU per physical core is read, since its shared CPU list ("core_cpus_list") already includes all SMT siblings.
+The NUMA nodes are read with one CPU list per node.
+\return True on success.
+*/
+bool QueryCPUTopology(CPUTopology& topology);
+
+
+//! Memory status and CPUs of a single NUMA node. All sizes are in KBs and 0 if not available on the host platform.
+struct NUMANodeInfo
+{
+    NUMANodeInfo() :
+        id          ( -1 ),
+        total       ( 0  ),
+        free        ( 0  ),
+        filePages   ( 0  )
+    {
+    }
+
+    int                 id;         //!< Platform specific node ID.
+    unsigned long long  total;      //!< Total physical memory of this node ("MemTotal").
+    unsigned long long  free;       //!< Unused physical memory of this node ("MemFree").
+    unsigned long long  filePages;  //!< File-backed memory of this node, i.e. page cache ("FilePages").
+    CPUSet              cpus;       //!< Logical CPUs of this node.
+};
+
+/**
+\brief NUMA report with per-node memory, the node distance matrix, and the mapping from logical CPUs to nodes.
+\remarks All lookups are constant time, e.g. the distance from the node of the current CPU to another node:
+\code
+int from = numa.GetCPUNode(cpu);
+unsigned int distance = numa.GetDistance(from, to);
+\endcode
+*/
+struct NUMAInfo
+{
+    //! Returns the relative distance between the two specified nodes (node indices, not IDs), e.g. 10 for local and 20 for remote memory.
+    unsigned int GetDistance(std::size_t from, std::size_t to) const
+    {
+        return distances[from * nodes.size() + to];
+    }
+
+    //! Returns the node index of the specified logical CPU, or -1 if the CPU is unknown.
+    int GetCPUNode(unsigned int cpu) const
+    {
+        return (cpu < cpuNodes.size() ? cpuNodes[cpu] : -1);
+    }
+
+    std::vector<NUMANodeInfo>   nodes;      //!< NUMA nodes sorted by ID. Systems without NUMA support have a single node.
+    std::vector<unsigned int>   distances;  //!< Distance matrix with 'nodes.size()' rows and columns (row-major), or 0 if not available.
+    std::vector<int>            cpuNodes;   //!< Node index of each logical CPU (indexed by the CPU number), or -1 if the CPU is unknown.
+};
+
+/**
+\brief Queries the NUMA nodes, their memory status, the node distance matrix, and the CPU-to-node mapping.
+\remarks On Linux this reads "/sys/devices/system/node/node<N>/{meminfo,distance,cpulist}".
+Systems without NUMA support are reported as a single node with the machine-wide memory status.
+\return True on success.
+\see QueryNUMAMemory
+*/
+bool QueryNUMAInfo(NUMAInfo& info);
+
+/**
+\brief Updates only the memory status of all nodes of the specified NUMA report.
+\remarks This does not allocate any heap memory, so it is suitable for continuous sampling.
+\return True on success.
+*/
+bool QueryNUMAMemory(NUMAInfo& info);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,186 @@
+/*
+ * BackgroundCollector.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorCollector.h>
+#include <algorithm>
+#include <chrono>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+static unsigned long long GetTimestamp()
+{
+    return static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+}
+
+
+/*
+ * BackgroundCollector class
+ */
+
+BackgroundCollector::BackgroundCollector(const BackgroundCollectorConfig& config) :
+    config_         ( config                                    ),
+    numSlots_       ( std::max<std::size_t>(config.history, 2)  ),
+    slots_          ( new Slot[numSlots_]                       ),
+    published_      ( 0                                         ),
+    stopRequested_  ( false                                     )
+{
+    config_.history = numSlots_;
+    for (std::size_t i = 0; i < numSlots_; ++i)
+    {
+        slots_[i].sequence.store(0, std::memory_order_relaxed);
+        slots_[i].timestamp = 0;
+    }
+}
+
+BackgroundCollector::~BackgroundCollector()
+{
+    Stop();
+}
+
+bool BackgroundCollector::Start()
+{
+    if (thread_.joinable())
+        return false;
+
+    stopRequested_ = false;
+    thread_ = std::thread(&BackgroundCollector::Run, this);
+
+    return true;
+}
+
+void BackgroundCollector::Stop()
+{
+    if (!thread_.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    stopSignal_.notify_all();
+
+    thread_.join();
+}
+
+bool BackgroundCollector::Read(InformationSnapshot& snapshot, unsigned long long* timestamp) const
+{
+    for (;;)
+    {
+        const unsigned long long sample = published_.load(std::memory_order_acquire);
+        if (sample == 0)
+            return false;
+
+        /* Only retry if the collector has overwritten the slot during the copy, i.e. it has lapped the entire ring buffer */
+        if (ReadSlot(sample, snapshot, timestamp))
+            return true;
+    }
+}
+
+bool BackgroundCollector::ReadHistory(std::size_t age, InformationSnapshot& snapshot, unsigned long long* timestamp) const
+{
+    const unsigned long long sample = published_.load(std::memory_order_acquire);
+    if (age >= numSlots_ || age >= sample)
+        return false;
+    return ReadSlot(sample - age, snapshot, timestamp);
+}
+
+unsigned long long BackgroundCollector::GetNumber(const InformationEntry entry) const
+{
+    for (;;)
+    {
+        const unsigned long long sample = published_.load(std::memory_order_acquire);
+        if (sample == 0)
+            return 0;
+
+        const Slot& slot = slots_[(sample - 1) % numSlots_];
+        const unsigned long long sequence = sample * 2;
+
+        if (slot.sequence.load(std::memory_order_acquire) != sequence)
+            continue;
+
+        const unsigned long long number = slot.snapshot.GetNumber(entry);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+            return number;
+    }
+}
+
+void BackgroundCollector::Run()
+{
+    /* Query into a local snapshot, so each slot is only locked for the duration of a memory copy */
+    InformationSnapshot snapshot;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopRequested_)
+    {
+        lock.unlock();
+        QueryInformation(snapshot, config_.entries);
+        Publish(snapshot, GetTimestamp());
+        lock.lock();
+
+        stopSignal_.wait_for(lock, std::chrono::milliseconds(config_.interval), [this]() { return stopRequested_; });
+    }
+}
+
+/*
+The sequence number of the slot for sample N is 2N-1 while the slot is written and 2N once it is complete,
+so readers can detect both torn copies and slots that already contain a newer sample.
+*/
+void BackgroundCollector::Publish(const InformationSnapshot& snapshot, unsigned long long timestamp)
+{
+    const unsigned long long sample = published_.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots_[(sample - 1) % numSlots_];
+
+    slot.sequence.store(sample * 2 - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestamp  = timestamp;
+    slot.snapshot   = snapshot;
+
+    slot.sequence.store(sample * 2, std::memory_order_release);
+    published_.store(sample, std::memory_order_release);
+}
+
+bool BackgroundCollector::ReadSlot(unsigned long long sample, InformationSnapshot& snapshot, unsigned long long* timestamp) const
+{
+    const Slot& slot = slots_[(sample - 1) % numSlots_];
+    const unsigned long long sequence = sample * 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != sequence)
+        return false;
+
+    /* Copy the slot speculatively; the copy is discarded if the sequence number has changed in the meantime */
+    snapshot = slot.snapshot;
+    const unsigned long long slotTimestamp = slot.timestamp;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        return false;
+
+    if (timestamp != NULL)
+        *timestamp = slotTimestamp;
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
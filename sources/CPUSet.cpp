@@ -0,0 +1,279 @@
+/*
+ * CPUSet.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorTopology.h>
+#include <cstdio>
+
+
+namespace SystemIndicator
+{
+
+
+static std::size_t PopCount(unsigned long long bits)
+{
+    std::size_t n = 0;
+    for (; bits != 0; ++n)
+        bits &= bits - 1;
+    return n;
+}
+
+static int LowestBit(unsigned long long bits)
+{
+    int i = 0;
+    while ((bits & 0x1) == 0)
+    {
+        bits >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+void CPUSet::Clear()
+{
+    words_.clear();
+}
+
+CPUSet& CPUSet::Add(unsigned int cpu)
+{
+    const std::size_t word = cpu / 64;
+    if (word >= words_.size())
+        words_.resize(word + 1, 0);
+    words_[word] |= (1ull << (cpu % 64));
+    return *this;
+}
+
+CPUSet& CPUSet::AddRange(unsigned int first, unsigned int last)
+{
+    if (first > last)
+        return *this;
+
+    const std::size_t lastWord = last / 64;
+    if (lastWord >= words_.size())
+        words_.resize(lastWord + 1, 0);
+
+    for (unsigned int cpu = first; cpu <= last; ++cpu)
+    {
+        /* Fill entire words at once */
+        if (cpu % 64 == 0 && cpu + 63 <= last)
+        {
+            words_[cpu / 64] = ~0ull;
+            cpu += 63;
+        }
+        else
+            words_[cpu / 64] |= (1ull << (cpu % 64));
+    }
+
+    return *this;
+}
+
+CPUSet& CPUSet::Remove(unsigned int cpu)
+{
+    const std::size_t word = cpu / 64;
+    if (word < words_.size())
+        words_[word] &= ~(1ull << (cpu % 64));
+    return *this;
+}
+
+std::size_t CPUSet::Count() const
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < words_.size(); ++i)
+        n += PopCount(words_[i]);
+    return n;
+}
+
+bool CPUSet::Empty() const
+{
+    for (std::size_t i = 0; i < words_.size(); ++i)
+    {
+        if (words_[i] != 0)
+            return false;
+    }
+    return true;
+}
+
+int CPUSet::First() const
+{
+    return Next(-1);
+}
+
+int CPUSet::Last() const
+{
+    for (std::size_t word = words_.size(); word-- > 0;)
+    {
+        if (words_[word] != 0)
+        {
+            int i = 63;
+            while (((words_[word] >> i) & 0x1) == 0)
+                --i;
+            return static_cast<int>(word * 64) + i;
+        }
+    }
+    return -1;
+}
+
+int CPUSet::Next(int cpu) const
+{
+    const unsigned int start = static_cast<unsigned int>(cpu + 1);
+    std::size_t word = start / 64;
+
+    if (word >= words_.size())
+        return -1;
+
+    /* Mask out all bits up to the specified CPU in the first word */
+    unsigned long long bits = words_[word] & (~0ull << (start % 64));
+
+    while (bits == 0)
+    {
+        if (++word >= words_.size())
+            return -1;
+        bits = words_[word];
+    }
+
+    return static_cast<int>(word * 64) + LowestBit(bits);
+}
+
+bool CPUSet::Intersects(const CPUSet& rhs) const
+{
+    const std::size_t n = (words_.size() < rhs.words_.size() ? words_.size() : rhs.words_.size());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if ((words_[i] & rhs.words_[i]) != 0)
+            return true;
+    }
+    return false;
+}
+
+bool CPUSet::Contains(const CPUSet& rhs) const
+{
+    for (std::size_t i = 0; i < rhs.words_.size(); ++i)
+    {
+        const unsigned long long bits = (i < words_.size() ? words_[i] : 0);
+        if ((bits & rhs.words_[i]) != rhs.words_[i])
+            return false;
+    }
+    return true;
+}
+
+CPUSet& CPUSet::operator |= (const CPUSet& rhs)
+{
+    if (rhs.words_.size() > words_.size())
+        words_.resize(rhs.words_.size(), 0);
+    for (std::size_t i = 0; i < rhs.words_.size(); ++i)
+        words_[i] |= rhs.words_[i];
+    return *this;
+}
+
+CPUSet& CPUSet::operator &= (const CPUSet& rhs)
+{
+    for (std::size_t i = 0; i < words_.size(); ++i)
+        words_[i] &= (i < rhs.words_.size() ? rhs.words_[i] : 0);
+    return *this;
+}
+
+CPUSet& CPUSet::Subtract(const CPUSet& rhs)
+{
+    const std::size_t n = (words_.size() < rhs.words_.size() ? words_.size() : rhs.words_.size());
+    for (std::size_t i = 0; i < n; ++i)
+        words_[i] &= ~rhs.words_[i];
+    return *this;
+}
+
+bool CPUSet::operator == (const CPUSet& rhs) const
+{
+    const std::size_t n = (words_.size() > rhs.words_.size() ? words_.size() : rhs.words_.size());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const unsigned long long lhsBits = (i < words_.size() ? words_[i] : 0);
+        const unsigned long long rhsBits = (i < rhs.words_.size() ? rhs.words_[i] : 0);
+        if (lhsBits != rhsBits)
+            return false;
+    }
+    return true;
+}
+
+bool CPUSet::operator != (const CPUSet& rhs) const
+{
+    return !(*this == rhs);
+}
+
+// Parses an unsigned decimal number and returns false if there is no digit.
+static bool ParseCPUIndex(const char*& s, const char* end, unsigned int& value)
+{
+    if (s >= end || *s < '0' || *s > '9')
+        return false;
+
+    unsigned int n = 0;
+    while (s < end && *s >= '0' && *s <= '9')
+        n = n*10 + static_cast<unsigned int>(*s++ - '0');
+
+    value = n;
+    return true;
+}
+
+bool CPUSet::Parse(const char* text, std::size_t length)
+{
+    const char* s = text;
+    const char* end = text + length;
+
+    while (s < end && *s != '\n')
+    {
+        unsigned int first = 0, last = 0;
+
+        if (!ParseCPUIndex(s, end, first))
+            return false;
+
+        last = first;
+        if (s < end && *s == '-' && (++s, !ParseCPUIndex(s, end, last)))
+            return false;
+
+        AddRange(first, last);
+
+        if (s < end && *s == ',')
+            ++s;
+        else if (s < end && *s != '\n')
+            return false;
+    }
+
+    return true;
+}
+
+std::size_t CPUSet::Format(char* buffer, std::size_t size) const
+{
+    if (size == 0)
+        return 0;
+
+    std::size_t len = 0;
+    buffer[0] = '\0';
+
+    for (int first = First(); first >= 0;)
+    {
+        /* Find end of contiguous range */
+        int last = first;
+        while (Has(static_cast<unsigned int>(last + 1)))
+            ++last;
+
+        const int n = (first == last)
+            ? std::snprintf(buffer + len, size - len, (len > 0 ? ",%d" : "%d"), first)
+            : std::snprintf(buffer + len, size - len, (len > 0 ? ",%d-%d" : "%d-%d"), first, last);
+
+        if (n < 0 || static_cast<std::size_t>(n) >= size - len)
+            return size - 1;
+
+        len += static_cast<std::size_t>(n);
+        first = Next(last);
+    }
+
+    return len;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,46 @@
+/*
+ * Collector.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_COLLECTOR_H__
+#define __SI_COLLECTOR_H__
+
+
+#include <SystemIndicator.h>
+
+
+namespace SystemIndicator
+{
+
+
+//! Collector function that writes one or more entries into the snapshot.
+typedef void (*CollectorFunc)(InformationSnapshot& snapshot);
+
+/**
+Collector descriptor for a single information entry.
+Multiple entries can share the same collector function, which is then only executed once per query.
+*/
+struct EntryCollector
+{
+    CollectorFunc           collect;    // Null if the entry is not available on the host platform.
+    InformationEntryCost    cost;
+};
+
+/**
+Returns the table of collectors of the host platform, with one descriptor for each 'InformationEntry'.
+This is implemented by each platform backend.
+*/
+const EntryCollector* GetEntryCollectors();
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
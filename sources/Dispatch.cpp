@@ -0,0 +1,132 @@
+/*
+ * Dispatch.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorDispatch.h>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace SystemIndicator
+{
+
+
+static const char* g_dispatchTierNames[DISPATCH_TIER_COUNT] =
+{
+    "Scalar",
+    "SSE4.2",
+    "AVX2",
+    "AVX512",
+};
+
+// Returns the dispatch tier limit from the environment variable "SI_DISPATCH_TIER" (case insensitive), or the highest tier.
+static DispatchTier DispatchTierLimitFromEnv()
+{
+    if (const char* value = std::getenv("SI_DISPATCH_TIER"))
+    {
+        for (int i = 0; i < DISPATCH_TIER_COUNT; ++i)
+        {
+            const char* name = g_dispatchTierNames[i];
+            std::size_t len = 0;
+
+            while (name[len] != '\0' && value[len] != '\0' && (name[len] | 0x20) == (value[len] | 0x20))
+                ++len;
+
+            if (name[len] == '\0' && value[len] == '\0')
+                return static_cast<DispatchTier>(i);
+        }
+    }
+    return DISPATCH_TIER_AVX512;
+}
+
+static std::atomic<int>& DispatchTierLimit()
+{
+    static std::atomic<int> limit(DispatchTierLimitFromEnv());
+    return limit;
+}
+
+const char* DispatchTierName(const DispatchTier tier)
+{
+    return (tier >= 0 && tier < DISPATCH_TIER_COUNT ? g_dispatchTierNames[tier] : "");
+}
+
+CPUFeatureSet GetDispatchTierFeatures(const DispatchTier tier)
+{
+    CPUFeatureSet features;
+
+    if (tier >= DISPATCH_TIER_SSE4_2)
+    {
+        features
+            .Add(CPU_FEATURE_SSE)
+            .Add(CPU_FEATURE_SSE2)
+            .Add(CPU_FEATURE_SSE3)
+            .Add(CPU_FEATURE_SSSE3)
+            .Add(CPU_FEATURE_SSE4_1)
+            .Add(CPU_FEATURE_SSE4_2)
+            .Add(CPU_FEATURE_POPCNT);
+    }
+
+    if (tier >= DISPATCH_TIER_AVX2)
+    {
+        features
+            .Add(CPU_FEATURE_AVX)
+            .Add(CPU_FEATURE_AVX2)
+            .Add(CPU_FEATURE_FMA)
+            .Add(CPU_FEATURE_F16C)
+            .Add(CPU_FEATURE_BMI1)
+            .Add(CPU_FEATURE_BMI2)
+            .Add(CPU_FEATURE_LZCNT)
+            .Add(CPU_FEATURE_MOVBE);
+    }
+
+    if (tier >= DISPATCH_TIER_AVX512)
+    {
+        features
+            .Add(CPU_FEATURE_AVX512F)
+            .Add(CPU_FEATURE_AVX512CD)
+            .Add(CPU_FEATURE_AVX512BW)
+            .Add(CPU_FEATURE_AVX512DQ)
+            .Add(CPU_FEATURE_AVX512VL);
+    }
+
+    return features;
+}
+
+// Returns the highest tier the host CPU supports, without the dispatch tier limit.
+static DispatchTier DetectDispatchTier()
+{
+    const CPUFeatureSet& features = QueryCPUFeatures();
+
+    int tier = DISPATCH_TIER_COUNT - 1;
+    while (tier > DISPATCH_TIER_SCALAR && !features.HasAll(GetDispatchTierFeatures(static_cast<DispatchTier>(tier))))
+        --tier;
+
+    return static_cast<DispatchTier>(tier);
+}
+
+DispatchTier GetSupportedDispatchTier()
+{
+    static const DispatchTier hostTier = DetectDispatchTier();
+    const DispatchTier limit = GetDispatchTierLimit();
+    return (hostTier < limit ? hostTier : limit);
+}
+
+void SetDispatchTierLimit(const DispatchTier tier)
+{
+    DispatchTierLimit().store(tier, std::memory_order_relaxed);
+}
+
+DispatchTier GetDispatchTierLimit()
+{
+    return static_cast<DispatchTier>(DispatchTierLimit().load(std::memory_order_relaxed));
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,344 @@
+/*
+ * Exporter.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorExport.h>
+#include <cstring>
+#include "FormatWriter.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal constants
+ */
+
+static const char           g_binaryMagic       = 'S';
+static const unsigned char  g_binaryVersion     = 1;
+static const std::size_t    g_binaryHeaderSize  = 10;
+
+// Each field of a binary record stores the entry as a single byte
+static_assert(ENTRY_COUNT <= 256, "binary export format must be extended for more than 256 information entries");
+
+
+/*
+ * Internal functions
+ */
+
+// Writes the specified text as JSON string with quotes and escape sequences.
+static void WriteJSONString(FormatWriter& writer, const char* text)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    writer.Write('"');
+
+    for (; *text != '\0'; ++text)
+    {
+        const unsigned char c = static_cast<unsigned char>(*text);
+        switch (c)
+        {
+            case '"':   writer.Write("\\\"", 2); break;
+            case '\\':  writer.Write("\\\\", 2); break;
+            case '\n':  writer.Write("\\n", 2);  break;
+            case '\r':  writer.Write("\\r", 2);  break;
+            case '\t':  writer.Write("\\t", 2);  break;
+            default:
+                if (c < 0x20)
+                {
+                    const char escape[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xf] };
+                    writer.Write(escape, sizeof(escape));
+                }
+                else
+                    writer.Write(static_cast<char>(c));
+                break;
+        }
+    }
+
+    writer.Write('"');
+}
+
+// Writes the specified text as Prometheus label value with quotes and escape sequences.
+static void WritePrometheusLabelValue(FormatWriter& writer, const char* text)
+{
+    writer.Write('"');
+
+    for (; *text != '\0'; ++text)
+    {
+        switch (*text)
+        {
+            case '"':   writer.Write("\\\"", 2); break;
+            case '\\':  writer.Write("\\\\", 2); break;
+            case '\n':  writer.Write("\\n", 2);  break;
+            default:    writer.Write(*text);     break;
+        }
+    }
+
+    writer.Write('"');
+}
+
+static void ExportJSON(const InformationSnapshot& snapshot, FormatWriter& writer)
+{
+    bool first = true;
+
+    writer.Write('{');
+
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const InformationEntry entry = static_cast<InformationEntry>(i);
+        const InformationValueType type = snapshot.GetType(entry);
+
+        if (type == VALUE_NONE)
+            continue;
+
+        if (!first)
+            writer.Write(',');
+        first = false;
+
+        writer.Write('"');
+        writer.Write(InformationEntryKey(entry));
+        writer.Write("\":", 2);
+
+        if (type == VALUE_NUMBER)
+            writer.WriteFixedPoint(snapshot.GetNumber(entry), InformationEntryDecimals(entry));
+        else
+            WriteJSONString(writer, snapshot.GetText(entry));
+    }
+
+    writer.Write("}\n", 2);
+}
+
+static void ExportPrometheus(const InformationSnapshot& snapshot, FormatWriter& writer)
+{
+    bool hasText = false;
+
+    /* Write all numbers as gauges, except for monotonic counters, whose names get the "_total" suffix by convention */
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const InformationEntry entry = static_cast<InformationEntry>(i);
+        const InformationValueType type = snapshot.GetType(entry);
+
+        if (type == VALUE_TEXT)
+            hasText = true;
+        if (type != VALUE_NUMBER)
+            continue;
+
+        const char* key = InformationEntryKey(entry);
+        const bool counter = InformationEntryIsCounter(entry);
+        const char* suffix = (counter ? "_total" : "");
+
+        writer.Write("# HELP systemindicator_");
+        writer.Write(key);
+        writer.Write(suffix);
+        writer.Write(' ');
+        writer.Write(InformationEntryName(entry));
+        writer.Write("\n# TYPE systemindicator_");
+        writer.Write(key);
+        writer.Write(suffix);
+        writer.Write(counter ? " counter\nsystemindicator_" : " gauge\nsystemindicator_");
+        writer.Write(key);
+        writer.Write(suffix);
+        writer.Write(' ');
+        writer.WriteFixedPoint(snapshot.GetNumber(entry), InformationEntryDecimals(entry));
+        writer.Write('\n');
+    }
+
+    /* Write all texts as labels of a single info metric */
+    if (hasText)
+    {
+        writer.Write("# HELP systemindicator_info System information\n# TYPE systemindicator_info gauge\nsystemindicator_info{");
+
+        bool first = true;
+
+        for (int i = 0; i < ENTRY_COUNT; ++i)
+        {
+            const InformationEntry entry = static_cast<InformationEntry>(i);
+            if (snapshot.GetType(entry) != VALUE_TEXT)
+                continue;
+
+            if (!first)
+                writer.Write(',');
+            first = false;
+
+            writer.Write(InformationEntryKey(entry));
+            writer.Write('=');
+            WritePrometheusLabelValue(writer, snapshot.GetText(entry));
+        }
+
+        writer.Write("} 1\n");
+    }
+}
+
+// Returns the length of the binary record of the specified snapshot.
+static std::size_t GetBinaryRecordSize(const InformationSnapshot& snapshot)
+{
+    std::size_t size = g_binaryHeaderSize;
+
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const InformationEntry entry = static_cast<InformationEntry>(i);
+        switch (snapshot.GetType(entry))
+        {
+            case VALUE_NUMBER:
+                size += 2 + 8;
+                break;
+            case VALUE_TEXT:
+                size += 2 + 2 + std::strlen(snapshot.GetText(entry));
+                break;
+            default:
+                break;
+        }
+    }
+
+    return size;
+}
+
+static void ExportBinary(const InformationSnapshot& snapshot, FormatWriter& writer)
+{
+    /* Write header */
+    unsigned int numFields = 0;
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        if (snapshot.Has(static_cast<InformationEntry>(i)))
+            ++numFields;
+    }
+
+    writer.WriteLittleEndian(GetBinaryRecordSize(snapshot), 4);
+    writer.Write(g_binaryMagic);
+    writer.Write(static_cast<char>(g_binaryVersion));
+    writer.WriteLittleEndian(ENTRY_COUNT, 2);
+    writer.WriteLittleEndian(numFields, 2);
+
+    /* Write fields */
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const InformationEntry entry = static_cast<InformationEntry>(i);
+        const InformationValueType type = snapshot.GetType(entry);
+
+        if (type == VALUE_NONE)
+            continue;
+
+        writer.Write(static_cast<char>(i));
+        writer.Write(static_cast<char>(type));
+
+        if (type == VALUE_NUMBER)
+            writer.WriteLittleEndian(snapshot.GetNumber(entry), 8);
+        else
+        {
+            const char* text = snapshot.GetText(entry);
+            const std::size_t length = std::strlen(text);
+            writer.WriteLittleEndian(length, 2);
+            writer.Write(text, length);
+        }
+    }
+}
+
+static unsigned long long ReadLittleEndian(const char* data, std::size_t bytes)
+{
+    unsigned long long number = 0;
+    for (std::size_t i = 0; i < bytes; ++i)
+        number |= static_cast<unsigned long long>(static_cast<unsigned char>(data[i])) << (i * 8);
+    return number;
+}
+
+
+/*
+ * Global functions
+ */
+
+void ExportInformation(const InformationSnapshot& snapshot, const ExportFormat format, FormatSink sink, void* userData)
+{
+    FormatWriter writer(sink, userData);
+
+    switch (format)
+    {
+        case EXPORT_FORMAT_JSON:
+            ExportJSON(snapshot, writer);
+            break;
+        case EXPORT_FORMAT_PROMETHEUS:
+            ExportPrometheus(snapshot, writer);
+            break;
+        case EXPORT_FORMAT_BINARY:
+            ExportBinary(snapshot, writer);
+            break;
+    }
+}
+
+std::size_t ExportInformation(const InformationSnapshot& snapshot, const ExportFormat format, char* buffer, std::size_t size)
+{
+    BufferSink bufferSink(buffer, size);
+    ExportInformation(snapshot, format, BufferSink::Write, &bufferSink);
+    return bufferSink.Finish();
+}
+
+std::size_t ReadBinaryRecord(const char* data, std::size_t size, InformationSnapshot& snapshot)
+{
+    /* Validate header */
+    if (size < g_binaryHeaderSize)
+        return 0;
+
+    const std::size_t length = static_cast<std::size_t>(ReadLittleEndian(data, 4));
+
+    if (length < g_binaryHeaderSize || length > size ||
+        data[4] != g_binaryMagic ||
+        static_cast<unsigned char>(data[5]) != g_binaryVersion ||
+        ReadLittleEndian(data + 6, 2) != ENTRY_COUNT)
+    {
+        return 0;
+    }
+
+    const unsigned long long numFields = ReadLittleEndian(data + 8, 2);
+
+    /* Read fields */
+    snapshot.Clear();
+
+    const char* pos = data + g_binaryHeaderSize;
+    const char* end = data + length;
+
+    for (unsigned long long i = 0; i < numFields; ++i)
+    {
+        if (end - pos < 2)
+            return 0;
+
+        const unsigned int entry    = static_cast<unsigned char>(pos[0]);
+        const unsigned int type     = static_cast<unsigned char>(pos[1]);
+        pos += 2;
+
+        if (entry >= ENTRY_COUNT)
+            return 0;
+
+        if (type == VALUE_NUMBER)
+        {
+            if (end - pos < 8)
+                return 0;
+            snapshot.SetNumber(static_cast<InformationEntry>(entry), ReadLittleEndian(pos, 8));
+            pos += 8;
+        }
+        else if (type == VALUE_TEXT)
+        {
+            if (end - pos < 2)
+                return 0;
+            const std::size_t textLength = static_cast<std::size_t>(ReadLittleEndian(pos, 2));
+            pos += 2;
+            if (static_cast<std::size_t>(end - pos) < textLength)
+                return 0;
+            snapshot.SetText(static_cast<InformationEntry>(entry), pos, textLength);
+            pos += textLength;
+        }
+        else
+            return 0;
+    }
+
+    return length;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,195 @@
+/*
+ * FormatWriter.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_FORMAT_WRITER_H__
+#define __SI_FORMAT_WRITER_H__
+
+
+#include <SystemIndicator.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+Collects the output in a small fixed-size chunk and passes it to the sink when the chunk is full,
+so the sink is called only a few times per formatted snapshot. This does not allocate any heap memory.
+*/
+class FormatWriter
+{
+
+    public:
+
+        FormatWriter(FormatSink sink, void* userData) :
+            sink_       ( sink      ),
+            userData_   ( userData  ),
+            length_     ( 0         )
+        {
+        }
+
+        ~FormatWriter()
+        {
+            Flush();
+        }
+
+        FormatWriter(const FormatWriter&) = delete;
+        FormatWriter& operator = (const FormatWriter&) = delete;
+
+        void Write(const char* text, std::size_t length)
+        {
+            while (length > 0)
+            {
+                if (length_ == sizeof(chunk_))
+                    Flush();
+
+                const std::size_t n = std::min(length, sizeof(chunk_) - length_);
+                std::memcpy(chunk_ + length_, text, n);
+                length_ += n;
+                text    += n;
+                length  -= n;
+            }
+        }
+
+        void Write(const char* text)
+        {
+            Write(text, std::strlen(text));
+        }
+
+        void Write(char c)
+        {
+            if (length_ == sizeof(chunk_))
+                Flush();
+            chunk_[length_++] = c;
+        }
+
+        void WriteSpaces(std::size_t count)
+        {
+            for (; count > 0; --count)
+                Write(' ');
+        }
+
+        // Writes the specified number in decimal format.
+        void WriteNumber(unsigned long long number)
+        {
+            char digits[24];
+            std::size_t n = 0;
+
+            do
+            {
+                digits[sizeof(digits) - 1 - n++] = static_cast<char>('0' + number % 10);
+                number /= 10;
+            }
+            while (number > 0);
+
+            Write(digits + sizeof(digits) - n, n);
+        }
+
+        // Writes the specified fixed-point number with the specified number of decimal places, e.g. 125 with 2 decimals as "1.25".
+        void WriteFixedPoint(unsigned long long number, unsigned int decimals)
+        {
+            if (decimals == 0)
+            {
+                WriteNumber(number);
+                return;
+            }
+
+            unsigned long long scale = 1;
+            for (unsigned int i = 0; i < decimals; ++i)
+                scale *= 10;
+
+            WriteNumber(number / scale);
+            Write('.');
+
+            const unsigned long long fraction = number % scale;
+            for (unsigned long long digit = scale / 10; digit > 0; digit /= 10)
+                Write(static_cast<char>('0' + (fraction / digit) % 10));
+        }
+
+        // Writes the specified number with the specified number of bytes in little-endian byte order.
+        void WriteLittleEndian(unsigned long long number, std::size_t bytes)
+        {
+            for (std::size_t i = 0; i < bytes; ++i)
+                Write(static_cast<char>((number >> (i * 8)) & 0xff));
+        }
+
+        void Flush()
+        {
+            if (length_ > 0)
+            {
+                sink_(chunk_, length_, userData_);
+                length_ = 0;
+            }
+        }
+
+    private:
+
+        FormatSink  sink_;
+        void*       userData_;
+        std::size_t length_;
+        char        chunk_[256];
+
+};
+
+/**
+Sink that writes into a caller-provided buffer. The total length is counted even if the buffer is too small,
+so 'Finish' returns the required buffer size (without the null terminator) like 'snprintf'.
+*/
+class BufferSink
+{
+
+    public:
+
+        BufferSink(char* buffer, std::size_t size) :
+            buffer_ ( buffer    ),
+            size_   ( size      ),
+            length_ ( 0         )
+        {
+        }
+
+        // Sink function for 'FormatWriter'; 'userData' must point to a 'BufferSink'.
+        static void Write(const char* text, std::size_t length, void* userData)
+        {
+            BufferSink* self = reinterpret_cast<BufferSink*>(userData);
+
+            if (self->length_ + 1 < self->size_)
+            {
+                const std::size_t n = std::min(length, self->size_ - 1 - self->length_);
+                std::memcpy(self->buffer_ + self->length_, text, n);
+            }
+
+            self->length_ += length;
+        }
+
+        // Appends the null terminator and returns the total length.
+        std::size_t Finish()
+        {
+            if (size_ > 0)
+                buffer_[std::min(length_, size_ - 1)] = '\0';
+            return length_;
+        }
+
+    private:
+
+        char*       buffer_;
+        std::size_t size_;
+        std::size_t length_;
+
+};
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,450 @@
+/*
+ * Formatter.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicator.h>
+#include <algorithm>
+#include <cstring>
+#include "FormatWriter.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Display name, unit, machine-readable key, number of decimal places (for fixed-point numbers), and counter flag of an information entry.
+struct EntryDescriptor
+{
+    const char*     name;
+    const char*     unit;
+    const char*     key;
+    unsigned int    decimals;
+    bool            counter;
+};
+
+static const EntryDescriptor g_entryDescriptors[] =
+{
+    { "OS Family",                      "",     "os_family",                            0, false }, // ENTRY_OS_FAMILY
+    { "Operating System",               "",     "os_name",                              0, false }, // ENTRY_OS_NAME
+    { "Compiler",                       "",     "compiler",                             0, false }, // ENTRY_COMPILER
+
+    { "CPU Name",                       "",     "cpu_name",                             0, false }, // ENTRY_CPU_NAME
+    { "CPU Vendor",                     "",     "cpu_vendor",                           0, false }, // ENTRY_CPU_VENDOR
+    { "CPU Type",                       "",     "cpu_type",                             0, false }, // ENTRY_CPU_TYPE
+    { "CPU Architecture",               "",     "cpu_arch",                             0, false }, // ENTRY_CPU_ARCH
+    { "CPU Extensions",                 "",     "cpu_extensions",                       0, false }, // ENTRY_CPU_EXT
+
+    { "Processors",                     "",     "processors",                           0, false }, // ENTRY_PROCESSORS
+    { "Logical Processors",             "",     "logical_processors",                   0, false }, // ENTRY_LOGICAL_PROCESSORS
+    { "Processor Speed",                "MHz",  "processor_speed_mhz",                  0, false }, // ENTRY_PROCESSOR_SPEED
+    { "Effective Processors",           "",     "effective_processors",                 0, false }, // ENTRY_EFFECTIVE_PROCESSORS
+
+    { "L1 Caches",                      "",     "l1_caches",                            0, false }, // ENTRY_L1CACHES
+    { "L1 Cache Size",                  "KB",   "l1_cache_size_kb",                     0, false }, // ENTRY_L1CACHE_SIZE
+    { "L1 Cache Line Size",             "B",    "l1_cache_line_size_bytes",             0, false }, // ENTRY_L1CACHE_LINE_SIZE
+
+    { "L2 Caches",                      "",     "l2_caches",                            0, false }, // ENTRY_L2CACHES
+    { "L2 Cache Size",                  "KB",   "l2_cache_size_kb",                     0, false }, // ENTRY_L2CACHE_SIZE
+    { "L2 Cache Line Size",             "B",    "l2_cache_line_size_bytes",             0, false }, // ENTRY_L2CACHE_LINE_SIZE
+
+    { "L3 Caches",                      "",     "l3_caches",                            0, false }, // ENTRY_L3CACHES
+    { "L3 Cache Size",                  "KB",   "l3_cache_size_kb",                     0, false }, // ENTRY_L3CACHE_SIZE
+    { "L3 Cache Line Size",             "B",    "l3_cache_line_size_bytes",             0, false }, // ENTRY_L3CACHE_LINE_SIZE
+
+    { "Total Memory",                   "MB",   "total_memory_mb",                      0, false }, // ENTRY_TOTAL_MEMORY
+    { "Effective Memory",               "MB",   "effective_memory_mb",                  0, false }, // ENTRY_EFFECTIVE_MEMORY
+    { "Free Memory",                    "MB",   "free_memory_mb",                       0, false }, // ENTRY_FREE_MEMORY
+    { "Available Memory",               "MB",   "available_memory_mb",                  0, false }, // ENTRY_AVAILABLE_MEMORY
+    { "Cached Memory",                  "MB",   "cached_memory_mb",                     0, false }, // ENTRY_CACHED_MEMORY
+    { "Buffered Memory",                "MB",   "buffered_memory_mb",                   0, false }, // ENTRY_BUFFERED_MEMORY
+    { "Dirty Memory",                   "MB",   "dirty_memory_mb",                      0, false }, // ENTRY_DIRTY_MEMORY
+    { "Committed Memory",               "MB",   "committed_memory_mb",                  0, false }, // ENTRY_COMMITTED_MEMORY
+    { "Total Swap",                     "MB",   "total_swap_mb",                        0, false }, // ENTRY_TOTAL_SWAP
+    { "Free Swap",                      "MB",   "free_swap_mb",                         0, false }, // ENTRY_FREE_SWAP
+
+    { "Huge Page Size",                 "KB",   "huge_page_size_kb",                    0, false }, // ENTRY_HUGE_PAGE_SIZE
+    { "Huge Pages",                     "",     "huge_pages",                           0, false }, // ENTRY_HUGE_PAGES
+    { "Free Huge Pages",                "",     "free_huge_pages",                      0, false }, // ENTRY_FREE_HUGE_PAGES
+    { "Reserved Huge Pages",            "",     "reserved_huge_pages",                  0, false }, // ENTRY_RESERVED_HUGE_PAGES
+    { "Anonymous Huge Page Memory",     "MB",   "anon_huge_page_memory_mb",             0, false }, // ENTRY_ANON_HUGE_PAGE_MEMORY
+    { "Transparent Huge Pages",         "",     "transparent_huge_pages",               0, false }, // ENTRY_TRANSPARENT_HUGE_PAGES
+    { "THP Defrag",                     "",     "transparent_huge_page_defrag",         0, false }, // ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG
+    { "Free Huge Page Blocks",          "",     "free_huge_page_blocks",                0, false }, // ENTRY_FREE_HUGE_PAGE_BLOCKS
+
+    { "Disk Reads",                     "",     "disk_reads",                           0, true  }, // ENTRY_DISK_READS
+    { "Disk Writes",                    "",     "disk_writes",                          0, true  }, // ENTRY_DISK_WRITES
+    { "Disk Bytes Read",                "MB",   "disk_read_mb",                         0, true  }, // ENTRY_DISK_BYTES_READ
+    { "Disk Bytes Written",             "MB",   "disk_written_mb",                      0, true  }, // ENTRY_DISK_BYTES_WRITTEN
+    { "Disk Requests In Flight",        "",     "disk_requests_in_flight",              0, false }, // ENTRY_DISK_IN_FLIGHT
+    { "Disk I/O Time",                  "ms",   "disk_io_time_ms",                      0, true  }, // ENTRY_DISK_IO_TIME
+    { "Disk Weighted I/O Time",         "ms",   "disk_weighted_io_time_ms",             0, true  }, // ENTRY_DISK_WEIGHTED_IO_TIME
+
+    { "Root Disk",                      "",     "root_disk",                            0, false }, // ENTRY_ROOT_DISK
+    { "Root Disk Rotational",           "",     "root_disk_rotational",                 0, false }, // ENTRY_ROOT_DISK_ROTATIONAL
+    { "Root Disk Logical Block Size",   "B",    "root_disk_logical_block_size_bytes",   0, false }, // ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE
+    { "Root Disk Physical Block Size",  "B",    "root_disk_physical_block_size_bytes",  0, false }, // ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE
+    { "Root Disk Optimal I/O Size",     "B",    "root_disk_optimal_io_size_bytes",      0, false }, // ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE
+    { "Root Disk Max I/O Size",         "KB",   "root_disk_max_io_size_kb",             0, false }, // ENTRY_ROOT_DISK_MAX_IO_SIZE
+    { "Root Disk Read-Ahead",           "KB",   "root_disk_read_ahead_kb",              0, false }, // ENTRY_ROOT_DISK_READ_AHEAD
+    { "Root Disk Queue Requests",       "",     "root_disk_queue_requests",             0, false }, // ENTRY_ROOT_DISK_QUEUE_REQUESTS
+    { "Root Disk Scheduler",            "",     "root_disk_scheduler",                  0, false }, // ENTRY_ROOT_DISK_SCHEDULER
+
+    { "Network Bytes Received",         "MB",   "network_received_mb",                  0, true  }, // ENTRY_NETWORK_BYTES_RECEIVED
+    { "Network Bytes Sent",             "MB",   "network_sent_mb",                      0, true  }, // ENTRY_NETWORK_BYTES_SENT
+    { "Network Packets Received",       "",     "network_packets_received",             0, true  }, // ENTRY_NETWORK_PACKETS_RECEIVED
+    { "Network Packets Sent",           "",     "network_packets_sent",                 0, true  }, // ENTRY_NETWORK_PACKETS_SENT
+    { "Network Receive Errors",         "",     "network_receive_errors",               0, true  }, // ENTRY_NETWORK_RECEIVE_ERRORS
+    { "Network Send Errors",            "",     "network_send_errors",                  0, true  }, // ENTRY_NETWORK_SEND_ERRORS
+    { "Network Receive Drops",          "",     "network_receive_drops",                0, true  }, // ENTRY_NETWORK_RECEIVE_DROPS
+    { "Network Send Drops",             "",     "network_send_drops",                   0, true  }, // ENTRY_NETWORK_SEND_DROPS
+
+    { "TCP Segments Sent",              "",     "tcp_segments_sent",                    0, true  }, // ENTRY_TCP_SEGMENTS_SENT
+    { "TCP Retransmitted Segments",     "",     "tcp_retransmitted_segments",           0, true  }, // ENTRY_TCP_RETRANSMITTED_SEGMENTS
+    { "TCP Listen Overflows",           "",     "tcp_listen_overflows",                 0, true  }, // ENTRY_TCP_LISTEN_OVERFLOWS
+    { "TCP Listen Drops",               "",     "tcp_listen_drops",                     0, true  }, // ENTRY_TCP_LISTEN_DROPS
+    { "TCP Backlog Drops",              "",     "tcp_backlog_drops",                    0, true  }, // ENTRY_TCP_BACKLOG_DROPS
+    { "TCP Established",                "",     "tcp_established",                      0, false }, // ENTRY_TCP_ESTABLISHED
+    { "TCP Sockets",                    "",     "tcp_sockets",                          0, false }, // ENTRY_TCP_SOCKETS
+    { "TCP Time-Wait Sockets",          "",     "tcp_time_wait_sockets",                0, false }, // ENTRY_TCP_TIME_WAIT
+    { "TCP Memory",                     "KB",   "tcp_memory_kb",                        0, false }, // ENTRY_TCP_MEMORY
+    { "UDP Sockets",                    "",     "udp_sockets",                          0, false }, // ENTRY_UDP_SOCKETS
+    { "UDP Memory",                     "KB",   "udp_memory_kb",                        0, false }, // ENTRY_UDP_MEMORY
+    { "UDP Receive Buffer Errors",      "",     "udp_receive_buffer_errors",            0, true  }, // ENTRY_UDP_RECEIVE_BUFFER_ERRORS
+    { "Sockets",                        "",     "sockets",                              0, false }, // ENTRY_SOCKETS
+
+    { "Process Virtual Memory",         "MB",   "process_virtual_memory_mb",            0, false }, // ENTRY_PROCESS_VIRTUAL_MEMORY
+    { "Process Resident Memory",        "MB",   "process_resident_memory_mb",           0, false }, // ENTRY_PROCESS_RESIDENT_MEMORY
+    { "Process Peak Resident Memory",   "MB",   "process_peak_resident_memory_mb",      0, false }, // ENTRY_PROCESS_PEAK_RESIDENT_MEMORY
+    { "Process Swapped Memory",         "MB",   "process_swapped_memory_mb",            0, false }, // ENTRY_PROCESS_SWAPPED_MEMORY
+    { "Process Minor Faults",           "",     "process_minor_faults",                 0, true  }, // ENTRY_PROCESS_MINOR_FAULTS
+    { "Process Major Faults",           "",     "process_major_faults",                 0, true  }, // ENTRY_PROCESS_MAJOR_FAULTS
+    { "Process Voluntary Switches",     "",     "process_voluntary_context_switches",   0, true  }, // ENTRY_PROCESS_VOLUNTARY_SWITCHES
+    { "Process Involuntary Switches",   "",     "process_involuntary_context_switches", 0, true  }, // ENTRY_PROCESS_INVOLUNTARY_SWITCHES
+    { "Process User Time",              "ms",   "process_user_time_ms",                 0, true  }, // ENTRY_PROCESS_USER_TIME
+    { "Process System Time",            "ms",   "process_system_time_ms",               0, true  }, // ENTRY_PROCESS_SYSTEM_TIME
+    { "Process Threads",                "",     "process_threads",                      0, false }, // ENTRY_PROCESS_THREADS
+    { "Process Open Files",             "",     "process_open_files",                   0, false }, // ENTRY_PROCESS_OPEN_FILES
+
+    { "CPU Pressure (some, 10s)",       "%",    "cpu_pressure_some_avg10_percent",      2, false }, // ENTRY_CPU_PRESSURE_SOME_AVG10
+    { "CPU Pressure (some, 60s)",       "%",    "cpu_pressure_some_avg60_percent",      2, false }, // ENTRY_CPU_PRESSURE_SOME_AVG60
+    { "CPU Pressure (some, 300s)",      "%",    "cpu_pressure_some_avg300_percent",     2, false }, // ENTRY_CPU_PRESSURE_SOME_AVG300
+    { "CPU Pressure (some, total)",     "us",   "cpu_pressure_some_total_us",           0, true  }, // ENTRY_CPU_PRESSURE_SOME_TOTAL
+
+    { "Memory Pressure (some, 10s)",    "%",    "memory_pressure_some_avg10_percent",   2, false }, // ENTRY_MEMORY_PRESSURE_SOME_AVG10
+    { "Memory Pressure (some, 60s)",    "%",    "memory_pressure_some_avg60_percent",   2, false }, // ENTRY_MEMORY_PRESSURE_SOME_AVG60
+    { "Memory Pressure (some, 300s)",   "%",    "memory_pressure_some_avg300_percent",  2, false }, // ENTRY_MEMORY_PRESSURE_SOME_AVG300
+    { "Memory Pressure (some, total)",  "us",   "memory_pressure_some_total_us",        0, true  }, // ENTRY_MEMORY_PRESSURE_SOME_TOTAL
+
+    { "Memory Pressure (full, 10s)",    "%",    "memory_pressure_full_avg10_percent",   2, false }, // ENTRY_MEMORY_PRESSURE_FULL_AVG10
+    { "Memory Pressure (full, 60s)",    "%",    "memory_pressure_full_avg60_percent",   2, false }, // ENTRY_MEMORY_PRESSURE_FULL_AVG60
+    { "Memory Pressure (full, 300s)",   "%",    "memory_pressure_full_avg300_percent",  2, false }, // ENTRY_MEMORY_PRESSURE_FULL_AVG300
+    { "Memory Pressure (full, total)",  "us",   "memory_pressure_full_total_us",        0, true  }, // ENTRY_MEMORY_PRESSURE_FULL_TOTAL
+
+    { "I/O Pressure (some, 10s)",       "%",    "io_pressure_some_avg10_percent",       2, false }, // ENTRY_IO_PRESSURE_SOME_AVG10
+    { "I/O Pressure (some, 60s)",       "%",    "io_pressure_some_avg60_percent",       2, false }, // ENTRY_IO_PRESSURE_SOME_AVG60
+    { "I/O Pressure (some, 300s)",      "%",    "io_pressure_some_avg300_percent",      2, false }, // ENTRY_IO_PRESSURE_SOME_AVG300
+    { "I/O Pressure (some, total)",     "us",   "io_pressure_some_total_us",            0, true  }, // ENTRY_IO_PRESSURE_SOME_TOTAL
+
+    { "I/O Pressure (full, 10s)",       "%",    "io_pressure_full_avg10_percent",       2, false }, // ENTRY_IO_PRESSURE_FULL_AVG10
+    { "I/O Pressure (full, 60s)",       "%",    "io_pressure_full_avg60_percent",       2, false }, // ENTRY_IO_PRESSURE_FULL_AVG60
+    { "I/O Pressure (full, 300s)",      "%",    "io_pressure_full_avg300_percent",      2, false }, // ENTRY_IO_PRESSURE_FULL_AVG300
+    { "I/O Pressure (full, total)",     "us",   "io_pressure_full_total_us",            0, true  }, // ENTRY_IO_PRESSURE_FULL_TOTAL
+};
+
+static_assert(sizeof(g_entryDescriptors)/sizeof(g_entryDescriptors[0]) == ENTRY_COUNT, "descriptor table must have one descriptor for each information entry");
+
+// Row of the formatted output: a single entry, a cache entry ("2x 32 KB"), or a blank line between groups.
+struct FormatRow
+{
+    enum Type
+    {
+        ENTRY,
+        CACHE,
+        BLANK,
+    };
+
+    Type                type;
+    InformationEntry    entry;
+    InformationEntry    sizeEntry;  // Only used for cache rows.
+    const char*         label;      // Only used for cache rows; all other rows use the entry name.
+};
+
+static const FormatRow g_formatRows[] =
+{
+    { FormatRow::ENTRY, ENTRY_OS_NAME,                       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_COMPILER,                      ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_NAME,                      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_VENDOR,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_TYPE,                      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_ARCH,                      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_EXT,                       ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESSORS,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_LOGICAL_PROCESSORS,            ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESSOR_SPEED,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_EFFECTIVE_PROCESSORS,          ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::CACHE, ENTRY_L1CACHES,                      ENTRY_L1CACHE_SIZE, "L1 Cache" },
+    { FormatRow::CACHE, ENTRY_L2CACHES,                      ENTRY_L2CACHE_SIZE, "L2 Cache" },
+    { FormatRow::CACHE, ENTRY_L3CACHES,                      ENTRY_L3CACHE_SIZE, "L3 Cache" },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TOTAL_MEMORY,                  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_EFFECTIVE_MEMORY,              ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_FREE_MEMORY,                   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_AVAILABLE_MEMORY,              ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CACHED_MEMORY,                 ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_BUFFERED_MEMORY,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DIRTY_MEMORY,                  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_COMMITTED_MEMORY,              ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TOTAL_SWAP,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_FREE_SWAP,                     ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_HUGE_PAGE_SIZE,                ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_HUGE_PAGES,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_FREE_HUGE_PAGES,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_RESERVED_HUGE_PAGES,           ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ANON_HUGE_PAGE_MEMORY,         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TRANSPARENT_HUGE_PAGES,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG,  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_FREE_HUGE_PAGE_BLOCKS,         ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_READS,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_WRITES,                   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_BYTES_READ,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_BYTES_WRITTEN,            ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_IN_FLIGHT,                ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_IO_TIME,                  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_DISK_WEIGHTED_IO_TIME,         ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK,                     ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_ROTATIONAL,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE,  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE, ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE,     ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_MAX_IO_SIZE,         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_READ_AHEAD,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_QUEUE_REQUESTS,      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_ROOT_DISK_SCHEDULER,           ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_BYTES_RECEIVED,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_BYTES_SENT,            ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_PACKETS_RECEIVED,      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_PACKETS_SENT,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_RECEIVE_ERRORS,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_SEND_ERRORS,           ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_RECEIVE_DROPS,         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_NETWORK_SEND_DROPS,            ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_SEGMENTS_SENT,             ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_RETRANSMITTED_SEGMENTS,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_LISTEN_OVERFLOWS,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_LISTEN_DROPS,              ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_BACKLOG_DROPS,             ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_ESTABLISHED,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_SOCKETS,                   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_TIME_WAIT,                 ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_TCP_MEMORY,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_UDP_SOCKETS,                   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_UDP_MEMORY,                    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_UDP_RECEIVE_BUFFER_ERRORS,     ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_SOCKETS,                       ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_VIRTUAL_MEMORY,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_RESIDENT_MEMORY,       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_PEAK_RESIDENT_MEMORY,  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_SWAPPED_MEMORY,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_MINOR_FAULTS,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_MAJOR_FAULTS,          ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_VOLUNTARY_SWITCHES,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_INVOLUNTARY_SWITCHES,  ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_USER_TIME,             ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_SYSTEM_TIME,           ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_THREADS,               ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_PROCESS_OPEN_FILES,            ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_PRESSURE_SOME_AVG10,       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_PRESSURE_SOME_AVG60,       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_PRESSURE_SOME_AVG300,      ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_CPU_PRESSURE_SOME_TOTAL,       ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_SOME_AVG10,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_SOME_AVG60,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_SOME_AVG300,   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_SOME_TOTAL,    ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_FULL_AVG10,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_FULL_AVG60,    ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_FULL_AVG300,   ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_MEMORY_PRESSURE_FULL_TOTAL,    ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_SOME_AVG10,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_SOME_AVG60,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_SOME_AVG300,       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_SOME_TOTAL,        ENTRY_COUNT,        0          },
+    { FormatRow::BLANK, ENTRY_COUNT,                         ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_FULL_AVG10,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_FULL_AVG60,        ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_FULL_AVG300,       ENTRY_COUNT,        0          },
+    { FormatRow::ENTRY, ENTRY_IO_PRESSURE_FULL_TOTAL,        ENTRY_COUNT,        0          },
+};
+
+/*
+ * Internal functions
+ */
+
+static void WriteToStream(const char* text, std::size_t length, void* userData)
+{
+    reinterpret_cast<std::ostream*>(userData)->write(text, static_cast<std::streamsize>(length));
+}
+
+// Writes the value of the specified entry with its unit, e.g. "3500 MHz".
+static void WriteEntryValue(FormatWriter& writer, const InformationSnapshot& snapshot, const InformationEntry entry)
+{
+    if (snapshot.GetType(entry) == VALUE_NUMBER)
+        writer.WriteFixedPoint(snapshot.GetNumber(entry), g_entryDescriptors[entry].decimals);
+    else
+        writer.Write(snapshot.GetText(entry));
+}
+
+static const char* GetRowLabel(const FormatRow& row)
+{
+    return (row.label != 0 ? row.label : g_entryDescriptors[row.entry].name);
+}
+
+static bool IsRowAvailable(const FormatRow& row, const InformationSnapshot& snapshot)
+{
+    switch (row.type)
+    {
+        case FormatRow::ENTRY:  return snapshot.Has(row.entry);
+        case FormatRow::CACHE:  return (snapshot.Has(row.entry) && snapshot.Has(row.sizeEntry));
+        default:                return false;
+    }
+}
+
+
+/*
+ * Global functions
+ */
+
+const char* InformationEntryName(const InformationEntry entry)
+{
+    return (entry >= 0 && entry < ENTRY_COUNT ? g_entryDescriptors[entry].name : "");
+}
+
+const char* InformationEntryUnit(const InformationEntry entry)
+{
+    return (entry >= 0 && entry < ENTRY_COUNT ? g_entryDescriptors[entry].unit : "");
+}
+
+const char* InformationEntryKey(const InformationEntry entry)
+{
+    return (entry >= 0 && entry < ENTRY_COUNT ? g_entryDescriptors[entry].key : "");
+}
+
+unsigned int InformationEntryDecimals(const InformationEntry entry)
+{
+    return (entry >= 0 && entry < ENTRY_COUNT ? g_entryDescriptors[entry].decimals : 0);
+}
+
+bool InformationEntryIsCounter(const InformationEntry entry)
+{
+    return (entry >= 0 && entry < ENTRY_COUNT && g_entryDescriptors[entry].counter);
+}
+
+void FormatInformation(const InformationSnapshot& snapshot, FormatSink sink, void* userData)
+{
+    static const std::size_t numRows = sizeof(g_formatRows)/sizeof(g_formatRows[0]);
+
+    /* Get longest label of all available rows */
+    std::size_t maxLen = 0;
+
+    for (std::size_t i = 0; i < numRows; ++i)
+    {
+        if (g_formatRows[i].type != FormatRow::BLANK && snapshot.Has(g_formatRows[i].entry))
+            maxLen = std::max(maxLen, std::strlen(GetRowLabel(g_formatRows[i])));
+    }
+
+    /* Write rows; blank lines are only written between non-empty groups */
+    FormatWriter writer(sink, userData);
+    std::size_t groupSize = 0;
+
+    for (std::size_t i = 0; i < numRows; ++i)
+    {
+        const FormatRow& row = g_formatRows[i];
+
+        if (row.type == FormatRow::BLANK)
+        {
+            if (groupSize > 0)
+            {
+                writer.Write('\n');
+                groupSize = 0;
+            }
+            continue;
+        }
+
+        if (!IsRowAvailable(row, snapshot))
+            continue;
+
+        const char* label = GetRowLabel(row);
+        writer.Write(label);
+        writer.Write(':');
+        writer.WriteSpaces(maxLen + 1 - std::strlen(label));
+
+        WriteEntryValue(writer, snapshot, row.entry);
+
+        if (row.type == FormatRow::CACHE)
+        {
+            writer.Write("x ");
+            WriteEntryValue(writer, snapshot, row.sizeEntry);
+            writer.Write(" KB");
+        }
+        else if (g_entryDescriptors[row.entry].unit[0] != '\0')
+        {
+            writer.Write(' ');
+            writer.Write(g_entryDescriptors[row.entry].unit);
+        }
+
+        writer.Write('\n');
+        ++groupSize;
+    }
+}
+
+std::size_t FormatInformation(const InformationSnapshot& snapshot, char* buffer, std::size_t size)
+{
+    BufferSink bufferSink(buffer, size);
+    FormatInformation(snapshot, BufferSink::Write, &bufferSink);
+    return bufferSink.Finish();
+}
+
+std::ostream& operator << (std::ostream& stream, const InformationSnapshot& snapshot)
+{
+    FormatInformation(snapshot, WriteToStream, &stream);
+    return stream;
+}
+
+std::ostream& operator << (std::ostream& stream, const InformationEntryMap& entries)
+{
+    /* Copy the strings into a snapshot, so they are formatted without any further allocations */
+    InformationSnapshot snapshot;
+
+    for (InformationEntryMap::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        snapshot.SetText(it->first, it->second.c_str(), it->second.size());
+
+    return (stream << snapshot);
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
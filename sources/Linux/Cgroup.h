@@ -0,0 +1,34 @@
+/*
+ * Cgroup.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_CGROUP_H__
+#define __SI_CGROUP_H__
+
+
+#include <cstddef>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+Writes the directory of the cgroup v2 (unified hierarchy) of the current process into the specified buffer,
+e.g. "/sys/fs/cgroup/user.slice/user-1000.slice". The directory is not prefixed with the root of 'SetFileSystemRoot'.
+Returns false if the process is not in a cgroup v2 hierarchy.
+*/
+bool QueryUnifiedCgroupDir(char* buffer, std::size_t size);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,209 @@
+/*
+ * LinuxFrequency.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorFrequency.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "../ProcessorInfo.h"
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+/*
+Reads the list of online CPUs, e.g. "0-3,8-11", or writes the range of all online CPUs from 'sysconf' as fallback.
+Returns the length of the list. The list is walked with 'ReadCPURange' instead of parsing it into a 'CPUSet', which allocates.
+*/
+static std::size_t ReadOnlineCPUs(char* buffer, std::size_t size)
+{
+    const long len = ReadProcFile("/sys/devices/system/cpu/online", buffer, size);
+    if (len > 0)
+        return static_cast<std::size_t>(len);
+
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count <= 0)
+        return 0;
+
+    const int n = std::snprintf(buffer, size, "0-%ld", count - 1);
+
+    return (n > 0 ? std::min(static_cast<std::size_t>(n), size - 1) : 0);
+}
+
+// Reads the next range of a CPU list, e.g. "0-3" or "8" from "0-3,8". Returns false at the end of the list.
+static bool ReadCPURange(TextScanner& scanner, unsigned int& first, unsigned int& last)
+{
+    unsigned long long begin = 0, end = 0;
+    if (!scanner.ReadUInt(begin))
+        return false;
+
+    end = begin;
+    if (scanner.Accept('-') && !scanner.ReadUInt(end))
+        return false;
+
+    scanner.Accept(',');
+
+    first   = static_cast<unsigned int>(begin);
+    last    = static_cast<unsigned int>(end);
+
+    return (first <= last);
+}
+
+// Reads a frequency file (in kHz) of the specified CPU, e.g. "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq".
+static unsigned long long ReadCPUFreqFile(unsigned int cpu, const char* name)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/devices/system/cpu/cpu%u/cpufreq/%s", cpu, name);
+
+    unsigned long long value = 0;
+    return (ReadProcFileUInt(filename, value) ? value : 0);
+}
+
+// Reads the cpufreq state of the specified CPU. Returns false if the CPU has no cpufreq directory.
+static bool QueryCPUFreqState(CPUFrequency& frequency)
+{
+    const unsigned int cpu = frequency.cpu;
+
+    /* 'cpuinfo_cur_freq' is the frequency reported by the hardware, but it is only readable by root */
+    frequency.current = ReadCPUFreqFile(cpu, "scaling_cur_freq");
+    if (frequency.current == 0)
+        frequency.current = ReadCPUFreqFile(cpu, "cpuinfo_cur_freq");
+
+    frequency.minimum       = ReadCPUFreqFile(cpu, "scaling_min_freq");
+    frequency.maximum       = ReadCPUFreqFile(cpu, "scaling_max_freq");
+    frequency.hardwareMin   = ReadCPUFreqFile(cpu, "cpuinfo_min_freq");
+    frequency.hardwareMax   = ReadCPUFreqFile(cpu, "cpuinfo_max_freq");
+
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_governor", cpu);
+    if (ReadProcFileLine(filename, frequency.governor, sizeof(frequency.governor)) < 0)
+        frequency.governor[0] = '\0';
+
+    return (frequency.current > 0 || frequency.maximum > 0);
+}
+
+// Returns the index of the specified CPU in the frequency list, or -1 if it is not listed.
+static int FindCPUFrequency(const std::vector<CPUFrequency>& frequencies, unsigned int cpu)
+{
+    for (std::size_t i = 0; i < frequencies.size(); ++i)
+    {
+        if (frequencies[i].cpu == cpu)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// Reads the current frequencies from the "processor" and "cpu MHz" lines of "/proc/cpuinfo" (only available on x86).
+static bool QueryCPUInfoFrequencies(std::vector<CPUFrequency>& frequencies)
+{
+    /* Read line by line, since the file has about 4 KB per CPU; long lines (e.g. "flags") are truncated, which is fine here */
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+
+    if (!reader.Open("/proc/cpuinfo"))
+        return false;
+
+    const char* line = NULL;
+    std::size_t length = 0;
+    int index = -1;
+    bool found = false;
+
+    while (reader.NextLine(line, length))
+    {
+        TextScanner scanner(line, length);
+
+        const char* key = NULL;
+        std::size_t keyLen = scanner.ReadKey(key, ':');
+
+        /* Remove white spaces between key and delimiter, e.g. "cpu MHz\t\t: 2100.000" */
+        while (keyLen > 0 && (key[keyLen - 1] == ' ' || key[keyLen - 1] == '\t'))
+            --keyLen;
+
+        if (TokenEquals(key, keyLen, "processor"))
+        {
+            unsigned long long cpu = 0;
+            index = (scanner.ReadUInt(cpu) ? FindCPUFrequency(frequencies, static_cast<unsigned int>(cpu)) : -1);
+        }
+        else if (TokenEquals(key, keyLen, "cpu MHz") && index >= 0)
+        {
+            double mhz = 0.0;
+            if (scanner.ReadReal(mhz))
+            {
+                frequencies[index].current = static_cast<unsigned long long>(mhz * 1000.0 + 0.5);
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryCPUFrequencies(std::vector<CPUFrequency>& frequencies)
+{
+    char online[4096];
+    const std::size_t onlineLen = ReadOnlineCPUs(online, sizeof(online));
+
+    /* Count the online CPUs first, so the vector is only resized if the number of CPUs has changed */
+    unsigned int first = 0, last = 0;
+    std::size_t count = 0;
+
+    for (TextScanner scanner(online, onlineLen); ReadCPURange(scanner, first, last);)
+        count += last - first + 1;
+
+    frequencies.resize(count);
+
+    std::size_t i = 0;
+    bool cpufreq = false;
+
+    for (TextScanner scanner(online, onlineLen); ReadCPURange(scanner, first, last);)
+    {
+        for (unsigned int cpu = first; cpu <= last && i < count; ++cpu, ++i)
+        {
+            CPUFrequency& frequency = frequencies[i];
+            frequency = CPUFrequency();
+            frequency.cpu = cpu;
+            if (QueryCPUFreqState(frequency))
+                cpufreq = true;
+        }
+    }
+
+    /* Fall back to "/proc/cpuinfo" if cpufreq is not available, e.g. inside virtual machines */
+    if (!cpufreq)
+        return QueryCPUInfoFrequencies(frequencies);
+
+    return !frequencies.empty();
+}
+
+bool ReadRawMonotonicClock(unsigned long long& ns)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts) != 0)
+        return false;
+
+    ns = static_cast<unsigned long long>(ts.tv_sec) * 1000000000ull + static_cast<unsigned long long>(ts.tv_nsec);
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
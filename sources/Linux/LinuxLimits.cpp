@@ -0,0 +1,503 @@
+/*
+ * LinuxLimits.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorLimits.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorPlacement.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "Cgroup.h"
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Directory of a cgroup, split into the mount point of its hierarchy and the path within that hierarchy.
+struct CgroupDir
+{
+    CgroupDir() :
+        found ( false )
+    {
+        mount[0]    = '\0';
+        path[0]     = '\0';
+    }
+
+    bool found;
+    char mount[256];    // Mount point, e.g. "/sys/fs/cgroup/memory".
+    char path[256];     // Path within the hierarchy, e.g. "/kubepods/pod1234", or empty for the root cgroup.
+};
+
+// Paths of the cgroup v1 controllers and the cgroup v2 unified hierarchy of the current process.
+struct CgroupDirs
+{
+    CgroupDir unified;
+    CgroupDir cpu;
+    CgroupDir cpuset;
+    CgroupDir memory;
+};
+
+// cgroup v1 reports "unlimited" as the largest page-aligned 64-bit value.
+static const unsigned long long g_unlimitedBytes = (1ull << 62);
+
+
+/*
+ * Internal functions
+ */
+
+// Removes trailing path separators, so the root cgroup "/" has an empty path.
+static void TrimCgroupPath(char* path)
+{
+    std::size_t len = std::strlen(path);
+    while (len > 0 && path[len - 1] == '/')
+        path[--len] = '\0';
+}
+
+// Returns true if the comma separated list contains the specified name, e.g. "cpu" in "rw,cpu,cpuacct".
+static bool ListContains(const char* list, std::size_t length, const char* name)
+{
+    const char* end = list + length;
+    while (list < end)
+    {
+        const char* sep = list;
+        while (sep < end && *sep != ',')
+            ++sep;
+
+        if (TokenEquals(list, static_cast<std::size_t>(sep - list), name))
+            return true;
+
+        list = sep + 1;
+    }
+    return false;
+}
+
+// Parses "/proc/self/cgroup" with lines like "4:memory:/kubepods/pod1234" (v1) or "0::/user.slice" (v2).
+static void ParseProcCgroup(CgroupDirs& dirs)
+{
+    char buffer[4096];
+    const long len = ReadProcFile("/proc/self/cgroup", buffer, sizeof(buffer));
+    if (len <= 0)
+        return;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+
+    while (!scanner.AtEnd())
+    {
+        const char* id = 0;
+        const char* controllers = 0;
+        const char* path = 0;
+
+        const std::size_t idLen = scanner.ReadKey(id, ':');
+        const std::size_t controllersLen = (idLen > 0 ? scanner.ReadKey(controllers, ':') : 0);
+        const std::size_t pathLen = scanner.ReadToken(path);
+
+        if (idLen > 0 && pathLen > 0)
+        {
+            if (controllersLen == 0 && TokenEquals(id, idLen, "0"))
+            {
+                CopyToken(dirs.unified.path, sizeof(dirs.unified.path), path, pathLen);
+            }
+            else if (controllersLen > 0)
+            {
+                if (ListContains(controllers, controllersLen, "cpu"))
+                    CopyToken(dirs.cpu.path, sizeof(dirs.cpu.path), path, pathLen);
+                if (ListContains(controllers, controllersLen, "cpuset"))
+                    CopyToken(dirs.cpuset.path, sizeof(dirs.cpuset.path), path, pathLen);
+                if (ListContains(controllers, controllersLen, "memory"))
+                    CopyToken(dirs.memory.path, sizeof(dirs.memory.path), path, pathLen);
+            }
+        }
+
+        scanner.SkipLine();
+    }
+}
+
+/*
+Assigns the mount point to the specified cgroup and makes its path relative to the mount root.
+Inside a cgroup namespace, the mount root is usually the cgroup of the process itself.
+*/
+static void AssignCgroupMount(CgroupDir& dir, const char* root, std::size_t rootLen, const char* mountPoint, std::size_t mountPointLen)
+{
+    if (dir.found)
+        return;
+
+    CopyToken(dir.mount, sizeof(dir.mount), mountPoint, mountPointLen);
+    dir.found = true;
+
+    if (!TokenEquals(root, rootLen, "/"))
+    {
+        const std::size_t pathLen = std::strlen(dir.path);
+        if (pathLen >= rootLen && std::strncmp(dir.path, root, rootLen) == 0)
+            std::memmove(dir.path, dir.path + rootLen, pathLen - rootLen + 1);
+        else
+            dir.path[0] = '\0';
+    }
+
+    TrimCgroupPath(dir.path);
+}
+
+/*
+Parses "/proc/self/mountinfo" to find the mount points of all cgroup hierarchies.
+The file is read line by line, since it often exceeds a page in containers (e.g. overlay mounts with long "lowerdir=" options).
+Such lines may be truncated, but the cgroup mount lines are short.
+*/
+static void ParseMountInfo(CgroupDirs& dirs)
+{
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/self/mountinfo"))
+        return;
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+
+    while (reader.NextLine(line, lineLen))
+    {
+        TextScanner scanner(line, lineLen);
+
+        /* Read fields: ID, parent ID, major:minor, root, mount point, options, optional fields..., "-", type, source, super options */
+        const char* fields[5] = {};
+        std::size_t fieldLens[5] = {};
+
+        for (int i = 0; i < 5; ++i)
+            fieldLens[i] = scanner.ReadToken(fields[i]);
+
+        const char* token = 0;
+        std::size_t tokenLen = 0;
+
+        while ((tokenLen = scanner.ReadToken(token)) > 0 && !TokenEquals(token, tokenLen, "-"))
+            ;
+
+        const char* type = 0;
+        const char* source = 0;
+        const char* options = 0;
+
+        const std::size_t typeLen = scanner.ReadToken(type);
+        scanner.ReadToken(source);
+        const std::size_t optionsLen = scanner.ReadToken(options);
+
+        const char* root = fields[3];
+        const std::size_t rootLen = fieldLens[3];
+        const char* mountPoint = fields[4];
+        const std::size_t mountPointLen = fieldLens[4];
+
+        if (typeLen > 0 && rootLen > 0 && mountPointLen > 0)
+        {
+            if (TokenEquals(type, typeLen, "cgroup2"))
+            {
+                AssignCgroupMount(dirs.unified, root, rootLen, mountPoint, mountPointLen);
+            }
+            else if (TokenEquals(type, typeLen, "cgroup"))
+            {
+                if (ListContains(options, optionsLen, "cpu"))
+                    AssignCgroupMount(dirs.cpu, root, rootLen, mountPoint, mountPointLen);
+                if (ListContains(options, optionsLen, "cpuset"))
+                    AssignCgroupMount(dirs.cpuset, root, rootLen, mountPoint, mountPointLen);
+                if (ListContains(options, optionsLen, "memory"))
+                    AssignCgroupMount(dirs.memory, root, rootLen, mountPoint, mountPointLen);
+            }
+        }
+    }
+}
+
+// Reads the specified file of the cgroup at the specified path length, i.e. the cgroup itself or one of its parents.
+static long ReadCgroupFile(const CgroupDir& dir, std::size_t pathLen, const char* name, char* buffer, std::size_t size)
+{
+    if (!dir.found)
+        return -1;
+
+    char filename[640];
+    std::snprintf(filename, sizeof(filename), "%s%.*s/%s", dir.mount, static_cast<int>(pathLen), dir.path, name);
+
+    return ReadProcFileLine(filename, buffer, size);
+}
+
+// Returns the path length of the parent cgroup, e.g. "/a/b" -> "/a".
+static std::size_t ParentPathLength(const char* path, std::size_t pathLen)
+{
+    while (pathLen > 0 && path[--pathLen] != '/')
+        ;
+    return pathLen;
+}
+
+// Reads a memory limit (in bytes) from the cgroup and all of its parents and returns the minimum.
+static bool ReadHierarchicalMemoryLimit(const CgroupDir& dir, const char* name, unsigned long long& limit)
+{
+    bool found = false;
+    char text[64];
+
+    for (std::size_t pathLen = std::strlen(dir.path);; pathLen = ParentPathLength(dir.path, pathLen))
+    {
+        if (ReadCgroupFile(dir, pathLen, name, text, sizeof(text)) > 0)
+        {
+            found = true;
+
+            /* "max" means unlimited */
+            unsigned long long value = 0;
+            TextScanner scanner(text, std::strlen(text));
+            if (scanner.ReadUInt(value) && value < g_unlimitedBytes && (limit == 0 || value < limit))
+                limit = value;
+        }
+
+        if (pathLen == 0)
+            break;
+    }
+
+    return found;
+}
+
+// Reads the CPU quota from "cpu.max" (v2) of the cgroup and all of its parents and returns the minimum (in CPUs).
+static bool ReadHierarchicalCPUMax(const CgroupDir& dir, double& quota)
+{
+    bool found = false;
+    char text[64];
+
+    for (std::size_t pathLen = std::strlen(dir.path);; pathLen = ParentPathLength(dir.path, pathLen))
+    {
+        if (ReadCgroupFile(dir, pathLen, "cpu.max", text, sizeof(text)) > 0)
+        {
+            found = true;
+
+            /* Parse "<quota> <period>" or "max <period>" */
+            unsigned long long max = 0, period = 0;
+            TextScanner scanner(text, std::strlen(text));
+            if (scanner.ReadUInt(max) && scanner.ReadUInt(period) && period > 0)
+            {
+                const double cpus = static_cast<double>(max) / static_cast<double>(period);
+                if (quota == 0.0 || cpus < quota)
+                    quota = cpus;
+            }
+        }
+
+        if (pathLen == 0)
+            break;
+    }
+
+    return found;
+}
+
+// Reads the CPU quota from "cpu.cfs_quota_us" and "cpu.cfs_period_us" (v1) of the cgroup and all of its parents.
+static bool ReadHierarchicalCFSQuota(const CgroupDir& dir, double& quota)
+{
+    bool found = false;
+    char text[64];
+
+    for (std::size_t pathLen = std::strlen(dir.path);; pathLen = ParentPathLength(dir.path, pathLen))
+    {
+        long long max = -1;
+        unsigned long long period = 0;
+
+        if (ReadCgroupFile(dir, pathLen, "cpu.cfs_quota_us", text, sizeof(text)) > 0)
+        {
+            found = true;
+
+            TextScanner quotaScanner(text, std::strlen(text));
+            quotaScanner.ReadInt(max);
+
+            if (max > 0 && ReadCgroupFile(dir, pathLen, "cpu.cfs_period_us", text, sizeof(text)) > 0)
+            {
+                TextScanner periodScanner(text, std::strlen(text));
+                if (periodScanner.ReadUInt(period) && period > 0)
+                {
+                    const double cpus = static_cast<double>(max) / static_cast<double>(period);
+                    if (quota == 0.0 || cpus < quota)
+                        quota = cpus;
+                }
+            }
+        }
+
+        if (pathLen == 0)
+            break;
+    }
+
+    return found;
+}
+
+static bool ReadCgroupCPUSet(const CgroupDir& dir, const char* name, CPUSet& cpus)
+{
+    char text[4096];
+    const long len = ReadCgroupFile(dir, std::strlen(dir.path), name, text, sizeof(text));
+    return (len > 0 && cpus.Parse(text, static_cast<std::size_t>(len)));
+}
+
+// Parses "cpu.stat" with lines like "nr_throttled 12"; the throttled time is in microseconds (v2) or nanoseconds (v1).
+static bool ReadCgroupCPUStat(const CgroupDir& dir, ResourceLimits& limits)
+{
+    if (!dir.found)
+        return false;
+
+    char filename[640];
+    std::snprintf(filename, sizeof(filename), "%s%s/cpu.stat", dir.mount, dir.path);
+
+    char buffer[1024];
+    const long len = ReadProcFile(filename, buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+
+    while (!scanner.AtEnd())
+    {
+        const char* key = 0;
+        const std::size_t keyLen = scanner.ReadToken(key);
+        unsigned long long value = 0;
+
+        if (keyLen > 0 && scanner.ReadUInt(value))
+        {
+            if (TokenEquals(key, keyLen, "nr_periods"))
+                limits.periods = value;
+            else if (TokenEquals(key, keyLen, "nr_throttled"))
+                limits.throttledPeriods = value;
+            else if (TokenEquals(key, keyLen, "throttled_usec"))
+                limits.throttledTime = value;
+            else if (TokenEquals(key, keyLen, "throttled_time"))
+                limits.throttledTime = value / 1000;
+        }
+
+        scanner.SkipLine();
+    }
+
+    return true;
+}
+
+static unsigned int QueryHostCPUs()
+{
+    char text[4096];
+    const long len = ReadProcFile("/sys/devices/system/cpu/online", text, sizeof(text));
+
+    CPUSet online;
+    if (len > 0 && online.Parse(text, static_cast<std::size_t>(len)) && !online.Empty())
+        return static_cast<unsigned int>(online.Count());
+
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0 ? static_cast<unsigned int>(count) : 1);
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryResourceLimits(ResourceLimits& limits)
+{
+    limits = ResourceLimits();
+
+    /* Query host values */
+    limits.hostCPUs = QueryHostCPUs();
+
+    MemoryInfo memInfo;
+    if (QueryMemoryInfo(memInfo))
+        limits.hostMemory = memInfo.total;
+
+    /* Find cgroup directories of the current process */
+    CgroupDirs dirs;
+    ParseProcCgroup(dirs);
+    ParseMountInfo(dirs);
+
+    /* Read CPU limits (cgroup v2 first, then v1) */
+    if (ReadHierarchicalCPUMax(dirs.unified, limits.cpuQuota))
+    {
+        limits.cgroupVersion = 2;
+        ReadCgroupCPUStat(dirs.unified, limits);
+    }
+    else if (ReadHierarchicalCFSQuota(dirs.cpu, limits.cpuQuota))
+    {
+        limits.cgroupVersion = 1;
+        ReadCgroupCPUStat(dirs.cpu, limits);
+    }
+
+    CPUSet cgroupCPUs;
+    if (!ReadCgroupCPUSet(dirs.unified, "cpuset.cpus.effective", cgroupCPUs))
+    {
+        cgroupCPUs.Clear();
+        if (!ReadCgroupCPUSet(dirs.cpuset, "cpuset.effective_cpus", cgroupCPUs))
+        {
+            cgroupCPUs.Clear();
+            if (!ReadCgroupCPUSet(dirs.cpuset, "cpuset.cpus", cgroupCPUs))
+                cgroupCPUs.Clear();
+        }
+    }
+
+    /* Read memory limits (cgroup v2 first, then v1) */
+    unsigned long long memoryMax = 0, memoryHigh = 0;
+
+    if (ReadHierarchicalMemoryLimit(dirs.unified, "memory.max", memoryMax))
+    {
+        ReadHierarchicalMemoryLimit(dirs.unified, "memory.high", memoryHigh);
+        limits.cgroupVersion = 2;
+    }
+    else if (ReadHierarchicalMemoryLimit(dirs.memory, "memory.limit_in_bytes", memoryMax))
+    {
+        if (limits.cgroupVersion == 0)
+            limits.cgroupVersion = 1;
+    }
+
+    limits.memoryMax    = memoryMax / 1024;
+    limits.memoryHigh   = memoryHigh / 1024;
+
+    /*
+    Combine cpuset with the process affinity (e.g. from 'taskset'). The affinity of the calling thread is not used,
+    since the limits are cached in the hardware profile by whichever thread queries them first.
+    */
+    if (GetProcessAffinity(limits.cpus))
+    {
+        if (!cgroupCPUs.Empty())
+            limits.cpus &= cgroupCPUs;
+    }
+    else
+        limits.cpus = cgroupCPUs;
+
+    /* Determine effective limits */
+    limits.effectiveCPUs = limits.hostCPUs;
+
+    const unsigned int allowedCPUs = static_cast<unsigned int>(limits.cpus.Count());
+    if (allowedCPUs > 0 && allowedCPUs < limits.effectiveCPUs)
+        limits.effectiveCPUs = allowedCPUs;
+
+    if (limits.cpuQuota > 0.0)
+    {
+        const unsigned int quotaCPUs = static_cast<unsigned int>(std::ceil(limits.cpuQuota));
+        if (quotaCPUs < limits.effectiveCPUs)
+            limits.effectiveCPUs = (quotaCPUs > 0 ? quotaCPUs : 1);
+    }
+
+    limits.effectiveMemory = limits.hostMemory;
+
+    if (limits.memoryMax > 0 && (limits.effectiveMemory == 0 || limits.memoryMax < limits.effectiveMemory))
+        limits.effectiveMemory = limits.memoryMax;
+    if (limits.memoryHigh > 0 && (limits.effectiveMemory == 0 || limits.memoryHigh < limits.effectiveMemory))
+        limits.effectiveMemory = limits.memoryHigh;
+
+    return true;
+}
+
+bool QueryUnifiedCgroupDir(char* buffer, std::size_t size)
+{
+    CgroupDirs dirs;
+    ParseProcCgroup(dirs);
+    ParseMountInfo(dirs);
+
+    if (!dirs.unified.found)
+        return false;
+
+    const int len = std::snprintf(buffer, size, "%s%s", dirs.unified.mount, dirs.unified.path);
+    return (len > 0 && static_cast<std::size_t>(len) < size);
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,427 @@
+/*
+ * LinuxMemory.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorMemory.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+struct MemInfoField
+{
+    const char*                         key;
+    unsigned long long MemoryInfo::*    value;
+};
+
+static const MemInfoField g_memInfoFields[] =
+{
+    { "MemTotal",         &MemoryInfo::total              },
+    { "MemFree",          &MemoryInfo::free               },
+    { "MemAvailable",     &MemoryInfo::available          },
+    { "Buffers",          &MemoryInfo::buffers            },
+    { "Cached",           &MemoryInfo::cached             },
+    { "SwapTotal",        &MemoryInfo::swapTotal          },
+    { "SwapFree",         &MemoryInfo::swapFree           },
+    { "Dirty",            &MemoryInfo::dirty              },
+    { "CommitLimit",      &MemoryInfo::commitLimit        },
+    { "Committed_AS",     &MemoryInfo::committed          },
+    { "AnonHugePages",    &MemoryInfo::anonHugePages      },
+    { "HugePages_Total",  &MemoryInfo::hugePages          },
+    { "HugePages_Free",   &MemoryInfo::hugePagesFree      },
+    { "HugePages_Rsvd",   &MemoryInfo::hugePagesReserved  },
+    { "Hugepagesize",     &MemoryInfo::hugePageSize       },
+};
+
+static const std::size_t g_numMemInfoFields = sizeof(g_memInfoFields)/sizeof(g_memInfoFields[0]);
+
+// Parses the content of "/proc/meminfo" with lines like "MemTotal:       16303412 kB".
+static bool ParseMemInfo(const char* text, std::size_t length, MemoryInfo& info)
+{
+    TextScanner scanner(text, length);
+    std::size_t numFound = 0;
+
+    while (!scanner.AtEnd() && numFound < g_numMemInfoFields)
+    {
+        const char* key = 0;
+        std::size_t keyLen = scanner.ReadKey(key, ':');
+        unsigned long long value = 0;
+
+        if (keyLen > 0 && scanner.ReadUInt(value))
+        {
+            for (std::size_t i = 0; i < g_numMemInfoFields; ++i)
+            {
+                if (TokenEquals(key, keyLen, g_memInfoFields[i].key))
+                {
+                    info.*(g_memInfoFields[i].value) = value;
+                    ++numFound;
+                    break;
+                }
+            }
+        }
+
+        scanner.SkipLine();
+    }
+
+    return (info.total > 0);
+}
+
+// Fallback if "/proc/meminfo" is not accessible, e.g. in restricted sandboxes.
+static bool QuerySysInfo(MemoryInfo& info)
+{
+    struct sysinfo si;
+    if (sysinfo(&si) != 0)
+        return false;
+
+    const unsigned long long unit = (si.mem_unit > 0 ? si.mem_unit : 1);
+
+    info.total      = si.totalram  * unit / 1024;
+    info.free       = si.freeram   * unit / 1024;
+    info.available  = (si.freeram + si.bufferram) * unit / 1024;
+    info.buffers    = si.bufferram * unit / 1024;
+    info.swapTotal  = si.totalswap * unit / 1024;
+    info.swapFree   = si.freeswap  * unit / 1024;
+
+    return true;
+}
+
+bool QueryMemoryInfo(MemoryInfo& info)
+{
+    info = MemoryInfo();
+
+    /* Keep file open for subsequent samples; 'pread' on a shared descriptor is thread-safe */
+    static ProcFile file;
+    static const bool isOpen = file.Open("/proc/meminfo");
+
+    char buffer[8192];
+    const long length = (isOpen ? file.Read(buffer, sizeof(buffer)) : -1);
+
+    if (length > 0 && ParseMemInfo(buffer, static_cast<std::size_t>(length), info))
+        return true;
+
+    info = MemoryInfo();
+    return QuerySysInfo(info);
+}
+
+/*
+Returns the selected mode of a transparent huge page setting, e.g. "madvise" for "always [madvise] never".
+The returned token points into the specified buffer.
+*/
+static std::size_t ReadSelectedMode(const char* filename, char* buffer, std::size_t size, const char*& mode)
+{
+    const long len = ReadProcFileLine(filename, buffer, size);
+    if (len <= 0)
+        return 0;
+
+    const char* open = std::strchr(buffer, '[');
+    if (open == NULL)
+        return 0;
+
+    const char* close = std::strchr(open, ']');
+    if (close == NULL)
+        return 0;
+
+    mode = open + 1;
+    return static_cast<std::size_t>(close - mode);
+}
+
+static TransparentHugePageMode ReadTransparentHugePageMode()
+{
+    char buffer[128];
+    const char* mode = NULL;
+    const std::size_t len = ReadSelectedMode("/sys/kernel/mm/transparent_hugepage/enabled", buffer, sizeof(buffer), mode);
+
+    if (len == 0)
+        return THP_MODE_UNKNOWN;
+
+    if (TokenEquals(mode, len, "always"))
+        return THP_MODE_ALWAYS;
+    if (TokenEquals(mode, len, "madvise"))
+        return THP_MODE_MADVISE;
+    if (TokenEquals(mode, len, "never"))
+        return THP_MODE_NEVER;
+
+    return THP_MODE_UNKNOWN;
+}
+
+static TransparentHugePageDefrag ReadTransparentHugePageDefrag()
+{
+    char buffer[128];
+    const char* mode = NULL;
+    const std::size_t len = ReadSelectedMode("/sys/kernel/mm/transparent_hugepage/defrag", buffer, sizeof(buffer), mode);
+
+    if (len == 0)
+        return THP_DEFRAG_UNKNOWN;
+
+    if (TokenEquals(mode, len, "always"))
+        return THP_DEFRAG_ALWAYS;
+    if (TokenEquals(mode, len, "defer"))
+        return THP_DEFRAG_DEFER;
+    if (TokenEquals(mode, len, "defer+madvise"))
+        return THP_DEFRAG_DEFER_MADVISE;
+    if (TokenEquals(mode, len, "madvise"))
+        return THP_DEFRAG_MADVISE;
+    if (TokenEquals(mode, len, "never"))
+        return THP_DEFRAG_NEVER;
+
+    return THP_DEFRAG_UNKNOWN;
+}
+
+// Parses the page size of a huge page directory name, e.g. 2048 for "hugepages-2048kB".
+static bool ParseHugePageDirectory(const char* name, unsigned long long& pageSize)
+{
+    static const char prefix[] = "hugepages-";
+
+    if (std::strncmp(name, prefix, sizeof(prefix) - 1) != 0)
+        return false;
+
+    const char* s = name + sizeof(prefix) - 1;
+    TextScanner scanner(s, std::strlen(s));
+
+    return (scanner.ReadUInt(pageSize) && scanner.Accept("kB") && scanner.AtEnd() && pageSize > 0);
+}
+
+static unsigned long long ReadHugePageAttribute(const char* path, const char* attribute)
+{
+    char filename[512];
+    std::snprintf(filename, sizeof(filename), "%s/%s", path, attribute);
+
+    unsigned long long value = 0;
+    ReadProcFileUInt(filename, value);
+    return value;
+}
+
+// Appends the huge page pools of the specified directory, e.g. "/sys/kernel/mm/hugepages".
+static void ReadHugePagePools(const char* path, int node, std::vector<HugePagePool>& pools)
+{
+    ProcDirectory dir;
+    if (!dir.Open(path))
+        return;
+
+    while (const char* entry = dir.Next())
+    {
+        HugePagePool pool;
+        if (!ParseHugePageDirectory(entry, pool.pageSize))
+            continue;
+
+        char poolPath[256];
+        std::snprintf(poolPath, sizeof(poolPath), "%s/%s", path, entry);
+
+        pool.node       = node;
+        pool.total      = ReadHugePageAttribute(poolPath, "nr_hugepages");
+        pool.free       = ReadHugePageAttribute(poolPath, "free_hugepages");
+        pool.surplus    = ReadHugePageAttribute(poolPath, "surplus_hugepages");
+
+        if (node < 0)
+        {
+            pool.reserved   = ReadHugePageAttribute(poolPath, "resv_hugepages");
+            pool.overcommit = ReadHugePageAttribute(poolPath, "nr_overcommit_hugepages");
+        }
+
+        pools.push_back(pool);
+    }
+}
+
+static bool CompareHugePagePool(const HugePagePool& lhs, const HugePagePool& rhs)
+{
+    if (lhs.node != rhs.node)
+        return (lhs.node < rhs.node);
+    return (lhs.pageSize < rhs.pageSize);
+}
+
+// Parses the node ID of a NUMA node directory name, e.g. 1 for "node1".
+static bool ParseNodeDirectory(const char* name, int& node)
+{
+    if (std::strncmp(name, "node", 4) != 0)
+        return false;
+
+    TextScanner scanner(name + 4, std::strlen(name + 4));
+
+    unsigned long long id = 0;
+    if (!scanner.ReadUInt(id) || !scanner.AtEnd())
+        return false;
+
+    node = static_cast<int>(id);
+    return true;
+}
+
+// Parses a line of "/proc/buddyinfo", e.g. "Node 0, zone   Normal   9300   5847   3882 ...".
+static bool ParseBuddyInfoLine(const char* line, std::size_t length, MemoryZoneFreeBlocks& zone)
+{
+    TextScanner scanner(line, length);
+
+    unsigned long long node = 0;
+    if (!scanner.Accept("Node") || !scanner.ReadUInt(node) || !scanner.Accept(','))
+        return false;
+
+    scanner.SkipSpaces();
+    if (!scanner.Accept("zone"))
+        return false;
+
+    const char* name = NULL;
+    const std::size_t nameLen = scanner.ReadToken(name);
+    if (nameLen == 0)
+        return false;
+
+    zone.node = static_cast<int>(node);
+
+    const std::size_t copyLen = std::min(nameLen, sizeof(zone.zone) - 1);
+    std::memcpy(zone.zone, name, copyLen);
+    zone.zone[copyLen] = '\0';
+
+    zone.orders = 0;
+    while (zone.orders < MemoryZoneFreeBlocks::maxOrders && scanner.ReadUInt(zone.blocks[zone.orders]))
+        ++zone.orders;
+
+    return (zone.orders > 0);
+}
+
+bool QueryTransparentHugePages(TransparentHugePageInfo& info)
+{
+    info = TransparentHugePageInfo();
+
+    info.mode   = ReadTransparentHugePageMode();
+    info.defrag = ReadTransparentHugePageDefrag();
+
+    unsigned long long pageSize = 0;
+    if (ReadProcFileUInt("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", pageSize))
+        info.pageSize = pageSize / 1024;
+
+    /* Read the usage from "/proc/meminfo", which also contains the shared memory and page cache lines that 'MemoryInfo' does not cover */
+    char buffer[8192];
+    const long length = ReadProcFile("/proc/meminfo", buffer, sizeof(buffer));
+
+    if (length > 0)
+    {
+        TextScanner scanner(buffer, static_cast<std::size_t>(length));
+
+        while (!scanner.AtEnd())
+        {
+            const char* key = NULL;
+            const std::size_t keyLen = scanner.ReadKey(key, ':');
+
+            unsigned long long value = 0;
+            if (keyLen > 0 && scanner.ReadUInt(value))
+            {
+                if (TokenEquals(key, keyLen, "AnonHugePages"))
+                    info.anonHugePages = value;
+                else if (TokenEquals(key, keyLen, "ShmemHugePages"))
+                    info.shmemHugePages = value;
+                else if (TokenEquals(key, keyLen, "FileHugePages"))
+                    info.fileHugePages = value;
+            }
+
+            scanner.SkipLine();
+        }
+    }
+
+    return (info.mode != THP_MODE_UNKNOWN || length > 0);
+}
+
+bool QueryHugePageInfo(HugePageInfo& info)
+{
+    info = HugePageInfo();
+
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0)
+        return false;
+
+    info.basePageSize = static_cast<unsigned long long>(pageSize) / 1024;
+
+    MemoryInfo memory;
+    if (QueryMemoryInfo(memory))
+        info.defaultHugePageSize = memory.hugePageSize;
+
+    /* Enumerate system-wide pools */
+    ReadHugePagePools("/sys/kernel/mm/hugepages", -1, info.pools);
+    std::sort(info.pools.begin(), info.pools.end(), CompareHugePagePool);
+
+    /* Enumerate pools of each NUMA node */
+    ProcDirectory nodeDir;
+    if (nodeDir.Open("/sys/devices/system/node"))
+    {
+        while (const char* entry = nodeDir.Next())
+        {
+            int node = 0;
+            if (!ParseNodeDirectory(entry, node))
+                continue;
+
+            char path[256];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/node/%s/hugepages", entry);
+            ReadHugePagePools(path, node, info.nodePools);
+        }
+        std::sort(info.nodePools.begin(), info.nodePools.end(), CompareHugePagePool);
+    }
+
+    QueryTransparentHugePages(info.transparent);
+
+    return true;
+}
+
+bool QueryMemoryFragmentation(MemoryFragmentation& fragmentation)
+{
+    fragmentation.zones.clear();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+
+    if (!reader.Open("/proc/buddyinfo"))
+        return false;
+
+    const char* line = NULL;
+    std::size_t length = 0;
+
+    while (reader.NextLine(line, length))
+    {
+        MemoryZoneFreeBlocks zone;
+        if (ParseBuddyInfoLine(line, length, zone))
+            fragmentation.zones.push_back(zone);
+    }
+
+    return !fragmentation.zones.empty();
+}
+
+bool QueryAvailableMemoryBlocks(unsigned int order, unsigned long long& blocks)
+{
+    blocks = 0;
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+
+    if (!reader.Open("/proc/buddyinfo"))
+        return false;
+
+    const char* line = NULL;
+    std::size_t length = 0;
+    bool found = false;
+
+    while (reader.NextLine(line, length))
+    {
+        MemoryZoneFreeBlocks zone;
+        if (ParseBuddyInfoLine(line, length, zone))
+        {
+            if (!zone.IsDMAZone())
+                blocks += zone.GetAvailableBlocks(order);
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
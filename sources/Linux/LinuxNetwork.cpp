@@ -0,0 +1,678 @@
+/*
+ * LinuxNetwork.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorNetwork.h>
+#include <net/if.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Compares the specified interface name (not null-terminated) with the specified null-terminated name like 'strcmp'.
+static int CompareInterfaceName(const char* name, std::size_t length, const char* s)
+{
+    const int result = std::strncmp(name, s, length);
+    if (result != 0)
+        return result;
+    return (s[length] == '\0' ? 0 : -1);
+}
+
+// Orders network interfaces by their name.
+static bool CompareInterface(const NetworkInterface& lhs, const NetworkInterface& rhs)
+{
+    return (std::strcmp(lhs.name, rhs.name) < 0);
+}
+
+/*
+The loopback interface of each network namespace is always created as "lo".
+Checking its name avoids reading "/sys/class/net/<name>/flags" for every line of "/proc/net/dev".
+*/
+static bool IsLoopbackInterface(const char* name, std::size_t length)
+{
+    return TokenEquals(name, length, "lo");
+}
+
+/*
+Parses a line of "/proc/net/dev", e.g. "  eth0: 2992 46 0 0 0 0 0 0 2652 44 0 0 0 0 0 0".
+The interface name may be followed directly by the first counter without a space.
+*/
+static bool ParseNetDevLine(TextScanner& scanner, const char*& name, std::size_t& nameLen, NetworkCounters& counters)
+{
+    nameLen = scanner.ReadKey(name, ':');
+    if (nameLen == 0)
+        return false;
+
+    unsigned long long* const fields[] =
+    {
+        &counters.rxBytes, &counters.rxPackets, &counters.rxErrors, &counters.rxDropped,
+        &counters.rxFIFOErrors, &counters.rxFrameErrors, &counters.rxCompressed, &counters.rxMulticast,
+        &counters.txBytes, &counters.txPackets, &counters.txErrors, &counters.txDropped,
+        &counters.txFIFOErrors, &counters.txCollisions, &counters.txCarrierErrors, &counters.txCompressed,
+    };
+
+    for (std::size_t i = 0; i < sizeof(fields)/sizeof(fields[0]); ++i)
+    {
+        if (!scanner.ReadUInt(*fields[i]))
+            return false;
+    }
+
+    return true;
+}
+
+// Skips the two header lines of "/proc/net/dev".
+static void SkipNetDevHeader(TextScanner& scanner)
+{
+    scanner.SkipLine();
+    scanner.SkipLine();
+}
+
+static bool ReadInterfaceAttribute(const char* name, const char* attribute, long long& value)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/class/net/%s/%s", name, attribute);
+    return ReadProcFileInt(filename, value);
+}
+
+// Counts the receive and transmit queues in "/sys/class/net/<name>/queues", e.g. "rx-0" and "tx-0".
+static void CountInterfaceQueues(const char* name, unsigned int& rxQueues, unsigned int& txQueues)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/class/net/%s/queues", name);
+
+    ProcDirectory dir;
+    if (!dir.Open(filename))
+        return;
+
+    while (const char* entry = dir.Next())
+    {
+        if (std::strncmp(entry, "rx-", 3) == 0)
+            ++rxQueues;
+        else if (std::strncmp(entry, "tx-", 3) == 0)
+            ++txQueues;
+    }
+}
+
+static void UpdateActivity(const NetworkCounters& prev, const NetworkCounters& curr, double seconds, NetworkActivity& activity)
+{
+    activity.rxThroughput   = CounterDelta(curr.rxBytes,    prev.rxBytes    ) / seconds;
+    activity.txThroughput   = CounterDelta(curr.txBytes,    prev.txBytes    ) / seconds;
+    activity.rxPacketRate   = CounterDelta(curr.rxPackets,  prev.rxPackets  ) / seconds;
+    activity.txPacketRate   = CounterDelta(curr.txPackets,  prev.txPackets  ) / seconds;
+    activity.rxDropRate     = CounterDelta(curr.rxDropped,  prev.rxDropped  ) / seconds;
+    activity.txDropRate     = CounterDelta(curr.txDropped,  prev.txDropped  ) / seconds;
+    activity.rxErrorRate    = CounterDelta(curr.rxErrors,   prev.rxErrors   ) / seconds;
+    activity.txErrorRate    = CounterDelta(curr.txErrors,   prev.txErrors   ) / seconds;
+}
+
+// Named counter of "/proc/net/snmp", "/proc/net/netstat", or "/proc/net/sockstat".
+struct CounterField
+{
+    const char*         name;
+    unsigned long long* value;
+};
+
+static void SetCounterField(const CounterField* fields, std::size_t count, const char* key, std::size_t keyLen, unsigned long long value)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (TokenEquals(key, keyLen, fields[i].name))
+        {
+            *fields[i].value = value;
+            return;
+        }
+    }
+}
+
+/*
+Parses a table of "/proc/net/snmp" or "/proc/net/netstat", which consists of a line with the counter names
+and a line with the values, both starting with the same prefix, e.g. "Tcp: RtoAlgorithm RtoMin ..." and "Tcp: 1 200 ...".
+*/
+static bool ParseSNMPTable(const char* text, std::size_t length, const char* prefix, const CounterField* fields, std::size_t count)
+{
+    TextScanner scanner(text, length);
+
+    while (!scanner.AtEnd())
+    {
+        if (scanner.Accept(prefix))
+        {
+            TextScanner names = scanner;
+            scanner.SkipLine();
+
+            if (scanner.Accept(prefix))
+            {
+                for (;;)
+                {
+                    const char* key = 0;
+                    const std::size_t keyLen = names.ReadToken(key);
+                    if (keyLen == 0)
+                        break;
+
+                    /* Some values are signed, e.g. "MaxConn" is -1 */
+                    long long value = 0;
+                    if (!scanner.ReadInt(value))
+                        break;
+
+                    SetCounterField(fields, count, key, keyLen, (value > 0 ? static_cast<unsigned long long>(value) : 0));
+                }
+                return true;
+            }
+            continue;
+        }
+        scanner.SkipLine();
+    }
+
+    return false;
+}
+
+// Parses a line of "/proc/net/sockstat" with name/value pairs, e.g. "TCP: inuse 4 orphan 0 tw 0 alloc 4 mem 0".
+static bool ParseSockStatLine(const char* text, std::size_t length, const char* prefix, const CounterField* fields, std::size_t count)
+{
+    TextScanner scanner(text, length);
+
+    while (!scanner.AtEnd())
+    {
+        if (scanner.Accept(prefix))
+        {
+            for (;;)
+            {
+                const char* key = 0;
+                const std::size_t keyLen = scanner.ReadToken(key);
+                if (keyLen == 0)
+                    break;
+
+                unsigned long long value = 0;
+                if (!scanner.ReadUInt(value))
+                    break;
+
+                SetCounterField(fields, count, key, keyLen, value);
+            }
+            return true;
+        }
+        scanner.SkipLine();
+    }
+
+    return false;
+}
+
+static bool ParseSNMP(const char* text, std::size_t length, NetworkStackCounters& counters)
+{
+    const CounterField tcpFields[] =
+    {
+        { "ActiveOpens",    &counters.tcp.activeOpens           },
+        { "PassiveOpens",   &counters.tcp.passiveOpens          },
+        { "AttemptFails",   &counters.tcp.attemptFails          },
+        { "EstabResets",    &counters.tcp.establishedResets     },
+        { "CurrEstab",      &counters.tcp.currentEstablished    },
+        { "InSegs",         &counters.tcp.inSegments            },
+        { "OutSegs",        &counters.tcp.outSegments           },
+        { "RetransSegs",    &counters.tcp.retransmittedSegments },
+        { "InErrs",         &counters.tcp.inErrors              },
+        { "OutRsts",        &counters.tcp.outResets             },
+    };
+
+    const CounterField udpFields[] =
+    {
+        { "InDatagrams",    &counters.udp.inDatagrams           },
+        { "OutDatagrams",   &counters.udp.outDatagrams          },
+        { "NoPorts",        &counters.udp.noPorts               },
+        { "InErrors",       &counters.udp.inErrors              },
+        { "RcvbufErrors",   &counters.udp.receiveBufferErrors   },
+        { "SndbufErrors",   &counters.udp.sendBufferErrors      },
+    };
+
+    const bool tcp = ParseSNMPTable(text, length, "Tcp:", tcpFields, sizeof(tcpFields)/sizeof(tcpFields[0]));
+    const bool udp = ParseSNMPTable(text, length, "Udp:", udpFields, sizeof(udpFields)/sizeof(udpFields[0]));
+
+    return (tcp || udp);
+}
+
+static bool ParseNetstat(const char* text, std::size_t length, NetworkStackCounters& counters)
+{
+    const CounterField fields[] =
+    {
+        { "ListenOverflows",    &counters.tcp.listenOverflows   },
+        { "ListenDrops",        &counters.tcp.listenDrops       },
+        { "TCPBacklogDrop",     &counters.tcp.backlogDrops      },
+        { "TCPSynRetrans",      &counters.tcp.synRetransmits    },
+        { "TCPTimeouts",        &counters.tcp.timeouts          },
+        { "TCPAbortOnMemory",   &counters.tcp.abortsOnMemory    },
+        { "PruneCalled",        &counters.tcp.pruneCalls        },
+    };
+
+    return ParseSNMPTable(text, length, "TcpExt:", fields, sizeof(fields)/sizeof(fields[0]));
+}
+
+static bool ParseSockStat(const char* text, std::size_t length, NetworkStackCounters& counters)
+{
+    const CounterField socketFields[] =
+    {
+        { "used",   &counters.sockets.sockets       },
+    };
+
+    const CounterField tcpFields[] =
+    {
+        { "inuse",  &counters.sockets.tcpInUse      },
+        { "orphan", &counters.sockets.tcpOrphans    },
+        { "tw",     &counters.sockets.tcpTimeWait   },
+        { "alloc",  &counters.sockets.tcpAllocated  },
+        { "mem",    &counters.sockets.tcpMemory     },
+    };
+
+    const CounterField udpFields[] =
+    {
+        { "inuse",  &counters.sockets.udpInUse      },
+        { "mem",    &counters.sockets.udpMemory     },
+    };
+
+    const bool sockets  = ParseSockStatLine(text, length, "sockets:", socketFields, sizeof(socketFields)/sizeof(socketFields[0]));
+    const bool tcp      = ParseSockStatLine(text, length, "TCP:", tcpFields, sizeof(tcpFields)/sizeof(tcpFields[0]));
+    const bool udp      = ParseSockStatLine(text, length, "UDP:", udpFields, sizeof(udpFields)/sizeof(udpFields[0]));
+
+    return (sockets || tcp || udp);
+}
+
+// Files of the network stack counters and their parsers, in the order of 'NetworkStackSampler::fds_'.
+static const char* const g_networkStackFiles[] = { "/proc/net/snmp", "/proc/net/netstat", "/proc/net/sockstat" };
+
+static bool ParseNetworkStackFile(std::size_t index, const char* text, std::size_t length, NetworkStackCounters& counters)
+{
+    switch (index)
+    {
+        case 0: return ParseSNMP(text, length, counters);
+        case 1: return ParseNetstat(text, length, counters);
+        case 2: return ParseSockStat(text, length, counters);
+    }
+    return false;
+}
+
+// Returns the difference of two cumulative counters as integer, or 0 if the counter was reset.
+static unsigned long long CounterDifference(unsigned long long current, unsigned long long previous)
+{
+    return (current >= previous ? current - previous : 0);
+}
+
+static void ComputeNetworkStackDelta(const NetworkStackCounters& prev, const NetworkStackCounters& curr, NetworkStackCounters& delta)
+{
+    delta.tcp.activeOpens           = CounterDifference(curr.tcp.activeOpens,           prev.tcp.activeOpens            );
+    delta.tcp.passiveOpens          = CounterDifference(curr.tcp.passiveOpens,          prev.tcp.passiveOpens           );
+    delta.tcp.attemptFails          = CounterDifference(curr.tcp.attemptFails,          prev.tcp.attemptFails           );
+    delta.tcp.establishedResets     = CounterDifference(curr.tcp.establishedResets,     prev.tcp.establishedResets      );
+    delta.tcp.currentEstablished    = curr.tcp.currentEstablished;
+    delta.tcp.inSegments            = CounterDifference(curr.tcp.inSegments,            prev.tcp.inSegments             );
+    delta.tcp.outSegments           = CounterDifference(curr.tcp.outSegments,           prev.tcp.outSegments            );
+    delta.tcp.retransmittedSegments = CounterDifference(curr.tcp.retransmittedSegments, prev.tcp.retransmittedSegments  );
+    delta.tcp.inErrors              = CounterDifference(curr.tcp.inErrors,              prev.tcp.inErrors               );
+    delta.tcp.outResets             = CounterDifference(curr.tcp.outResets,             prev.tcp.outResets              );
+    delta.tcp.listenOverflows       = CounterDifference(curr.tcp.listenOverflows,       prev.tcp.listenOverflows        );
+    delta.tcp.listenDrops           = CounterDifference(curr.tcp.listenDrops,           prev.tcp.listenDrops            );
+    delta.tcp.backlogDrops          = CounterDifference(curr.tcp.backlogDrops,          prev.tcp.backlogDrops           );
+    delta.tcp.synRetransmits        = CounterDifference(curr.tcp.synRetransmits,        prev.tcp.synRetransmits         );
+    delta.tcp.timeouts              = CounterDifference(curr.tcp.timeouts,              prev.tcp.timeouts               );
+    delta.tcp.abortsOnMemory        = CounterDifference(curr.tcp.abortsOnMemory,        prev.tcp.abortsOnMemory         );
+    delta.tcp.pruneCalls            = CounterDifference(curr.tcp.pruneCalls,            prev.tcp.pruneCalls             );
+
+    delta.udp.inDatagrams           = CounterDifference(curr.udp.inDatagrams,           prev.udp.inDatagrams            );
+    delta.udp.outDatagrams          = CounterDifference(curr.udp.outDatagrams,          prev.udp.outDatagrams           );
+    delta.udp.noPorts               = CounterDifference(curr.udp.noPorts,               prev.udp.noPorts                );
+    delta.udp.inErrors              = CounterDifference(curr.udp.inErrors,              prev.udp.inErrors               );
+    delta.udp.receiveBufferErrors   = CounterDifference(curr.udp.receiveBufferErrors,   prev.udp.receiveBufferErrors    );
+    delta.udp.sendBufferErrors      = CounterDifference(curr.udp.sendBufferErrors,      prev.udp.sendBufferErrors       );
+
+    delta.sockets = curr.sockets;
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryNetworkInterface(const char* name, NetworkInterface& networkInterface)
+{
+    networkInterface = NetworkInterface();
+    CopyToken(networkInterface.name, sizeof(networkInterface.name), name, std::strlen(name));
+
+    long long value = 0;
+
+    if (!ReadInterfaceAttribute(name, "ifindex", value))
+        return false;
+    networkInterface.index = static_cast<unsigned int>(value);
+
+    if (ReadInterfaceAttribute(name, "mtu", value))
+        networkInterface.mtu = static_cast<unsigned int>(value);
+
+    /* Reading "speed" fails with EINVAL for interfaces without a link, and some drivers report -1 */
+    if (ReadInterfaceAttribute(name, "speed", value) && value > 0)
+        networkInterface.speed = static_cast<unsigned int>(value);
+
+    if (ReadInterfaceAttribute(name, "device/numa_node", value))
+        networkInterface.numaNode = static_cast<int>(value);
+
+    /* Reading "carrier" fails with EINVAL if the interface is down */
+    if (ReadInterfaceAttribute(name, "carrier", value))
+        networkInterface.carrier = (value != 0);
+
+    /* Flags are hexadecimal, e.g. "0x1003" */
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/class/net/%s/flags", name);
+
+    char text[32];
+    if (ReadProcFileLine(filename, text, sizeof(text)) > 0)
+    {
+        const unsigned long flags = std::strtoul(text, NULL, 16);
+        networkInterface.loopback   = ((flags & IFF_LOOPBACK) != 0);
+        networkInterface.up         = ((flags & IFF_UP) != 0);
+    }
+
+    std::snprintf(filename, sizeof(filename), "/sys/class/net/%s/device", name);
+    networkInterface.physical = ProcFileExists(filename);
+
+    CountInterfaceQueues(name, networkInterface.rxQueues, networkInterface.txQueues);
+
+    return true;
+}
+
+bool QueryNetworkInterfaces(std::vector<NetworkInterface>& interfaces)
+{
+    interfaces.clear();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/net/dev"))
+        return false;
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+
+    for (unsigned int lineIndex = 0; reader.NextLine(line, lineLen); ++lineIndex)
+    {
+        /* Skip the two header lines */
+        if (lineIndex < 2)
+            continue;
+
+        TextScanner scanner(line, lineLen);
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        NetworkCounters counters;
+
+        if (ParseNetDevLine(scanner, name, nameLen, counters))
+        {
+            char interfaceName[32];
+            CopyToken(interfaceName, sizeof(interfaceName), name, nameLen);
+
+            NetworkInterface networkInterface;
+            if (QueryNetworkInterface(interfaceName, networkInterface))
+                interfaces.push_back(networkInterface);
+        }
+    }
+
+    return true;
+}
+
+bool QueryNetworkInterfaceCounters(const char* name, NetworkCounters& counters)
+{
+    counters = NetworkCounters();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/net/dev"))
+        return false;
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+
+    for (unsigned int lineIndex = 0; reader.NextLine(line, lineLen); ++lineIndex)
+    {
+        /* Skip the two header lines */
+        if (lineIndex < 2)
+            continue;
+
+        TextScanner scanner(line, lineLen);
+        const char* token = 0;
+        std::size_t tokenLen = 0;
+        NetworkCounters lineCounters;
+
+        if (ParseNetDevLine(scanner, token, tokenLen, lineCounters) && TokenEquals(token, tokenLen, name))
+        {
+            counters = lineCounters;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool QueryNetworkCounters(NetworkCounters& total)
+{
+    total = NetworkCounters();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/net/dev"))
+        return false;
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+
+    for (unsigned int lineIndex = 0; reader.NextLine(line, lineLen); ++lineIndex)
+    {
+        /* Skip the two header lines */
+        if (lineIndex < 2)
+            continue;
+
+        TextScanner scanner(line, lineLen);
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        NetworkCounters counters;
+
+        if (ParseNetDevLine(scanner, name, nameLen, counters) && !IsLoopbackInterface(name, nameLen))
+        {
+            total.rxBytes           += counters.rxBytes;
+            total.rxPackets         += counters.rxPackets;
+            total.rxErrors          += counters.rxErrors;
+            total.rxDropped         += counters.rxDropped;
+            total.rxFIFOErrors      += counters.rxFIFOErrors;
+            total.rxFrameErrors     += counters.rxFrameErrors;
+            total.rxCompressed      += counters.rxCompressed;
+            total.rxMulticast       += counters.rxMulticast;
+            total.txBytes           += counters.txBytes;
+            total.txPackets         += counters.txPackets;
+            total.txErrors          += counters.txErrors;
+            total.txDropped         += counters.txDropped;
+            total.txFIFOErrors      += counters.txFIFOErrors;
+            total.txCollisions      += counters.txCollisions;
+            total.txCarrierErrors   += counters.txCarrierErrors;
+            total.txCompressed      += counters.txCompressed;
+        }
+    }
+
+    return true;
+}
+
+bool QueryNetworkStackCounters(NetworkStackCounters& counters)
+{
+    counters = NetworkStackCounters();
+
+    /* The value line of "TcpExt" grows with the counters, so the buffer has room for 20 digits per counter */
+    char buffer[16 * 1024];
+    bool result = false;
+
+    for (std::size_t i = 0; i < sizeof(g_networkStackFiles)/sizeof(g_networkStackFiles[0]); ++i)
+    {
+        const long len = ReadProcFile(g_networkStackFiles[i], buffer, sizeof(buffer));
+        if (len > 0 && ParseNetworkStackFile(i, buffer, static_cast<std::size_t>(len), counters))
+            result = true;
+    }
+
+    return result;
+}
+
+
+/*
+ * NetworkSampler class
+ */
+
+NetworkSampler::NetworkSampler() :
+    fd_         ( OpenProcFile("/proc/net/dev") ),
+    timestamp_  ( 0                             )
+{
+    if (fd_ < 0 || !QueryNetworkInterfaces(interfaces_))
+        return;
+
+    if (!ReserveProcFileBuffer(fd_, buffer_))
+        return;
+
+    /* Sort interfaces by name, so each line of "/proc/net/dev" is matched with a binary search */
+    std::sort(interfaces_.begin(), interfaces_.end(), CompareInterface);
+
+    counters_.resize(interfaces_.size());
+    activity_.resize(interfaces_.size());
+
+    /* Take initial sample, so the first call to 'Sample' reports the activity since construction */
+    Sample();
+}
+
+NetworkSampler::~NetworkSampler()
+{
+    CloseProcFile(fd_);
+}
+
+bool NetworkSampler::Sample()
+{
+    if (fd_ < 0 || buffer_.empty())
+        return false;
+
+    const long len = ReadProcFile(fd_, buffer_.data(), buffer_.size());
+    if (len <= 0)
+        return false;
+
+    const unsigned long long timestamp = MonotonicNanoseconds();
+    const double seconds = (timestamp_ > 0 && timestamp > timestamp_ ? static_cast<double>(timestamp - timestamp_) * 1.0e-9 : 0.0);
+
+    TextScanner scanner(buffer_.data(), static_cast<std::size_t>(len));
+    SkipNetDevHeader(scanner);
+
+    while (!scanner.AtEnd())
+    {
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        NetworkCounters counters;
+
+        if (ParseNetDevLine(scanner, name, nameLen, counters))
+        {
+            /* Binary search for the interface name */
+            std::size_t first = 0, last = interfaces_.size();
+
+            while (first < last)
+            {
+                const std::size_t index = first + (last - first) / 2;
+                const int result = CompareInterfaceName(name, nameLen, interfaces_[index].name);
+
+                if (result < 0)
+                    last = index;
+                else if (result > 0)
+                    first = index + 1;
+                else
+                {
+                    if (seconds > 0.0)
+                        UpdateActivity(counters_[index], counters, seconds, activity_[index]);
+                    counters_[index] = counters;
+                    break;
+                }
+            }
+        }
+
+        scanner.SkipLine();
+    }
+
+    timestamp_ = timestamp;
+
+    return true;
+}
+
+
+/*
+ * NetworkStackSampler class
+ */
+
+NetworkStackSampler::NetworkStackSampler() :
+    timestamp_  ( 0   ),
+    interval_   ( 0.0 )
+{
+    /* Size the buffer for the largest file */
+    bool result = false;
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        fds_[i] = OpenProcFile(g_networkStackFiles[i]);
+        if (ReserveProcFileBuffer(fds_[i], buffer_))
+            result = true;
+    }
+
+    if (!result)
+        return;
+
+    /* Take initial sample, so the first call to 'Sample' reports the changes since construction */
+    Sample();
+}
+
+NetworkStackSampler::~NetworkStackSampler()
+{
+    for (std::size_t i = 0; i < 3; ++i)
+        CloseProcFile(fds_[i]);
+}
+
+bool NetworkStackSampler::Sample()
+{
+    if (buffer_.empty())
+        return false;
+
+    NetworkStackCounters counters;
+    bool result = false;
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (fds_[i] < 0)
+            continue;
+
+        const long len = ReadProcFile(fds_[i], buffer_.data(), buffer_.size());
+        if (len > 0 && ParseNetworkStackFile(i, buffer_.data(), static_cast<std::size_t>(len), counters))
+            result = true;
+    }
+
+    if (!result)
+        return false;
+
+    const unsigned long long timestamp = MonotonicNanoseconds();
+
+    if (timestamp_ > 0)
+    {
+        ComputeNetworkStackDelta(counters_, counters, delta_);
+        interval_ = static_cast<double>(timestamp - timestamp_) * 1.0e-9;
+    }
+
+    counters_   = counters;
+    timestamp_  = timestamp;
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,98 @@
+/*
+ * LinuxPlacement.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef _GNU_SOURCE
+#   define _GNU_SOURCE
+#endif
+
+#include <SystemIndicatorPlacement.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cerrno>
+
+
+namespace SystemIndicator
+{
+
+
+bool SetThreadAffinity(const CPUSet& cpus)
+{
+    const int last = cpus.Last();
+    if (last < 0)
+        return false;
+
+    /* Allocate dynamic CPU set, so machines with more than CPU_SETSIZE (1024) CPUs are supported */
+    const int numCPUs = last + 1;
+    cpu_set_t* cpuSet = CPU_ALLOC(numCPUs);
+    if (!cpuSet)
+        return false;
+
+    const std::size_t cpuSetSize = CPU_ALLOC_SIZE(numCPUs);
+    CPU_ZERO_S(cpuSetSize, cpuSet);
+
+    for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+        CPU_SET_S(cpu, cpuSetSize, cpuSet);
+
+    const bool result = (pthread_setaffinity_np(pthread_self(), cpuSetSize, cpuSet) == 0);
+
+    CPU_FREE(cpuSet);
+
+    return result;
+}
+
+// Returns the affinity of the specified thread, or of the calling thread if 'tid' is 0.
+static bool GetAffinity(pid_t tid, CPUSet& cpus)
+{
+    cpus.Clear();
+
+    /* Grow the CPU set until the kernel accepts its size */
+    for (int numCPUs = CPU_SETSIZE; numCPUs <= (1 << 20); numCPUs *= 2)
+    {
+        cpu_set_t* cpuSet = CPU_ALLOC(numCPUs);
+        if (!cpuSet)
+            return false;
+
+        const std::size_t cpuSetSize = CPU_ALLOC_SIZE(numCPUs);
+        CPU_ZERO_S(cpuSetSize, cpuSet);
+
+        if (sched_getaffinity(tid, cpuSetSize, cpuSet) == 0)
+        {
+            for (int cpu = 0; cpu < numCPUs; ++cpu)
+            {
+                if (CPU_ISSET_S(cpu, cpuSetSize, cpuSet))
+                    cpus.Add(static_cast<unsigned int>(cpu));
+            }
+            CPU_FREE(cpuSet);
+            return true;
+        }
+
+        CPU_FREE(cpuSet);
+
+        if (errno != EINVAL)
+            break;
+    }
+
+    return false;
+}
+
+bool GetThreadAffinity(CPUSet& cpus)
+{
+    return GetAffinity(0, cpus);
+}
+
+bool GetProcessAffinity(CPUSet& cpus)
+{
+    /* The process ID is the thread ID of the main thread */
+    return GetAffinity(getpid(), cpus);
+}
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
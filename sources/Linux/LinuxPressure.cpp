@@ -0,0 +1,139 @@
+/*
+ * LinuxPressure.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorPressure.h>
+#include <cstdio>
+#include "Cgroup.h"
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Parses the fields of a pressure line after "some" or "full", e.g. "avg10=1.25 avg60=0.50 avg300=0.10 total=123456".
+static void ParsePressureStall(TextScanner& scanner, PressureStall& stall)
+{
+    const char* key = 0;
+    std::size_t keyLen = 0;
+
+    while ((keyLen = scanner.ReadKey(key, '=')) > 0)
+    {
+        if (TokenEquals(key, keyLen, "avg10"))
+            scanner.ReadReal(stall.avg10);
+        else if (TokenEquals(key, keyLen, "avg60"))
+            scanner.ReadReal(stall.avg60);
+        else if (TokenEquals(key, keyLen, "avg300"))
+            scanner.ReadReal(stall.avg300);
+        else if (TokenEquals(key, keyLen, "total"))
+            scanner.ReadUInt(stall.total);
+    }
+}
+
+// Reads a pressure file with a "some" line and an optional "full" line.
+static bool ReadPressureFile(int fd, ResourcePressure& pressure)
+{
+    pressure = ResourcePressure();
+
+    char buffer[256];
+    const long len = ReadProcFile(fd, buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+
+    while (!scanner.AtEnd())
+    {
+        const char* token = 0;
+        const std::size_t tokenLen = scanner.ReadToken(token);
+
+        if (TokenEquals(token, tokenLen, "some"))
+            ParsePressureStall(scanner, pressure.some);
+        else if (TokenEquals(token, tokenLen, "full"))
+            ParsePressureStall(scanner, pressure.full);
+
+        scanner.SkipLine();
+    }
+
+    pressure.available = true;
+    return true;
+}
+
+
+/*
+ * PressureMonitor class
+ */
+
+PressureMonitor::PressureMonitor()
+{
+    fds_[0] = fds_[1] = fds_[2] = -1;
+}
+
+PressureMonitor::~PressureMonitor()
+{
+    Close();
+}
+
+bool PressureMonitor::Open(const PressureScope scope)
+{
+    Close();
+
+    static const char* const filenames[2][3] =
+    {
+        { "/proc/pressure/cpu", "/proc/pressure/memory", "/proc/pressure/io" },
+        { "/cpu.pressure",      "/memory.pressure",      "/io.pressure"      },
+    };
+
+    if (scope == PRESSURE_SCOPE_CGROUP)
+    {
+        char dir[512];
+        if (!QueryUnifiedCgroupDir(dir, sizeof(dir)))
+            return false;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            char filename[640];
+            std::snprintf(filename, sizeof(filename), "%s%s", dir, filenames[1][i]);
+            fds_[i] = OpenProcFile(filename);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < 3; ++i)
+            fds_[i] = OpenProcFile(filenames[0][i]);
+    }
+
+    return IsOpen();
+}
+
+void PressureMonitor::Close()
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        CloseProcFile(fds_[i]);
+        fds_[i] = -1;
+    }
+}
+
+bool PressureMonitor::Read(PressureInfo& info)
+{
+    const bool cpu      = ReadPressureFile(fds_[0], info.cpu);
+    const bool memory   = ReadPressureFile(fds_[1], info.memory);
+    const bool io       = ReadPressureFile(fds_[2], info.io);
+    return (cpu || memory || io);
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,423 @@
+/*
+ * LinuxProcess.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorProcess.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Counts the entries in the "/proc/self/fd" directory with the specified descriptor, excluding the descriptor itself.
+static bool CountOpenFiles(int fd, unsigned int& count)
+{
+    count = 0;
+
+    ProcDirectory dir;
+    if (!dir.Attach(fd))
+        return false;
+
+    while (dir.Next() != NULL)
+        ++count;
+
+    if (count > 0)
+        --count;
+
+    return true;
+}
+
+static unsigned long long TimevalToMicroseconds(const timeval& tv)
+{
+    return static_cast<unsigned long long>(tv.tv_sec) * 1000000ull + static_cast<unsigned long long>(tv.tv_usec);
+}
+
+// Converts the specified scheduler clock ticks (e.g. "utime" in "/proc/self/task/*/stat") to microseconds.
+static unsigned long long ClockTicksToMicroseconds(unsigned long long ticks)
+{
+    static const unsigned long long ticksPerSecond = static_cast<unsigned long long>(sysconf(_SC_CLK_TCK));
+    return (ticksPerSecond > 0 ? ticks * 1000000ull / ticksPerSecond : 0);
+}
+
+static bool QueryResourceUsage(ProcessUsage& usage)
+{
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0)
+        return false;
+
+    usage.minorFaults                   = static_cast<unsigned long long>(ru.ru_minflt);
+    usage.majorFaults                   = static_cast<unsigned long long>(ru.ru_majflt);
+    usage.voluntaryContextSwitches      = static_cast<unsigned long long>(ru.ru_nvcsw);
+    usage.involuntaryContextSwitches    = static_cast<unsigned long long>(ru.ru_nivcsw);
+    usage.userTime                      = TimevalToMicroseconds(ru.ru_utime);
+    usage.systemTime                    = TimevalToMicroseconds(ru.ru_stime);
+
+    return true;
+}
+
+// Parses "/proc/self/statm", e.g. "5120 812 640 ..." (sizes in pages).
+static bool ParseStatm(const char* text, std::size_t length, ProcessUsage& usage)
+{
+    static const unsigned long long pageSize = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+
+    TextScanner scanner(text, length);
+
+    unsigned long long size = 0, resident = 0, shared = 0;
+    if (!scanner.ReadUInt(size) || !scanner.ReadUInt(resident) || !scanner.ReadUInt(shared))
+        return false;
+
+    usage.virtualMemory     = size      * pageSize;
+    usage.residentMemory    = resident  * pageSize;
+    usage.sharedMemory      = shared    * pageSize;
+
+    return true;
+}
+
+// Parses the lines of "/proc/self/status" that are not covered by "getrusage" or "/proc/self/statm", e.g. "VmHWM:  4096 kB".
+static bool ParseStatus(const char* text, std::size_t length, ProcessUsage& usage)
+{
+    TextScanner scanner(text, length);
+    bool result = false;
+
+    while (!scanner.AtEnd())
+    {
+        const char* key = NULL;
+        const std::size_t keyLen = scanner.ReadKey(key, ':');
+
+        unsigned long long value = 0;
+        if (keyLen > 0 && scanner.ReadUInt(value))
+        {
+            if (TokenEquals(key, keyLen, "VmHWM"))
+            {
+                usage.peakResidentMemory = value * 1024;
+                result = true;
+            }
+            else if (TokenEquals(key, keyLen, "VmSwap"))
+                usage.swappedMemory = value * 1024;
+            else if (TokenEquals(key, keyLen, "Threads"))
+                usage.threads = static_cast<unsigned int>(value);
+        }
+
+        scanner.SkipLine();
+    }
+
+    return result;
+}
+
+/*
+Parses the "stat" file of a thread, e.g. "1234 (worker 1) S 1 1234 ...".
+The name is enclosed in the first '(' and the last ')', since the name itself may contain parentheses and spaces.
+*/
+static bool ParseThreadStat(const char* text, std::size_t length, ThreadUsage& thread)
+{
+    const char* open = static_cast<const char*>(std::memchr(text, '(', length));
+    if (open == NULL)
+        return false;
+
+    const char* close = static_cast<const char*>(memrchr(open, ')', length - static_cast<std::size_t>(open - text)));
+    if (close == NULL)
+        return false;
+
+    const std::size_t nameLen = std::min(static_cast<std::size_t>(close - open - 1), sizeof(thread.name) - 1);
+    std::memcpy(thread.name, open + 1, nameLen);
+    thread.name[nameLen] = '\0';
+
+    /* Read fields after the name, beginning with field 3 ("state") */
+    TextScanner scanner(close + 1, length - static_cast<std::size_t>(close + 1 - text));
+
+    const char* token = NULL;
+    if (scanner.ReadToken(token) != 1)
+        return false;
+
+    thread.state = token[0];
+
+    unsigned long long minorFaults = 0, majorFaults = 0, userTime = 0, systemTime = 0;
+    long long processor = -1;
+
+    for (int field = 4; field <= 39; ++field)
+    {
+        switch (field)
+        {
+            case 10: if (!scanner.ReadUInt(minorFaults)) return false; break;
+            case 12: if (!scanner.ReadUInt(majorFaults)) return false; break;
+            case 14: if (!scanner.ReadUInt(userTime   )) return false; break;
+            case 15: if (!scanner.ReadUInt(systemTime )) return false; break;
+            case 39: scanner.ReadInt(processor); break;
+            default: if (scanner.ReadToken(token) == 0) field = 40; break;
+        }
+    }
+
+    thread.minorFaults  = minorFaults;
+    thread.majorFaults  = majorFaults;
+    thread.userTime     = ClockTicksToMicroseconds(userTime);
+    thread.systemTime   = ClockTicksToMicroseconds(systemTime);
+    thread.processor    = static_cast<int>(processor);
+
+    return true;
+}
+
+// Opens the "stat" file of the specified thread relative to the "/proc/self/task" directory.
+static int OpenThreadStat(int taskDirFd, int tid)
+{
+    char path[32];
+    std::snprintf(path, sizeof(path), "%d/stat", tid);
+    return openat(taskDirFd, path, O_RDONLY | O_CLOEXEC);
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryProcessUsage(ProcessUsage& usage, bool countOpenFiles)
+{
+    ProcessUsage result;
+
+    if (!QueryResourceUsage(result))
+        return false;
+
+    char buffer[4096];
+
+    long len = ReadProcFile("/proc/self/statm", buffer, sizeof(buffer));
+    if (len > 0)
+        ParseStatm(buffer, static_cast<std::size_t>(len), result);
+
+    len = ReadProcFile("/proc/self/status", buffer, sizeof(buffer));
+    if (len > 0)
+        ParseStatus(buffer, static_cast<std::size_t>(len), result);
+
+    if (countOpenFiles)
+        QueryProcessOpenFiles(result.openFiles);
+
+    usage = result;
+
+    return true;
+}
+
+bool QueryProcessOpenFiles(unsigned int& count)
+{
+    const int fd = OpenProcFile("/proc/self/fd");
+    const bool result = CountOpenFiles(fd, count);
+    CloseProcFile(fd);
+    return result;
+}
+
+bool QueryProcessMemoryDetails(ProcessMemoryDetails& details)
+{
+    char buffer[4096];
+    const long len = ReadProcFile("/proc/self/smaps_rollup", buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    const struct
+    {
+        const char*         name;
+        unsigned long long* value;
+    }
+    fields[] =
+    {
+        { "Rss",            &details.rss            },
+        { "Pss",            &details.pss            },
+        { "Pss_Anon",       &details.pssAnonymous   },
+        { "Pss_File",       &details.pssFile        },
+        { "Pss_Shmem",      &details.pssShared      },
+        { "Shared_Clean",   &details.sharedClean    },
+        { "Shared_Dirty",   &details.sharedDirty    },
+        { "Private_Clean",  &details.privateClean   },
+        { "Private_Dirty",  &details.privateDirty   },
+        { "Swap",           &details.swap           },
+        { "SwapPss",        &details.swapPss        },
+        { "AnonHugePages",  &details.anonHugePages  },
+    };
+
+    details = ProcessMemoryDetails();
+
+    /* Skip the header line of the rollup mapping, e.g. "00400000-7ffd0000 ---p 00000000 00:00 0  [rollup]" */
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+    scanner.SkipLine();
+
+    bool result = false;
+
+    while (!scanner.AtEnd())
+    {
+        const char* key = NULL;
+        const std::size_t keyLen = scanner.ReadKey(key, ':');
+
+        unsigned long long value = 0;
+        if (keyLen > 0 && scanner.ReadUInt(value))
+        {
+            for (const auto& field : fields)
+            {
+                if (TokenEquals(key, keyLen, field.name))
+                {
+                    *field.value = value * 1024;
+                    result = true;
+                    break;
+                }
+            }
+        }
+
+        scanner.SkipLine();
+    }
+
+    return result;
+}
+
+
+/*
+ * ProcessSampler class
+ */
+
+ProcessSampler::ProcessSampler() :
+    statmFd_    ( OpenProcFile("/proc/self/statm" ) ),
+    statusFd_   ( OpenProcFile("/proc/self/status") ),
+    taskDirFd_  ( OpenProcFile("/proc/self/task"  ) ),
+    fdDirFd_    ( OpenProcFile("/proc/self/fd"    ) ),
+    timestamp_  ( 0                                 )
+{
+    /* Take initial sample, so the first call to 'Sample' reports the activity since construction */
+    Sample();
+}
+
+ProcessSampler::~ProcessSampler()
+{
+    CloseProcFile(statmFd_);
+    CloseProcFile(statusFd_);
+    CloseProcFile(taskDirFd_);
+    CloseProcFile(fdDirFd_);
+}
+
+bool ProcessSampler::Sample()
+{
+    ProcessUsage usage;
+    if (!QueryResourceUsage(usage))
+        return false;
+
+    const unsigned long long timestamp = MonotonicNanoseconds();
+
+    char buffer[4096];
+
+    long len = ReadProcFile(statmFd_, buffer, sizeof(buffer));
+    if (len > 0)
+        ParseStatm(buffer, static_cast<std::size_t>(len), usage);
+
+    len = ReadProcFile(statusFd_, buffer, sizeof(buffer));
+    if (len > 0)
+        ParseStatus(buffer, static_cast<std::size_t>(len), usage);
+
+    /* Exclude the files that are kept open by this sampler, i.e. "statm", "status", and the "task" directory */
+    if (CountOpenFiles(fdDirFd_, usage.openFiles))
+    {
+        unsigned int samplerFiles = 0;
+        for (int fd : { statmFd_, statusFd_, taskDirFd_ })
+        {
+            if (fd >= 0)
+                ++samplerFiles;
+        }
+        usage.openFiles = (usage.openFiles > samplerFiles ? usage.openFiles - samplerFiles : 0);
+    }
+
+    /* Enumerate thread IDs; the vectors keep their capacity, so this only allocates when the process has more threads than ever before */
+    threadIds_.clear();
+
+    ProcDirectory taskDir;
+    taskDir.Attach(taskDirFd_);
+
+    while (const char* name = taskDir.Next())
+    {
+        int tid = 0;
+        for (; *name >= '0' && *name <= '9'; ++name)
+            tid = tid*10 + (*name - '0');
+        if (*name == '\0' && tid > 0)
+            threadIds_.push_back(tid);
+    }
+
+    std::sort(threadIds_.begin(), threadIds_.end());
+
+    /*
+    Merge the thread IDs with the threads of the previous sample, which are sorted by ID as well.
+    The "stat" file of each thread is opened relative to the "task" directory on every sample instead of being kept open,
+    so a process with thousands of threads doesn't exhaust its file descriptor limit (RLIMIT_NOFILE) because of this sampler.
+    */
+    nextThreads_.clear();
+
+    const double seconds = (timestamp_ > 0 ? static_cast<double>(timestamp - timestamp_) * 1.0e-9 : 0.0);
+
+    std::size_t prevIndex = 0;
+
+    for (int tid : threadIds_)
+    {
+        /* Skip threads that have exited */
+        while (prevIndex < threads_.size() && threads_[prevIndex].id < tid)
+            ++prevIndex;
+
+        const ThreadUsage* prev = NULL;
+
+        if (prevIndex < threads_.size() && threads_[prevIndex].id == tid)
+            prev = &threads_[prevIndex++];
+
+        ThreadUsage thread;
+        thread.id = tid;
+
+        const int fd = OpenThreadStat(taskDirFd_, tid);
+
+        char statBuffer[1024];
+        len = ReadProcFile(fd, statBuffer, sizeof(statBuffer));
+
+        CloseProcFile(fd);
+
+        if (len <= 0 || !ParseThreadStat(statBuffer, static_cast<std::size_t>(len), thread))
+        {
+            /* Thread has exited between enumeration and reading its file */
+            continue;
+        }
+
+        if (prev != NULL && seconds > 0.0)
+        {
+            const double busy = CounterDelta(thread.userTime + thread.systemTime, prev->userTime + prev->systemTime);
+            thread.cpuUsage = busy * 1.0e-6 / seconds * 100.0;
+        }
+
+        nextThreads_.push_back(thread);
+    }
+
+    threads_.swap(nextThreads_);
+
+    /* Compute activity since the previous sample */
+    if (seconds > 0.0)
+    {
+        const double busy = CounterDelta(usage.userTime + usage.systemTime, usage_.userTime + usage_.systemTime);
+
+        activity_.cpuUsage              = busy * 1.0e-6 / seconds * 100.0;
+        activity_.minorFaultRate        = CounterDelta(usage.minorFaults,                usage_.minorFaults               ) / seconds;
+        activity_.majorFaultRate        = CounterDelta(usage.majorFaults,                usage_.majorFaults               ) / seconds;
+        activity_.voluntarySwitchRate   = CounterDelta(usage.voluntaryContextSwitches,   usage_.voluntaryContextSwitches  ) / seconds;
+        activity_.involuntarySwitchRate = CounterDelta(usage.involuntaryContextSwitches, usage_.involuntaryContextSwitches) / seconds;
+    }
+
+    usage_      = usage;
+    timestamp_  = timestamp;
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,167 @@
+/*
+ * LinuxProfileCache.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorExport.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../ProfileCache.h"
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Reads the random ID the kernel generates on each boot, e.g. "0b3ee6e3-2a0c-4f5e-8d7a-0d4c8a6f3b21".
+static bool QueryBootID(char* buffer, std::size_t size)
+{
+    return (ReadProcFileLine("/proc/sys/kernel/random/boot_id", buffer, size) > 0);
+}
+
+// Writes the entire buffer to the specified file descriptor.
+static bool WriteAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t n = write(fd, data, size);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+struct FileSink
+{
+    int     fd;
+    bool    failed;
+
+    static void Write(const char* data, std::size_t size, void* userData)
+    {
+        FileSink* self = reinterpret_cast<FileSink*>(userData);
+        if (!self->failed && !WriteAll(self->fd, data, size))
+            self->failed = true;
+    }
+};
+
+
+/*
+ * Global functions
+ */
+
+bool GetDefaultProfileCachePath(char* buffer, std::size_t size)
+{
+    int len = 0;
+
+    if (const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR"))
+        len = std::snprintf(buffer, size, "%s/systemindicator-profile.bin", runtimeDir);
+    else
+        len = std::snprintf(buffer, size, "/tmp/systemindicator-%u-profile.bin", static_cast<unsigned int>(geteuid()));
+
+    return (len > 0 && static_cast<std::size_t>(len) < size);
+}
+
+bool SaveHardwareProfile(const char* filename, const InformationSnapshot& profile)
+{
+    char bootID[48];
+    if (!QueryBootID(bootID, sizeof(bootID)))
+        return false;
+
+    /* Write into a temporary file next to the cache file, so the rename below is atomic */
+    char tempFilename[512];
+    const int len = std::snprintf(tempFilename, sizeof(tempFilename), "%s.%ld.tmp", filename, static_cast<long>(getpid()));
+    if (len < 0 || static_cast<std::size_t>(len) >= sizeof(tempFilename))
+        return false;
+
+    const int fd = open(tempFilename, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0)
+        return false;
+
+    ProfileCacheHeader header;
+    InitProfileCacheHeader(header, bootID);
+
+    FileSink sink = { fd, false };
+    FileSink::Write(reinterpret_cast<const char*>(&header), sizeof(header), &sink);
+    ExportInformation(profile, EXPORT_FORMAT_BINARY, FileSink::Write, &sink);
+
+    const bool result = (close(fd) == 0 && !sink.failed && rename(tempFilename, filename) == 0);
+
+    if (!result)
+        unlink(tempFilename);
+
+    return result;
+}
+
+bool LoadHardwareProfile(const char* filename, InformationSnapshot& profile)
+{
+    char bootID[48];
+    if (!QueryBootID(bootID, sizeof(bootID)))
+        return false;
+
+    const int fd = open(filename, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0)
+        return false;
+
+    /* Only trust files of the current user that no one else can modify */
+    struct stat status;
+    if (fstat(fd, &status) != 0 ||
+        !S_ISREG(status.st_mode) ||
+        status.st_uid != geteuid() ||
+        (status.st_mode & (S_IWGRP | S_IWOTH)) != 0 ||
+        status.st_size < static_cast<off_t>(sizeof(ProfileCacheHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    const char* bytes = reinterpret_cast<const char*>(data);
+
+    ProfileCacheHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    const bool result =
+    (
+        IsProfileCacheHeaderValid(header, bootID) &&
+        ReadBinaryRecord(bytes + sizeof(header), size - sizeof(header), profile) > 0
+    );
+
+    munmap(data, size);
+
+    if (!result)
+        profile.Clear();
+
+    return result;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
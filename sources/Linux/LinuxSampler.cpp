@@ -0,0 +1,131 @@
+/*
+ * LinuxSampler.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorSampler.h>
+#include <SystemIndicatorTopology.h>
+#include <unistd.h>
+#include <algorithm>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+// Reads the time counters of a line like "cpu0 4705 356 584 3699 23 23 0 0 0 0"; missing counters are 0.
+static void ReadCPUCounters(TextScanner& scanner, unsigned long long* counters, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!scanner.ReadUInt(counters[i]))
+            counters[i] = 0;
+    }
+}
+
+// Returns the number of possible CPUs, i.e. the highest CPU number that can ever be online plus one.
+static std::size_t QueryPossibleCPUCount()
+{
+    CPUSet cpus;
+
+    char buffer[4096];
+    const long len = ReadProcFile("/sys/devices/system/cpu/possible", buffer, sizeof(buffer));
+
+    if (len > 0 && cpus.Parse(buffer, static_cast<std::size_t>(len)) && !cpus.Empty())
+        return static_cast<std::size_t>(cpus.Last()) + 1;
+
+    const long count = sysconf(_SC_NPROCESSORS_CONF);
+    return (count > 0 ? static_cast<std::size_t>(count) : 0);
+}
+
+CPUSampler::CPUSampler() :
+    fd_ ( OpenProcFile("/proc/stat") )
+{
+    std::fill(totalCounters_, totalCounters_ + numCounters, 0ull);
+
+    if (fd_ < 0)
+        return;
+
+    /*
+    Allocate counters for all possible CPUs instead of the CPUs listed in "/proc/stat", which only lists online CPUs,
+    so a CPU that comes online later is sampled as well
+    */
+    const std::size_t numCPUs = QueryPossibleCPUCount();
+    if (numCPUs == 0)
+        return;
+
+    /* Allocate a buffer for the CPU lines only, e.g. "cpu1023 ..." with up to 10 counters of 20 digits each */
+    static const std::size_t maxLineLength = 16 + 10 * 21;
+
+    buffer_.resize((numCPUs + 1) * maxLineLength);
+    counters_.resize(numCPUs * numCounters, 0);
+    usage_.resize(numCPUs);
+
+    /* Take initial sample, so the first call to 'Sample' reports the utilization since construction */
+    Sample();
+
+    total_ = CPUUsage();
+    std::fill(usage_.begin(), usage_.end(), CPUUsage());
+}
+
+CPUSampler::~CPUSampler()
+{
+    CloseProcFile(fd_);
+}
+
+bool CPUSampler::Sample()
+{
+    if (fd_ < 0 || buffer_.empty())
+        return false;
+
+    /* Read only the beginning of the file with the CPU lines; the remaining content is truncated */
+    const long len = ReadProcFile(fd_, buffer_.data(), buffer_.size());
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer_.data(), static_cast<std::size_t>(len));
+    unsigned long long current[numCounters];
+
+    /* Offline CPUs are missing in "/proc/stat", so reset the utilization of all CPUs between the listed ones, which are in ascending order */
+    std::size_t nextCPU = 0;
+
+    while (scanner.Accept("cpu"))
+    {
+        if (scanner.Accept(' '))
+        {
+            /* Read counters of all CPUs combined, e.g. "cpu  4705 356 584 ..." */
+            ReadCPUCounters(scanner, current, numCounters);
+            UpdateUsage(totalCounters_, current, total_);
+        }
+        else
+        {
+            /* Read counters of a single CPU, e.g. "cpu0 4705 356 584 ..." */
+            unsigned long long cpu = 0;
+            if (scanner.ReadUInt(cpu) && cpu < usage_.size())
+            {
+                for (; nextCPU < cpu; ++nextCPU)
+                    usage_[nextCPU] = CPUUsage();
+                nextCPU = static_cast<std::size_t>(cpu) + 1;
+
+                ReadCPUCounters(scanner, current, numCounters);
+                UpdateUsage(&counters_[cpu * numCounters], current, usage_[cpu]);
+            }
+        }
+        scanner.SkipLine();
+    }
+
+    for (; nextCPU < usage_.size(); ++nextCPU)
+        usage_[nextCPU] = CPUUsage();
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,417 @@
+/*
+ * LinuxStorage.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorStorage.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Returns true if the specified device (not null-terminated) is a whole block device, i.e. it is listed in "/sys/block".
+static bool IsWholeBlockDevice(const char* name, std::size_t length)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/block/%.*s", static_cast<int>(length), name);
+    return ProcFileExists(filename);
+}
+
+// Returns true if the specified whole block device is backed by hardware, i.e. it has a parent device.
+static bool IsPhysicalBlockDevice(const char* name)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/block/%s/device", name);
+    return ProcFileExists(filename);
+}
+
+/*
+Cached classification of the lines of "/proc/diskstats" for 'QueryDiskCounters', in the order of the file.
+Each line is matched with its entry by device number and name, and only lines that don't match (i.e. when devices were added,
+removed, or renamed) are classified again, so a query usually doesn't access "/sys/block" at all.
+*/
+struct DiskStatsEntry
+{
+    unsigned int    major;
+    unsigned int    minor;
+    char            name[32];
+    bool            physicalDisk;   // Physical whole block device, i.e. counted in the total
+};
+
+static std::mutex                   g_diskStatsMutex;
+static std::vector<DiskStatsEntry>  g_diskStatsEntries;
+
+// Returns true if the specified line of "/proc/diskstats" is a physical whole block device, and updates the cached entry at the specified index.
+static bool IsPhysicalDiskStatsEntry(std::size_t index, unsigned long long major, unsigned long long minor, const char* name, std::size_t nameLen)
+{
+    if (index < g_diskStatsEntries.size())
+    {
+        const DiskStatsEntry& entry = g_diskStatsEntries[index];
+        if (entry.major == major && entry.minor == minor && TokenEquals(name, nameLen, entry.name))
+            return entry.physicalDisk;
+
+        /* Device list has changed, so classify all following lines again */
+        g_diskStatsEntries.resize(index);
+    }
+
+    DiskStatsEntry entry;
+    entry.major         = static_cast<unsigned int>(major);
+    entry.minor         = static_cast<unsigned int>(minor);
+    CopyToken(entry.name, sizeof(entry.name), name, nameLen);
+    entry.physicalDisk  = (IsWholeBlockDevice(name, nameLen) && IsPhysicalBlockDevice(entry.name));
+    g_diskStatsEntries.push_back(entry);
+
+    return entry.physicalDisk;
+}
+
+// Orders block devices by their device number, i.e. major and minor number.
+static bool CompareDeviceNumber(const BlockDevice& lhs, const BlockDevice& rhs)
+{
+    return (lhs.major < rhs.major || (lhs.major == rhs.major && lhs.minor < rhs.minor));
+}
+
+/*
+Parses a line of "/proc/diskstats" up to the last counter, e.g. "   8       0 sda 4511 1209 300232 1932 ...".
+Older kernels report 11 counters, Linux 4.18 adds 4 discard counters, and Linux 5.5 adds 2 flush counters.
+*/
+static bool ParseDiskStatsLine(
+    TextScanner& scanner, unsigned long long& major, unsigned long long& minor, const char*& name, std::size_t& nameLen, BlockDeviceCounters& counters)
+{
+    if (!scanner.ReadUInt(major) || !scanner.ReadUInt(minor))
+        return false;
+
+    nameLen = scanner.ReadToken(name);
+    if (nameLen == 0)
+        return false;
+
+    unsigned long long* const fields[] =
+    {
+        &counters.reads, &counters.readsMerged, &counters.readSectors, &counters.readTime,
+        &counters.writes, &counters.writesMerged, &counters.writeSectors, &counters.writeTime,
+        &counters.inFlight, &counters.ioTime, &counters.weightedIOTime,
+        &counters.discards, 0, &counters.discardSectors, 0,
+        &counters.flushes, 0,
+    };
+
+    counters = BlockDeviceCounters();
+
+    for (std::size_t i = 0; i < sizeof(fields)/sizeof(fields[0]); ++i)
+    {
+        unsigned long long value = 0;
+        if (!scanner.ReadUInt(value))
+            return (i >= 11);
+        if (fields[i] != 0)
+            *fields[i] = value;
+    }
+
+    return true;
+}
+
+// Extracts the active scheduler from a line like "none [mq-deadline] kyber bfq".
+static void ParseScheduler(const char* text, char* scheduler, std::size_t size)
+{
+    if (const char* begin = std::strchr(text, '['))
+    {
+        if (const char* end = std::strchr(++begin, ']'))
+        {
+            CopyToken(scheduler, size, begin, static_cast<std::size_t>(end - begin));
+            return;
+        }
+    }
+
+    /* Devices without a choice (e.g. "none") don't use brackets */
+    TextScanner scanner(text, std::strlen(text));
+    const char* token = 0;
+    const std::size_t tokenLen = scanner.ReadToken(token);
+    CopyToken(scheduler, size, token, tokenLen);
+}
+
+// Reads a numeric attribute of the request queue of the specified device, e.g. "/sys/block/sda/queue/nr_requests".
+static bool ReadQueueAttribute(const char* name, const char* attribute, unsigned long long& value)
+{
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/block/%s/queue/%s", name, attribute);
+    return ReadProcFileUInt(filename, value);
+}
+
+static void UpdateActivity(const BlockDeviceCounters& prev, const BlockDeviceCounters& curr, double seconds, BlockDeviceActivity& activity)
+{
+    static const double sectorSize = 512.0;
+
+    const double reads  = CounterDelta(curr.reads, prev.reads);
+    const double writes = CounterDelta(curr.writes, prev.writes);
+
+    activity.readIOPS           = reads / seconds;
+    activity.writeIOPS          = writes / seconds;
+    activity.readThroughput     = CounterDelta(curr.readSectors, prev.readSectors) * sectorSize / seconds;
+    activity.writeThroughput    = CounterDelta(curr.writeSectors, prev.writeSectors) * sectorSize / seconds;
+    activity.readLatency        = (reads > 0.0 ? CounterDelta(curr.readTime, prev.readTime) / reads : 0.0);
+    activity.writeLatency       = (writes > 0.0 ? CounterDelta(curr.writeTime, prev.writeTime) / writes : 0.0);
+    activity.utilization        = CounterDelta(curr.ioTime, prev.ioTime) / (seconds * 10.0);
+    activity.queueDepth         = CounterDelta(curr.weightedIOTime, prev.weightedIOTime) / (seconds * 1000.0);
+
+    if (activity.utilization > 100.0)
+        activity.utilization = 100.0;
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryBlockDeviceQueue(const char* name, BlockDeviceQueue& queue)
+{
+    queue = BlockDeviceQueue();
+
+    unsigned long long value = 0;
+
+    if (!ReadQueueAttribute(name, "logical_block_size", value))
+        return false;
+    queue.logicalBlockSize = static_cast<unsigned int>(value);
+
+    if (ReadQueueAttribute(name, "rotational", value))
+        queue.rotational = (value != 0);
+    if (ReadQueueAttribute(name, "physical_block_size", value))
+        queue.physicalBlockSize = static_cast<unsigned int>(value);
+    if (ReadQueueAttribute(name, "optimal_io_size", value))
+        queue.optimalIOSize = value;
+    if (ReadQueueAttribute(name, "max_sectors_kb", value))
+        queue.maxIOSize = static_cast<unsigned int>(value);
+    if (ReadQueueAttribute(name, "read_ahead_kb", value))
+        queue.readAhead = static_cast<unsigned int>(value);
+    if (ReadQueueAttribute(name, "nr_requests", value))
+        queue.requests = static_cast<unsigned int>(value);
+
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/block/%s/queue/scheduler", name);
+
+    char text[128];
+    if (ReadProcFileLine(filename, text, sizeof(text)) > 0)
+        ParseScheduler(text, queue.scheduler, sizeof(queue.scheduler));
+
+    return true;
+}
+
+bool QueryBlockDevices(std::vector<BlockDevice>& devices)
+{
+    devices.clear();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/diskstats"))
+        return false;
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+
+    while (reader.NextLine(line, lineLen))
+    {
+        TextScanner scanner(line, lineLen);
+        unsigned long long major = 0, minor = 0;
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        BlockDeviceCounters counters;
+
+        if (ParseDiskStatsLine(scanner, major, minor, name, nameLen, counters) && IsWholeBlockDevice(name, nameLen))
+        {
+            BlockDevice device;
+            CopyToken(device.name, sizeof(device.name), name, nameLen);
+            device.major    = static_cast<unsigned int>(major);
+            device.minor    = static_cast<unsigned int>(minor);
+            device.physical = IsPhysicalBlockDevice(device.name);
+            QueryBlockDeviceQueue(device.name, device.queue);
+            devices.push_back(device);
+        }
+    }
+
+    return true;
+}
+
+bool QueryBlockDeviceOfPath(const char* path, char* name, std::size_t size)
+{
+    struct stat status;
+    if (stat(path, &status) != 0)
+        return false;
+
+    const unsigned int major = static_cast<unsigned int>(major(status.st_dev));
+    const unsigned int minor = static_cast<unsigned int>(minor(status.st_dev));
+
+    /* Partitions are sub-directories of their whole device, e.g. "/sys/dev/block/8:1" -> ".../block/sda/sda1" */
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "/sys/dev/block/%u:%u/partition", major, minor);
+    const bool partition = ProcFileExists(filename);
+
+    std::snprintf(filename, sizeof(filename), "/sys/dev/block/%u:%u/%suevent", major, minor, (partition ? "../" : ""));
+
+    char buffer[512];
+    const long len = ReadProcFile(filename, buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+
+    while (!scanner.AtEnd())
+    {
+        if (scanner.Accept("DEVNAME="))
+        {
+            const char* token = 0;
+            const std::size_t tokenLen = scanner.ReadToken(token);
+            if (tokenLen == 0 || tokenLen >= size)
+                return false;
+            CopyToken(name, size, token, tokenLen);
+            return true;
+        }
+        scanner.SkipLine();
+    }
+
+    return false;
+}
+
+bool QueryDiskCounters(BlockDeviceCounters& total)
+{
+    total = BlockDeviceCounters();
+
+    char buffer[4096];
+    ProcLineReader reader(buffer, sizeof(buffer));
+    if (!reader.Open("/proc/diskstats"))
+        return false;
+
+    std::lock_guard<std::mutex> lock(g_diskStatsMutex);
+
+    const char* line = 0;
+    std::size_t lineLen = 0;
+    std::size_t index = 0;
+
+    while (reader.NextLine(line, lineLen))
+    {
+        TextScanner scanner(line, lineLen);
+        unsigned long long major = 0, minor = 0;
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        BlockDeviceCounters counters;
+
+        if (ParseDiskStatsLine(scanner, major, minor, name, nameLen, counters))
+        {
+            if (IsPhysicalDiskStatsEntry(index++, major, minor, name, nameLen))
+            {
+                total.reads             += counters.reads;
+                total.readsMerged       += counters.readsMerged;
+                total.readSectors       += counters.readSectors;
+                total.readTime          += counters.readTime;
+                total.writes            += counters.writes;
+                total.writesMerged      += counters.writesMerged;
+                total.writeSectors      += counters.writeSectors;
+                total.writeTime         += counters.writeTime;
+                total.inFlight          += counters.inFlight;
+                total.ioTime            += counters.ioTime;
+                total.weightedIOTime    += counters.weightedIOTime;
+                total.discards          += counters.discards;
+                total.discardSectors    += counters.discardSectors;
+                total.flushes           += counters.flushes;
+            }
+        }
+    }
+
+    /* Drop the entries of removed devices at the end of the file */
+    if (index < g_diskStatsEntries.size())
+        g_diskStatsEntries.resize(index);
+
+    return true;
+}
+
+
+/*
+ * DiskSampler class
+ */
+
+DiskSampler::DiskSampler() :
+    fd_         ( OpenProcFile("/proc/diskstats") ),
+    timestamp_  ( 0                               )
+{
+    if (fd_ < 0 || !QueryBlockDevices(devices_))
+        return;
+
+    if (!ReserveProcFileBuffer(fd_, buffer_))
+        return;
+
+    /* Sort devices by device number, so each line of "/proc/diskstats" is matched with a binary search */
+    std::sort(devices_.begin(), devices_.end(), CompareDeviceNumber);
+
+    counters_.resize(devices_.size());
+    activity_.resize(devices_.size());
+
+    /* Take initial sample, so the first call to 'Sample' reports the activity since construction */
+    Sample();
+}
+
+DiskSampler::~DiskSampler()
+{
+    CloseProcFile(fd_);
+}
+
+bool DiskSampler::Sample()
+{
+    if (fd_ < 0 || buffer_.empty())
+        return false;
+
+    const long len = ReadProcFile(fd_, buffer_.data(), buffer_.size());
+    if (len <= 0)
+        return false;
+
+    const unsigned long long timestamp = MonotonicNanoseconds();
+    const double seconds = (timestamp_ > 0 && timestamp > timestamp_ ? static_cast<double>(timestamp - timestamp_) * 1.0e-9 : 0.0);
+
+    TextScanner scanner(buffer_.data(), static_cast<std::size_t>(len));
+
+    while (!scanner.AtEnd())
+    {
+        unsigned long long major = 0, minor = 0;
+        const char* name = 0;
+        std::size_t nameLen = 0;
+        BlockDeviceCounters counters;
+
+        if (ParseDiskStatsLine(scanner, major, minor, name, nameLen, counters))
+        {
+            BlockDevice key;
+            key.major = static_cast<unsigned int>(major);
+            key.minor = static_cast<unsigned int>(minor);
+
+            auto it = std::lower_bound(devices_.begin(), devices_.end(), key, CompareDeviceNumber);
+
+            if (it != devices_.end() && it->major == key.major && it->minor == key.minor && TokenEquals(name, nameLen, it->name))
+            {
+                const std::size_t index = static_cast<std::size_t>(it - devices_.begin());
+                if (seconds > 0.0)
+                    UpdateActivity(counters_[index], counters, seconds, activity_[index]);
+                counters_[index] = counters;
+            }
+        }
+
+        scanner.SkipLine();
+    }
+
+    timestamp_ = timestamp;
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
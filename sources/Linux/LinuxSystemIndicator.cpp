@@ -6,76 +6,528 @@
  */
 
 #include <SystemIndicator.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorTopology.h>
+#include <SystemIndicatorLimits.h>
+#include <SystemIndicatorPressure.h>
+#include <SystemIndicatorStorage.h>
+#include <SystemIndicatorNetwork.h>
+#include <SystemIndicatorProcess.h>
 #include <unistd.h>
 #include <sys/utsname.h>
-#include "../Helper.h"
+#include <cstdio>
+#include "../ProcessorInfo.h"
+#include "../Collector.h"
+#include "ProcFile.h"
 
 
 namespace SystemIndicator
 {
 
 
-static std::string QueryCompilerVersion()
+static void QueryCompilerVersion(InformationSnapshot& snapshot)
 {
     #if defined(__clang__)
 
-    return "clang " + std::string(__clang_version__);
+    snapshot.SetText(ENTRY_COMPILER, "clang " __clang_version__);
 
     #elif defined(__GNUC__)
-    
-    return "GCC " + ToString(__GNUC__) + "." + ToString(__GNUC_MINOR__) + "." + ToString(__GNUC_PATCHLEVEL__);
-    
-    #else
-    
-    return "";
-    
+
+    char version[64];
+    std::snprintf(version, sizeof(version), "GCC %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+    snapshot.SetText(ENTRY_COMPILER, version);
+
     #endif
 }
 
-static void QueryKernelInfo(std::string& version, std::string& machine)
+static void QueryKernelInfo(InformationSnapshot& snapshot)
 {
     /* Get Linux version by POSIX function 'uname' */
     utsname name;
     if (uname(&name) == 0)
     {
-        version = std::string(name.sysname) + ' ' + std::string(name.release) + " (" + std::string(name.version) + ")";
-        machine = std::string(name.machine);
+        char version[sizeof(name.sysname) + sizeof(name.release) + sizeof(name.version) + 4];
+        std::snprintf(version, sizeof(version), "%s %s (%s)", name.sysname, name.release, name.version);
+
+        snapshot.SetText(ENTRY_OS_NAME, version);
+        if (name.machine[0] != '\0')
+            snapshot.SetText(ENTRY_CPU_ARCH, name.machine);
     }
     else
+        snapshot.SetText(ENTRY_OS_NAME, "Linux");
+}
+
+static void QueryProcessorInfo(InformationSnapshot& snapshot)
+{
+    ProcessorInfo cpuInfo;
+
+    if (cpuInfo.GetName()[0] != '\0')
+        snapshot.SetText(ENTRY_CPU_NAME, cpuInfo.GetName());
+    if (cpuInfo.GetVendorName()[0] != '\0')
+        snapshot.SetText(ENTRY_CPU_VENDOR, cpuInfo.GetVendorName());
+
+    char ext[512];
+    snapshot.SetText(ENTRY_CPU_EXT, ext, cpuInfo.GetExtensions(ext, sizeof(ext)));
+}
+
+static void QueryProcessorSpeed(InformationSnapshot& snapshot)
+{
+    /* Read current frequency of the first CPU (in kHz), like the "~MHz" registry value on Windows */
+    unsigned long long frequency = 0;
+    if (ReadProcFileUInt("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", frequency) && frequency > 0)
+    {
+        snapshot.SetNumber(ENTRY_PROCESSOR_SPEED, (frequency + 500) / 1000);
+        return;
+    }
+
+    /* Fall back to the "cpu MHz" line of the first CPU in "/proc/cpuinfo"; the first block is always within the buffer */
+    char buffer[4096];
+    const long len = ReadProcFile("/proc/cpuinfo", buffer, sizeof(buffer));
+    if (len <= 0)
+        return;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+    while (!scanner.AtEnd())
     {
-        version = "Linux";
-        machine = "";
+        if (scanner.Accept("cpu MHz"))
+        {
+            double mhz = 0.0;
+            scanner.SkipSpaces();
+            if (scanner.Accept(':') && scanner.ReadReal(mhz))
+                snapshot.SetNumber(ENTRY_PROCESSOR_SPEED, static_cast<unsigned long long>(mhz + 0.5));
+            return;
+        }
+        scanner.SkipLine();
     }
 }
 
-static std::string QueryProcessorCount()
+static void QueryProcessorCount(InformationSnapshot& snapshot)
 {
-    return ToString(sysconf(_SC_NPROCESSORS_ONLN));
+    CPUTopology topology;
+    if (QueryCPUTopology(topology))
+    {
+        snapshot.SetNumber(ENTRY_PROCESSORS, topology.cores.size());
+        snapshot.SetNumber(ENTRY_LOGICAL_PROCESSORS, topology.online.Count());
+    }
+    else
+    {
+        const long count = sysconf(_SC_NPROCESSORS_ONLN);
+        if (count > 0)
+        {
+            snapshot.SetNumber(ENTRY_PROCESSORS, static_cast<unsigned long long>(count));
+            snapshot.SetNumber(ENTRY_LOGICAL_PROCESSORS, static_cast<unsigned long long>(count));
+        }
+    }
 }
 
-static void AddEntry(InformationEntryMap& entries, const InformationEntry entry, const std::string& value)
+static void QueryMemoryStatus(InformationSnapshot& snapshot)
 {
-    if (!value.empty())
-        entries[entry] = value;
+    MemoryInfo info;
+    if (!QueryMemoryInfo(info))
+        return;
+
+    static const unsigned long long divMB = 1024;
+
+    snapshot.SetNumber( ENTRY_TOTAL_MEMORY,     info.total      / divMB );
+    snapshot.SetNumber( ENTRY_FREE_MEMORY,      info.free       / divMB );
+    snapshot.SetNumber( ENTRY_AVAILABLE_MEMORY, info.available  / divMB );
+    snapshot.SetNumber( ENTRY_CACHED_MEMORY,    info.cached     / divMB );
+    snapshot.SetNumber( ENTRY_BUFFERED_MEMORY,  info.buffers    / divMB );
+    snapshot.SetNumber( ENTRY_DIRTY_MEMORY,     info.dirty      / divMB );
+    snapshot.SetNumber( ENTRY_COMMITTED_MEMORY, info.committed  / divMB );
+    snapshot.SetNumber( ENTRY_TOTAL_SWAP,       info.swapTotal  / divMB );
+    snapshot.SetNumber( ENTRY_FREE_SWAP,        info.swapFree   / divMB );
+
+    snapshot.SetNumber( ENTRY_HUGE_PAGE_SIZE,           info.hugePageSize               );
+    snapshot.SetNumber( ENTRY_HUGE_PAGES,               info.hugePages                  );
+    snapshot.SetNumber( ENTRY_FREE_HUGE_PAGES,          info.hugePagesFree              );
+    snapshot.SetNumber( ENTRY_RESERVED_HUGE_PAGES,      info.hugePagesReserved          );
+    snapshot.SetNumber( ENTRY_ANON_HUGE_PAGE_MEMORY,    info.anonHugePages  / divMB     );
 }
 
-InformationEntryMap QueryInformation()
+static void QueryHugePageModes(InformationSnapshot& snapshot)
+{
+    static const char* const modeNames[]   = { NULL, "always", "madvise", "never" };
+    static const char* const defragNames[] = { NULL, "always", "defer", "defer+madvise", "madvise", "never" };
+
+    TransparentHugePageInfo info;
+    if (!QueryTransparentHugePages(info))
+        return;
+
+    if (modeNames[info.mode] != NULL)
+        snapshot.SetText(ENTRY_TRANSPARENT_HUGE_PAGES, modeNames[info.mode]);
+    if (defragNames[info.defrag] != NULL)
+        snapshot.SetText(ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG, defragNames[info.defrag]);
+}
+
+// Returns the buddy allocator order of the default huge page size, e.g. 9 for 2 MB pages with 4 KB base pages, or -1 if huge pages are not supported.
+static int GetHugePageOrder()
+{
+    MemoryInfo memory;
+    if (!QueryMemoryInfo(memory) || memory.hugePageSize == 0)
+        return -1;
+
+    const unsigned long long basePageSize = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE)) / 1024;
+    if (basePageSize == 0)
+        return -1;
+
+    int order = 0;
+    while ((basePageSize << (order + 1)) <= memory.hugePageSize)
+        ++order;
+
+    return order;
+}
+
+static void QueryHugePageBlocks(InformationSnapshot& snapshot)
+{
+    /* The default huge page size is fixed at boot time, so the order is only determined once */
+    static const int order = GetHugePageOrder();
+    if (order < 0)
+        return;
+
+    unsigned long long availableBlocks = 0;
+    if (QueryAvailableMemoryBlocks(static_cast<unsigned int>(order), availableBlocks))
+        snapshot.SetNumber(ENTRY_FREE_HUGE_PAGE_BLOCKS, availableBlocks);
+}
+
+static void QueryEffectiveLimits(InformationSnapshot& snapshot)
+{
+    ResourceLimits limits;
+    if (!QueryResourceLimits(limits))
+        return;
+
+    snapshot.SetNumber(ENTRY_EFFECTIVE_PROCESSORS, limits.effectiveCPUs);
+    if (limits.effectiveMemory > 0)
+        snapshot.SetNumber(ENTRY_EFFECTIVE_MEMORY, limits.effectiveMemory / 1024);
+}
+
+static void QueryDiskStatistics(InformationSnapshot& snapshot)
+{
+    BlockDeviceCounters counters;
+    if (!QueryDiskCounters(counters))
+        return;
+
+    /* Sectors are always 512 bytes */
+    static const unsigned long long sectorsPerMB = 2048;
+
+    snapshot.SetNumber( ENTRY_DISK_READS,            counters.reads                          );
+    snapshot.SetNumber( ENTRY_DISK_WRITES,           counters.writes                         );
+    snapshot.SetNumber( ENTRY_DISK_BYTES_READ,       counters.readSectors    / sectorsPerMB  );
+    snapshot.SetNumber( ENTRY_DISK_BYTES_WRITTEN,    counters.writeSectors   / sectorsPerMB  );
+    snapshot.SetNumber( ENTRY_DISK_IN_FLIGHT,        counters.inFlight                       );
+    snapshot.SetNumber( ENTRY_DISK_IO_TIME,          counters.ioTime                         );
+    snapshot.SetNumber( ENTRY_DISK_WEIGHTED_IO_TIME, counters.weightedIOTime                 );
+}
+
+static void QueryRootDisk(InformationSnapshot& snapshot)
+{
+    char name[32];
+    BlockDeviceQueue queue;
+    if (!QueryBlockDeviceOfPath("/", name, sizeof(name)) || !QueryBlockDeviceQueue(name, queue))
+        return;
+
+    snapshot.SetText  ( ENTRY_ROOT_DISK,                     name                        );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_ROTATIONAL,          (queue.rotational ? 1 : 0)  );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE,  queue.logicalBlockSize      );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE, queue.physicalBlockSize     );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_MAX_IO_SIZE,         queue.maxIOSize             );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_READ_AHEAD,          queue.readAhead             );
+    snapshot.SetNumber( ENTRY_ROOT_DISK_QUEUE_REQUESTS,      queue.requests              );
+
+    if (queue.optimalIOSize > 0)
+        snapshot.SetNumber(ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE, queue.optimalIOSize);
+    if (queue.scheduler[0] != '\0')
+        snapshot.SetText(ENTRY_ROOT_DISK_SCHEDULER, queue.scheduler);
+}
+
+static void QueryNetworkTraffic(InformationSnapshot& snapshot)
+{
+    NetworkCounters counters;
+    if (!QueryNetworkCounters(counters))
+        return;
+
+    static const unsigned long long bytesPerMB = 1024ull * 1024ull;
+
+    snapshot.SetNumber( ENTRY_NETWORK_BYTES_RECEIVED,    counters.rxBytes    / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_NETWORK_BYTES_SENT,        counters.txBytes    / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_NETWORK_PACKETS_RECEIVED,  counters.rxPackets                  );
+    snapshot.SetNumber( ENTRY_NETWORK_PACKETS_SENT,      counters.txPackets                  );
+    snapshot.SetNumber( ENTRY_NETWORK_RECEIVE_ERRORS,    counters.rxErrors                   );
+    snapshot.SetNumber( ENTRY_NETWORK_SEND_ERRORS,       counters.txErrors                   );
+    snapshot.SetNumber( ENTRY_NETWORK_RECEIVE_DROPS,     counters.rxDropped                  );
+    snapshot.SetNumber( ENTRY_NETWORK_SEND_DROPS,        counters.txDropped                  );
+}
+
+static void QueryNetworkStack(InformationSnapshot& snapshot)
+{
+    NetworkStackCounters counters;
+    if (!QueryNetworkStackCounters(counters))
+        return;
+
+    static const unsigned long long pageSizeKB = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE)) / 1024;
+
+    snapshot.SetNumber( ENTRY_TCP_SEGMENTS_SENT,          counters.tcp.outSegments                );
+    snapshot.SetNumber( ENTRY_TCP_RETRANSMITTED_SEGMENTS, counters.tcp.retransmittedSegments      );
+    snapshot.SetNumber( ENTRY_TCP_LISTEN_OVERFLOWS,       counters.tcp.listenOverflows            );
+    snapshot.SetNumber( ENTRY_TCP_LISTEN_DROPS,           counters.tcp.listenDrops                );
+    snapshot.SetNumber( ENTRY_TCP_BACKLOG_DROPS,          counters.tcp.backlogDrops               );
+    snapshot.SetNumber( ENTRY_TCP_ESTABLISHED,            counters.tcp.currentEstablished         );
+    snapshot.SetNumber( ENTRY_TCP_SOCKETS,                counters.sockets.tcpInUse               );
+    snapshot.SetNumber( ENTRY_TCP_TIME_WAIT,              counters.sockets.tcpTimeWait            );
+    snapshot.SetNumber( ENTRY_TCP_MEMORY,                 counters.sockets.tcpMemory * pageSizeKB );
+    snapshot.SetNumber( ENTRY_UDP_SOCKETS,                counters.sockets.udpInUse               );
+    snapshot.SetNumber( ENTRY_UDP_MEMORY,                 counters.sockets.udpMemory * pageSizeKB );
+    snapshot.SetNumber( ENTRY_UDP_RECEIVE_BUFFER_ERRORS,  counters.udp.receiveBufferErrors        );
+    snapshot.SetNumber( ENTRY_SOCKETS,                    counters.sockets.sockets                );
+}
+
+static void QueryProcessEntries(InformationSnapshot& snapshot)
+{
+    ProcessUsage usage;
+    if (!QueryProcessUsage(usage, false))
+        return;
+
+    static const unsigned long long bytesPerMB = 1024ull * 1024ull;
+
+    snapshot.SetNumber( ENTRY_PROCESS_VIRTUAL_MEMORY,       usage.virtualMemory         / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_PROCESS_RESIDENT_MEMORY,      usage.residentMemory        / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_PROCESS_PEAK_RESIDENT_MEMORY, usage.peakResidentMemory    / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_PROCESS_SWAPPED_MEMORY,       usage.swappedMemory         / bytesPerMB    );
+    snapshot.SetNumber( ENTRY_PROCESS_MINOR_FAULTS,         usage.minorFaults                           );
+    snapshot.SetNumber( ENTRY_PROCESS_MAJOR_FAULTS,         usage.majorFaults                           );
+    snapshot.SetNumber( ENTRY_PROCESS_VOLUNTARY_SWITCHES,   usage.voluntaryContextSwitches              );
+    snapshot.SetNumber( ENTRY_PROCESS_INVOLUNTARY_SWITCHES, usage.involuntaryContextSwitches            );
+    snapshot.SetNumber( ENTRY_PROCESS_USER_TIME,            usage.userTime              / 1000          );
+    snapshot.SetNumber( ENTRY_PROCESS_SYSTEM_TIME,          usage.systemTime            / 1000          );
+    snapshot.SetNumber( ENTRY_PROCESS_THREADS,              usage.threads                               );
+}
+
+static void QueryOpenFileEntries(InformationSnapshot& snapshot)
+{
+    unsigned int count = 0;
+    if (QueryProcessOpenFiles(count))
+        snapshot.SetNumber(ENTRY_PROCESS_OPEN_FILES, count);
+}
+
+// Stores the specified stall information in the snapshot; averages are stored in 0.01 % (e.g. 1.25 % as 125).
+static void SetPressureEntries(InformationSnapshot& snapshot, const PressureStall& stall, const InformationEntry (&entries)[4])
+{
+    snapshot.SetNumber(entries[0], static_cast<unsigned long long>(stall.avg10  * 100.0 + 0.5));
+    snapshot.SetNumber(entries[1], static_cast<unsigned long long>(stall.avg60  * 100.0 + 0.5));
+    snapshot.SetNumber(entries[2], static_cast<unsigned long long>(stall.avg300 * 100.0 + 0.5));
+    snapshot.SetNumber(entries[3], stall.total);
+}
+
+static void QueryPressureEntries(InformationSnapshot& snapshot)
+{
+    static const InformationEntry cpuSome[4]    = { ENTRY_CPU_PRESSURE_SOME_AVG10,    ENTRY_CPU_PRESSURE_SOME_AVG60,    ENTRY_CPU_PRESSURE_SOME_AVG300,    ENTRY_CPU_PRESSURE_SOME_TOTAL    };
+    static const InformationEntry memorySome[4] = { ENTRY_MEMORY_PRESSURE_SOME_AVG10, ENTRY_MEMORY_PRESSURE_SOME_AVG60, ENTRY_MEMORY_PRESSURE_SOME_AVG300, ENTRY_MEMORY_PRESSURE_SOME_TOTAL };
+    static const InformationEntry memoryFull[4] = { ENTRY_MEMORY_PRESSURE_FULL_AVG10, ENTRY_MEMORY_PRESSURE_FULL_AVG60, ENTRY_MEMORY_PRESSURE_FULL_AVG300, ENTRY_MEMORY_PRESSURE_FULL_TOTAL };
+    static const InformationEntry ioSome[4]     = { ENTRY_IO_PRESSURE_SOME_AVG10,     ENTRY_IO_PRESSURE_SOME_AVG60,     ENTRY_IO_PRESSURE_SOME_AVG300,     ENTRY_IO_PRESSURE_SOME_TOTAL     };
+    static const InformationEntry ioFull[4]     = { ENTRY_IO_PRESSURE_FULL_AVG10,     ENTRY_IO_PRESSURE_FULL_AVG60,     ENTRY_IO_PRESSURE_FULL_AVG300,     ENTRY_IO_PRESSURE_FULL_TOTAL     };
+
+    PressureInfo info;
+    if (!QueryPressure(info))
+        return;
+
+    if (info.cpu.available)
+        SetPressureEntries(snapshot, info.cpu.some, cpuSome);
+
+    if (info.memory.available)
+    {
+        SetPressureEntries(snapshot, info.memory.some, memorySome);
+        SetPressureEntries(snapshot, info.memory.full, memoryFull);
+    }
+
+    if (info.io.available)
+    {
+        SetPressureEntries(snapshot, info.io.some, ioSome);
+        SetPressureEntries(snapshot, info.io.full, ioFull);
+    }
+}
+
+// Returns the data (or unified) cache of the specified level, or null if there is none.
+static const CacheInfo* FindDataCache(const std::vector<CacheInfo>& caches, unsigned int level)
+{
+    for (std::size_t i = 0; i < caches.size(); ++i)
+    {
+        if (caches[i].level == level && caches[i].type != CACHE_TYPE_INSTRUCTION)
+            return &caches[i];
+    }
+    return 0;
+}
+
+static void QueryCacheEntries(InformationSnapshot& snapshot)
+{
+    std::vector<CacheInfo> caches;
+    if (!QueryCacheInfo(caches))
+        return;
+
+    static const InformationEntry cacheEntries[3][3] =
+    {
+        { ENTRY_L1CACHES, ENTRY_L1CACHE_SIZE, ENTRY_L1CACHE_LINE_SIZE },
+        { ENTRY_L2CACHES, ENTRY_L2CACHE_SIZE, ENTRY_L2CACHE_LINE_SIZE },
+        { ENTRY_L3CACHES, ENTRY_L3CACHE_SIZE, ENTRY_L3CACHE_LINE_SIZE },
+    };
+
+    for (unsigned int level = 1; level <= 3; ++level)
+    {
+        if (const CacheInfo* cache = FindDataCache(caches, level))
+        {
+            const InformationEntry* entries = cacheEntries[level - 1];
+            if (cache->instanceCount > 0)
+                snapshot.SetNumber(entries[0], cache->instanceCount);
+            snapshot.SetNumber(entries[1], cache->size / 1024);
+            snapshot.SetNumber(entries[2], cache->lineSize);
+        }
+    }
+}
+
+static void QueryOSFamily(InformationSnapshot& snapshot)
+{
+    snapshot.SetText(ENTRY_OS_FAMILY, "LINUX");
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+static const InformationEntryCost g_processorInfoCost = ENTRY_COST_INSTRUCTION;
+#else
+static const InformationEntryCost g_processorInfoCost = ENTRY_COST_FILE_IO;
+#endif
+
+static const EntryCollector g_entryCollectors[] =
+{
+    { QueryOSFamily,        ENTRY_COST_CONSTANT     }, // ENTRY_OS_FAMILY
+    { QueryKernelInfo,      ENTRY_COST_SYSCALL      }, // ENTRY_OS_NAME
+    { QueryCompilerVersion, ENTRY_COST_CONSTANT     }, // ENTRY_COMPILER
+
+    { QueryProcessorInfo,   g_processorInfoCost     }, // ENTRY_CPU_NAME
+    { QueryProcessorInfo,   g_processorInfoCost     }, // ENTRY_CPU_VENDOR
+    { 0,                    ENTRY_COST_UNAVAILABLE  }, // ENTRY_CPU_TYPE
+    { QueryKernelInfo,      ENTRY_COST_SYSCALL      }, // ENTRY_CPU_ARCH
+    { QueryProcessorInfo,   g_processorInfoCost     }, // ENTRY_CPU_EXT
+
+    { QueryProcessorCount,  ENTRY_COST_ENUMERATION  }, // ENTRY_PROCESSORS
+    { QueryProcessorCount,  ENTRY_COST_ENUMERATION  }, // ENTRY_LOGICAL_PROCESSORS
+    { QueryProcessorSpeed,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESSOR_SPEED
+    { QueryEffectiveLimits, ENTRY_COST_ENUMERATION  }, // ENTRY_EFFECTIVE_PROCESSORS
+
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHES
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHE_SIZE
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHE_LINE_SIZE
+
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHES
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHE_SIZE
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHE_LINE_SIZE
+
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHES
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHE_SIZE
+    { QueryCacheEntries,    ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHE_LINE_SIZE
+
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_TOTAL_MEMORY
+    { QueryEffectiveLimits, ENTRY_COST_ENUMERATION  }, // ENTRY_EFFECTIVE_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_FREE_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_AVAILABLE_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_CACHED_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_BUFFERED_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_DIRTY_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_COMMITTED_MEMORY
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_TOTAL_SWAP
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_FREE_SWAP
+
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_HUGE_PAGE_SIZE
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_HUGE_PAGES
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_FREE_HUGE_PAGES
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_RESERVED_HUGE_PAGES
+    { QueryMemoryStatus,    ENTRY_COST_FILE_IO      }, // ENTRY_ANON_HUGE_PAGE_MEMORY
+    { QueryHugePageModes,   ENTRY_COST_FILE_IO      }, // ENTRY_TRANSPARENT_HUGE_PAGES
+    { QueryHugePageModes,   ENTRY_COST_FILE_IO      }, // ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG
+    { QueryHugePageBlocks,  ENTRY_COST_FILE_IO      }, // ENTRY_FREE_HUGE_PAGE_BLOCKS
+
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_READS
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_WRITES
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_BYTES_READ
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_BYTES_WRITTEN
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_IN_FLIGHT
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_IO_TIME
+    { QueryDiskStatistics,  ENTRY_COST_ENUMERATION  }, // ENTRY_DISK_WEIGHTED_IO_TIME
+
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_ROTATIONAL
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_MAX_IO_SIZE
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_READ_AHEAD
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_QUEUE_REQUESTS
+    { QueryRootDisk,        ENTRY_COST_FILE_IO      }, // ENTRY_ROOT_DISK_SCHEDULER
+
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_BYTES_RECEIVED
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_BYTES_SENT
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_PACKETS_RECEIVED
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_PACKETS_SENT
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_RECEIVE_ERRORS
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_SEND_ERRORS
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_RECEIVE_DROPS
+    { QueryNetworkTraffic,  ENTRY_COST_FILE_IO      }, // ENTRY_NETWORK_SEND_DROPS
+
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_SEGMENTS_SENT
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_RETRANSMITTED_SEGMENTS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_LISTEN_OVERFLOWS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_LISTEN_DROPS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_BACKLOG_DROPS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_ESTABLISHED
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_SOCKETS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_TIME_WAIT
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_TCP_MEMORY
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_UDP_SOCKETS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_UDP_MEMORY
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_UDP_RECEIVE_BUFFER_ERRORS
+    { QueryNetworkStack,    ENTRY_COST_FILE_IO      }, // ENTRY_SOCKETS
+
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_VIRTUAL_MEMORY
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_RESIDENT_MEMORY
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_PEAK_RESIDENT_MEMORY
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_SWAPPED_MEMORY
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_MINOR_FAULTS
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_MAJOR_FAULTS
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_VOLUNTARY_SWITCHES
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_INVOLUNTARY_SWITCHES
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_USER_TIME
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_SYSTEM_TIME
+    { QueryProcessEntries,  ENTRY_COST_FILE_IO      }, // ENTRY_PROCESS_THREADS
+    { QueryOpenFileEntries, ENTRY_COST_ENUMERATION  }, // ENTRY_PROCESS_OPEN_FILES
+
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_CPU_PRESSURE_SOME_AVG10
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_CPU_PRESSURE_SOME_AVG60
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_CPU_PRESSURE_SOME_AVG300
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_CPU_PRESSURE_SOME_TOTAL
+
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_SOME_AVG10
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_SOME_AVG60
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_SOME_AVG300
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_SOME_TOTAL
+
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_FULL_AVG10
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_FULL_AVG60
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_FULL_AVG300
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_MEMORY_PRESSURE_FULL_TOTAL
+
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_SOME_AVG10
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_SOME_AVG60
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_SOME_AVG300
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_SOME_TOTAL
+
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_FULL_AVG10
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_FULL_AVG60
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_FULL_AVG300
+    { QueryPressureEntries, ENTRY_COST_FILE_IO      }, // ENTRY_IO_PRESSURE_FULL_TOTAL
+};
+
+static_assert(sizeof(g_entryCollectors)/sizeof(g_entryCollectors[0]) == ENTRY_COUNT, "collector table must have one descriptor for each information entry");
+
+const EntryCollector* GetEntryCollectors()
 {
-    /* Query kernel information */
-    std::string version, machine;
-    QueryKernelInfo(version, machine);
-    
-    /* Setup output entries */
-    InformationEntryMap info;
-    
-    AddEntry(info, ENTRY_OS_FAMILY, "LINUX");
-    AddEntry(info, ENTRY_OS_NAME, version);
-    AddEntry(info, ENTRY_COMPILER, QueryCompilerVersion());
-    AddEntry(info, ENTRY_CPU_ARCH, machine);
-    AddEntry(info, ENTRY_PROCESSORS, QueryProcessorCount());
-    
-    
-    return info;
+    return g_entryCollectors;
 }
 
 
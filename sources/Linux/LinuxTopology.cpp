@@ -0,0 +1,591 @@
+/*
+ * LinuxTopology.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorTopology.h>
+#include <SystemIndicatorMemory.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "ProcFile.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Reads a CPU list file, e.g. "/sys/devices/system/cpu/online".
+static bool ReadCPUListFile(const char* filename, CPUSet& cpus)
+{
+    char buffer[4096];
+    const long len = ReadProcFile(filename, buffer, sizeof(buffer));
+    return (len >= 0 && cpus.Parse(buffer, static_cast<std::size_t>(len)));
+}
+
+// Returns the set of online CPUs, or all configured CPUs as fallback.
+static CPUSet QueryOnlineCPUs()
+{
+    CPUSet cpus;
+    if (!ReadCPUListFile("/sys/devices/system/cpu/online", cpus) || cpus.Empty())
+    {
+        const long count = sysconf(_SC_NPROCESSORS_ONLN);
+        cpus.Clear();
+        if (count > 0)
+            cpus.AddRange(0, static_cast<unsigned int>(count - 1));
+    }
+    return cpus;
+}
+
+// Parses a cache size, e.g. "48K" or "32M".
+static unsigned long long ParseCacheSize(const char* text)
+{
+    TextScanner scanner(text, std::strlen(text));
+
+    unsigned long long size = 0;
+    if (!scanner.ReadUInt(size))
+        return 0;
+
+    if (scanner.Accept('K'))
+        size *= 1024;
+    else if (scanner.Accept('M'))
+        size *= 1024*1024;
+    else if (scanner.Accept('G'))
+        size *= 1024*1024*1024;
+
+    return size;
+}
+
+static CacheType ParseCacheType(const char* text)
+{
+    switch (text[0])
+    {
+        case 'D': return CACHE_TYPE_DATA;
+        case 'I': return CACHE_TYPE_INSTRUCTION;
+        default:  return CACHE_TYPE_UNIFIED;
+    }
+}
+
+// Returns the sort rank of a cache: by level, then data, instruction, and unified caches.
+static unsigned int CacheRank(const CacheInfo& cache)
+{
+    const unsigned int typeRank = (cache.type == CACHE_TYPE_DATA ? 0 : cache.type == CACHE_TYPE_INSTRUCTION ? 1 : 2);
+    return cache.level * 4 + typeRank;
+}
+
+static bool CompareCacheRank(const CacheInfo& lhs, const CacheInfo& rhs)
+{
+    return (CacheRank(lhs) < CacheRank(rhs));
+}
+
+static CacheInfo& FindOrAddCache(std::vector<CacheInfo>& caches, unsigned int level, CacheType type)
+{
+    for (std::size_t i = 0; i < caches.size(); ++i)
+    {
+        if (caches[i].level == level && caches[i].type == type)
+            return caches[i];
+    }
+
+    caches.push_back(CacheInfo());
+    caches.back().level = level;
+    caches.back().type  = type;
+
+    return caches.back();
+}
+
+// Reads the cache descriptors of all CPUs from sysfs; each cache instance is only read once.
+static bool QueryCacheInfoSysfs(std::vector<CacheInfo>& caches)
+{
+    const CPUSet online = QueryOnlineCPUs();
+
+    /* CPUs whose cache of a certain index has already been read */
+    std::vector<CPUSet> covered;
+
+    char path[256];
+    char text[64];
+
+    for (int cpu = online.First(); cpu >= 0; cpu = online.Next(cpu))
+    {
+        for (unsigned int index = 0;; ++index)
+        {
+            if (index < covered.size() && covered[index].Has(static_cast<unsigned int>(cpu)))
+                continue;
+
+            int pathLen = std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%u/", cpu, index);
+            char* file = path + pathLen;
+            const std::size_t fileSize = sizeof(path) - static_cast<std::size_t>(pathLen);
+
+            /* Read cache level (stop if there are no more cache indices for this CPU) */
+            unsigned long long level = 0;
+            std::snprintf(file, fileSize, "level");
+            if (!ReadProcFileUInt(path, level))
+                break;
+
+            std::snprintf(file, fileSize, "type");
+            const CacheType type = (ReadProcFileLine(path, text, sizeof(text)) > 0 ? ParseCacheType(text) : CACHE_TYPE_UNIFIED);
+
+            CacheInfo& cache = FindOrAddCache(caches, static_cast<unsigned int>(level), type);
+
+            /* Read cache geometry */
+            unsigned long long value = 0;
+
+            std::snprintf(file, fileSize, "size");
+            if (ReadProcFileLine(path, text, sizeof(text)) > 0)
+                cache.size = ParseCacheSize(text);
+
+            std::snprintf(file, fileSize, "coherency_line_size");
+            if (ReadProcFileUInt(path, value))
+                cache.lineSize = static_cast<unsigned int>(value);
+
+            std::snprintf(file, fileSize, "ways_of_associativity");
+            if (ReadProcFileUInt(path, value))
+                cache.ways = static_cast<unsigned int>(value);
+
+            std::snprintf(file, fileSize, "number_of_sets");
+            if (ReadProcFileUInt(path, value))
+                cache.sets = static_cast<unsigned int>(value);
+
+            /* Read cache instance and the CPUs that share it */
+            CacheInstance instance;
+
+            long long id = 0;
+            std::snprintf(file, fileSize, "id");
+            if (ReadProcFileInt(path, id))
+                instance.id = static_cast<int>(id);
+
+            std::snprintf(file, fileSize, "shared_cpu_list");
+            if (!ReadCPUListFile(path, instance.cpus) || instance.cpus.Empty())
+                instance.cpus.Add(static_cast<unsigned int>(cpu));
+
+            if (index >= covered.size())
+                covered.resize(index + 1);
+            covered[index] |= instance.cpus;
+
+            cache.instances.push_back(instance);
+            cache.instanceCount = static_cast<unsigned int>(cache.instances.size());
+        }
+    }
+
+    return !caches.empty();
+}
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+
+static void AddCacheFromSysconf(std::vector<CacheInfo>& caches, unsigned int level, CacheType type, int sizeName, int assocName, int lineSizeName)
+{
+    const long size = sysconf(sizeName);
+    if (size <= 0)
+        return;
+
+    CacheInfo cache;
+    {
+        cache.level     = level;
+        cache.type      = type;
+        cache.size      = static_cast<unsigned long long>(size);
+        cache.lineSize  = static_cast<unsigned int>(std::max(0L, sysconf(lineSizeName)));
+        cache.ways      = static_cast<unsigned int>(std::max(0L, sysconf(assocName)));
+    }
+    caches.push_back(cache);
+}
+
+#endif
+
+// Fallback if sysfs is not available; this does not provide the number of instances and CPU sharing.
+static bool QueryCacheInfoSysconf(std::vector<CacheInfo>& caches)
+{
+    #ifdef _SC_LEVEL1_DCACHE_SIZE
+
+    AddCacheFromSysconf(caches, 1, CACHE_TYPE_DATA,        _SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL1_DCACHE_ASSOC, _SC_LEVEL1_DCACHE_LINESIZE);
+    AddCacheFromSysconf(caches, 1, CACHE_TYPE_INSTRUCTION, _SC_LEVEL1_ICACHE_SIZE, _SC_LEVEL1_ICACHE_ASSOC, _SC_LEVEL1_ICACHE_LINESIZE);
+    AddCacheFromSysconf(caches, 2, CACHE_TYPE_UNIFIED,     _SC_LEVEL2_CACHE_SIZE,  _SC_LEVEL2_CACHE_ASSOC,  _SC_LEVEL2_CACHE_LINESIZE );
+    AddCacheFromSysconf(caches, 3, CACHE_TYPE_UNIFIED,     _SC_LEVEL3_CACHE_SIZE,  _SC_LEVEL3_CACHE_ASSOC,  _SC_LEVEL3_CACHE_LINESIZE );
+    AddCacheFromSysconf(caches, 4, CACHE_TYPE_UNIFIED,     _SC_LEVEL4_CACHE_SIZE,  _SC_LEVEL4_CACHE_ASSOC,  _SC_LEVEL4_CACHE_LINESIZE );
+
+    #endif
+
+    return !caches.empty();
+}
+
+// Writes the path of the specified file in the topology directory of the specified CPU, e.g. "/sys/devices/system/cpu/cpu0/topology/core_id".
+static void MakeTopologyPath(char* path, std::size_t size, int cpu, const char* name)
+{
+    std::snprintf(path, size, "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+}
+
+/*
+Reads a CPU list from the topology directory of the specified CPU, or the list with the legacy name (before Linux 5.7) as fallback.
+Returns false if neither file is available.
+*/
+static bool ReadTopologyCPUList(int cpu, const char* name, const char* legacyName, CPUSet& cpus)
+{
+    char path[256];
+
+    MakeTopologyPath(path, sizeof(path), cpu, name);
+    if (ReadCPUListFile(path, cpus))
+        return true;
+
+    if (legacyName != NULL)
+    {
+        MakeTopologyPath(path, sizeof(path), cpu, legacyName);
+        if (ReadCPUListFile(path, cpus))
+            return true;
+    }
+
+    cpus.Clear();
+    return false;
+}
+
+// Reads an ID from the topology directory of the specified CPU (some platforms report -1 if the ID is unknown).
+static int ReadTopologyID(int cpu, const char* name, int defaultID)
+{
+    char path[256];
+    MakeTopologyPath(path, sizeof(path), cpu, name);
+
+    long long id = 0;
+    return (ReadProcFileInt(path, id) && id >= 0 ? static_cast<int>(id) : defaultID);
+}
+
+// Removes all CPUs from the specified set that are already assigned to a package, die, or core.
+static void RemoveAssignedCPUs(const CPUTopology& topology, int CPUTopology::LogicalCPU::*index, CPUSet& cpus)
+{
+    for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+    {
+        if (topology.cpus[cpu].*index >= 0)
+            cpus.Remove(static_cast<unsigned int>(cpu));
+    }
+}
+
+/*
+Reads the topology of all packages, dies, and cores. The CPU lists of packages and dies are read only once per package and die,
+and their members are assigned by set membership, so only the sibling list and ID of each core are read per core.
+*/
+static void QueryCoreTopology(CPUTopology& topology)
+{
+    /* Read packages ("core_siblings_list" is the name of "package_cpus_list" before Linux 5.7) */
+    for (int cpu = topology.online.First(); cpu >= 0; cpu = topology.online.Next(cpu))
+    {
+        if (topology.cpus[cpu].package >= 0)
+            continue;
+
+        CPUTopology::Package package;
+
+        if (!ReadTopologyCPUList(cpu, "package_cpus_list", "core_siblings_list", package.cpus))
+            package.cpus = topology.online;
+
+        package.cpus &= topology.online;
+        package.cpus.Add(static_cast<unsigned int>(cpu));
+        RemoveAssignedCPUs(topology, &CPUTopology::LogicalCPU::package, package.cpus);
+
+        package.id = ReadTopologyID(cpu, "physical_package_id", 0);
+
+        const int packageIndex = static_cast<int>(topology.packages.size());
+        for (int member = package.cpus.First(); member >= 0; member = package.cpus.Next(member))
+            topology.cpus[member].package = packageIndex;
+
+        topology.packages.push_back(package);
+    }
+
+    /* Read dies ("die_cpus_list" is available since Linux 5.2, otherwise each package has a single die) */
+    for (int cpu = topology.online.First(); cpu >= 0; cpu = topology.online.Next(cpu))
+    {
+        if (topology.cpus[cpu].die >= 0)
+            continue;
+
+        CPUTopology::Die die;
+        die.package = topology.cpus[cpu].package;
+
+        const CPUSet& packageCPUs = topology.packages[die.package].cpus;
+
+        if (ReadTopologyCPUList(cpu, "die_cpus_list", NULL, die.cpus))
+            die.cpus &= packageCPUs;
+        else
+            die.cpus = packageCPUs;
+
+        die.cpus.Add(static_cast<unsigned int>(cpu));
+        RemoveAssignedCPUs(topology, &CPUTopology::LogicalCPU::die, die.cpus);
+
+        die.id = ReadTopologyID(cpu, "die_id", 0);
+
+        const int dieIndex = static_cast<int>(topology.dies.size());
+        for (int member = die.cpus.First(); member >= 0; member = die.cpus.Next(member))
+            topology.cpus[member].die = dieIndex;
+
+        topology.dies.push_back(die);
+    }
+
+    /* Read cores ("thread_siblings_list" is the name of "core_cpus_list" before Linux 5.7) */
+    for (int cpu = topology.online.First(); cpu >= 0; cpu = topology.online.Next(cpu))
+    {
+        if (topology.cpus[cpu].core >= 0)
+            continue;
+
+        CPUTopology::Core core;
+        core.package    = topology.cpus[cpu].package;
+        core.die        = topology.cpus[cpu].die;
+
+        ReadTopologyCPUList(cpu, "core_cpus_list", "thread_siblings_list", core.cpus);
+
+        core.cpus &= topology.dies[core.die].cpus;
+        core.cpus.Add(static_cast<unsigned int>(cpu));
+        RemoveAssignedCPUs(topology, &CPUTopology::LogicalCPU::core, core.cpus);
+
+        core.id = ReadTopologyID(cpu, "core_id", cpu);
+
+        /* Assign all SMT siblings to this core */
+        const int coreIndex = static_cast<int>(topology.cores.size());
+        int smtIndex = 0;
+
+        for (int sibling = core.cpus.First(); sibling >= 0; sibling = core.cpus.Next(sibling))
+        {
+            CPUTopology::LogicalCPU& logicalCPU = topology.cpus[sibling];
+            logicalCPU.core     = coreIndex;
+            logicalCPU.smtIndex = smtIndex++;
+        }
+
+        topology.cores.push_back(core);
+    }
+}
+
+// Reads the IDs of all online NUMA nodes.
+static bool QueryNodeIDs(CPUSet& nodeIDs)
+{
+    return (ReadCPUListFile("/sys/devices/system/node/online", nodeIDs) && !nodeIDs.Empty());
+}
+
+// Reads the CPU list of the specified NUMA node, restricted to the specified online CPUs.
+static void QueryNodeCPUs(int id, const CPUSet& online, CPUSet& cpus)
+{
+    char path[256];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+
+    if (!ReadCPUListFile(path, cpus))
+        cpus.Clear();
+
+    cpus &= online;
+}
+
+// Reads the CPU list of each NUMA node; systems without NUMA support get a single node with all CPUs.
+static void QueryNodeTopology(CPUTopology& topology)
+{
+    CPUSet nodeIDs;
+    if (QueryNodeIDs(nodeIDs))
+    {
+        for (int id = nodeIDs.First(); id >= 0; id = nodeIDs.Next(id))
+        {
+            CPUTopology::Node node;
+            node.id = id;
+            QueryNodeCPUs(id, topology.online, node.cpus);
+            topology.nodes.push_back(node);
+        }
+    }
+
+    if (topology.nodes.empty())
+    {
+        topology.nodes.push_back(CPUTopology::Node());
+        topology.nodes.back().id    = 0;
+        topology.nodes.back().cpus  = topology.online;
+    }
+
+    for (std::size_t i = 0; i < topology.nodes.size(); ++i)
+    {
+        const CPUSet& cpus = topology.nodes[i].cpus;
+        for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+            topology.cpus[cpu].node = static_cast<int>(i);
+    }
+}
+
+// Parses the content of "/sys/devices/system/node/node<N>/meminfo" with lines like "Node 0 MemTotal:  16303412 kB".
+static bool ParseNodeMemInfo(const char* text, std::size_t length, NUMANodeInfo& node)
+{
+    TextScanner scanner(text, length);
+    unsigned int numFound = 0;
+
+    while (!scanner.AtEnd() && numFound < 3)
+    {
+        unsigned long long id = 0, value = 0;
+        const char* key = 0;
+        std::size_t keyLen = 0;
+
+        if (scanner.Accept("Node") && scanner.ReadUInt(id) && (keyLen = scanner.ReadKey(key, ':')) > 0 && scanner.ReadUInt(value))
+        {
+            if (TokenEquals(key, keyLen, "MemTotal"))
+            {
+                node.total = value;
+                ++numFound;
+            }
+            else if (TokenEquals(key, keyLen, "MemFree"))
+            {
+                node.free = value;
+                ++numFound;
+            }
+            else if (TokenEquals(key, keyLen, "FilePages"))
+            {
+                node.filePages = value;
+                ++numFound;
+            }
+        }
+
+        scanner.SkipLine();
+    }
+
+    return (node.total > 0);
+}
+
+// Reads the distances from the specified node to all nodes into the specified matrix row.
+static void QueryNodeDistances(int id, unsigned int* row, std::size_t numNodes)
+{
+    char path[256];
+    char buffer[1024];
+
+    std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/distance", id);
+    const long len = ReadProcFile(path, buffer, sizeof(buffer));
+    if (len <= 0)
+        return;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+    unsigned long long distance = 0;
+
+    for (std::size_t i = 0; i < numNodes && scanner.ReadUInt(distance); ++i)
+        row[i] = static_cast<unsigned int>(distance);
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryCacheInfo(std::vector<CacheInfo>& caches)
+{
+    caches.clear();
+
+    if (!QueryCacheInfoSysfs(caches))
+    {
+        caches.clear();
+        if (!QueryCacheInfoSysconf(caches))
+            return false;
+    }
+
+    std::sort(caches.begin(), caches.end(), CompareCacheRank);
+
+    return true;
+}
+
+bool QueryCPUTopology(CPUTopology& topology)
+{
+    topology = CPUTopology();
+
+    topology.online = QueryOnlineCPUs();
+    if (topology.online.Empty())
+        return false;
+
+    /* Allocate topology entries up to the highest online CPU */
+    topology.cpus.resize(static_cast<std::size_t>(topology.online.Last()) + 1);
+
+    QueryCoreTopology(topology);
+    QueryNodeTopology(topology);
+
+    return true;
+}
+
+bool QueryNUMAInfo(NUMAInfo& info)
+{
+    info = NUMAInfo();
+
+    const CPUSet online = QueryOnlineCPUs();
+
+    /* Read node IDs and CPU lists */
+    CPUSet nodeIDs;
+    if (QueryNodeIDs(nodeIDs))
+    {
+        for (int id = nodeIDs.First(); id >= 0; id = nodeIDs.Next(id))
+        {
+            info.nodes.push_back(NUMANodeInfo());
+            info.nodes.back().id = id;
+            QueryNodeCPUs(id, online, info.nodes.back().cpus);
+        }
+    }
+
+    if (info.nodes.empty())
+    {
+        /* Report a single node with local distance */
+        info.nodes.push_back(NUMANodeInfo());
+        info.nodes.back().id    = 0;
+        info.nodes.back().cpus  = online;
+        info.distances.resize(1, 10);
+    }
+    else
+    {
+        /* Read distance matrix */
+        const std::size_t numNodes = info.nodes.size();
+        info.distances.resize(numNodes * numNodes, 0);
+
+        for (std::size_t i = 0; i < numNodes; ++i)
+            QueryNodeDistances(info.nodes[i].id, &info.distances[i * numNodes], numNodes);
+    }
+
+    /* Build CPU-to-node mapping */
+    info.cpuNodes.resize(online.Empty() ? 0 : static_cast<std::size_t>(online.Last()) + 1, -1);
+
+    for (std::size_t i = 0; i < info.nodes.size(); ++i)
+    {
+        const CPUSet& cpus = info.nodes[i].cpus;
+        for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+        {
+            if (static_cast<std::size_t>(cpu) < info.cpuNodes.size())
+                info.cpuNodes[cpu] = static_cast<int>(i);
+        }
+    }
+
+    return QueryNUMAMemory(info);
+}
+
+bool QueryNUMAMemory(NUMAInfo& info)
+{
+    if (info.nodes.empty())
+        return false;
+
+    char path[256];
+    char buffer[8192];
+    bool result = true;
+
+    for (std::size_t i = 0; i < info.nodes.size(); ++i)
+    {
+        NUMANodeInfo& node = info.nodes[i];
+
+        std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/meminfo", node.id);
+        const long len = ReadProcFile(path, buffer, sizeof(buffer));
+
+        if (len <= 0 || !ParseNodeMemInfo(buffer, static_cast<std::size_t>(len), node))
+        {
+            if (info.nodes.size() == 1)
+            {
+                /* Use machine-wide memory status on systems without NUMA support */
+                MemoryInfo memInfo;
+                if (QueryMemoryInfo(memInfo))
+                {
+                    node.total      = memInfo.total;
+                    node.free       = memInfo.free;
+                    node.filePages  = memInfo.cached + memInfo.buffers;
+                    continue;
+                }
+            }
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,459 @@
+/*
+ * ProcFile.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProcFile.h"
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+
+namespace SystemIndicator
+{
+
+
+static char g_fileSystemRoot[256] = { 0 };
+
+// Writes the specified filename, relative to the file system root, into the specified buffer.
+static bool MakeProcFilePath(const char* filename, char* path, std::size_t size)
+{
+    const int len = std::snprintf(path, size, "%s%s", g_fileSystemRoot, filename);
+    return (len >= 0 && static_cast<std::size_t>(len) < size);
+}
+
+int OpenProcFile(const char* filename)
+{
+    if (g_fileSystemRoot[0] != '\0')
+    {
+        char path[512];
+        if (!MakeProcFilePath(filename, path, sizeof(path)))
+            return -1;
+        return open(path, O_RDONLY | O_CLOEXEC);
+    }
+    return open(filename, O_RDONLY | O_CLOEXEC);
+}
+
+bool ProcFileExists(const char* filename)
+{
+    if (g_fileSystemRoot[0] != '\0')
+    {
+        char path[512];
+        return (MakeProcFilePath(filename, path, sizeof(path)) && access(path, F_OK) == 0);
+    }
+    return (access(filename, F_OK) == 0);
+}
+
+long ReadProcFile(int fd, char* buffer, std::size_t size)
+{
+    if (size == 0)
+        return -1;
+
+    std::size_t len = 0;
+
+    while (len + 1 < size)
+    {
+        const ssize_t n = pread(fd, buffer + len, size - 1 - len, static_cast<off_t>(len));
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (n == 0)
+            break;
+
+        /*
+        Multi-record files (e.g. "/proc/diskstats" or "/proc/self/mountinfo") only return about one page per read,
+        so a short read does not mean end of file. Reading on from the current offset continues the kernel's iterator
+        and does not generate the content again, so the final empty read is cheap.
+        */
+        len += static_cast<std::size_t>(n);
+    }
+
+    buffer[len] = '\0';
+    return static_cast<long>(len);
+}
+
+long ReadProcFile(const char* filename, char* buffer, std::size_t size)
+{
+    const int fd = OpenProcFile(filename);
+    if (fd < 0)
+        return -1;
+
+    const long len = ReadProcFile(fd, buffer, size);
+    close(fd);
+
+    return len;
+}
+
+void CloseProcFile(int fd)
+{
+    if (fd >= 0)
+        close(fd);
+}
+
+bool ReserveProcFileBuffer(int fd, std::vector<char>& buffer)
+{
+    if (fd < 0)
+        return false;
+
+    /* Read the entire file once with a growing temporary buffer */
+    std::vector<char> content(64 * 1024);
+    long len = 0;
+
+    while ((len = ReadProcFile(fd, content.data(), content.size())) >= 0 && static_cast<std::size_t>(len) + 1 >= content.size())
+        content.resize(content.size() * 2);
+
+    if (len <= 0)
+        return false;
+
+    const std::size_t size = static_cast<std::size_t>(len) * 2 + 4096;
+    if (buffer.size() < size)
+        buffer.resize(size);
+
+    return true;
+}
+
+bool ReadProcFileUInt(const char* filename, unsigned long long& value)
+{
+    char buffer[32];
+    const long len = ReadProcFile(filename, buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+    return scanner.ReadUInt(value);
+}
+
+bool ReadProcFileInt(const char* filename, long long& value)
+{
+    char buffer[32];
+    const long len = ReadProcFile(filename, buffer, sizeof(buffer));
+    if (len <= 0)
+        return false;
+
+    TextScanner scanner(buffer, static_cast<std::size_t>(len));
+    return scanner.ReadInt(value);
+}
+
+long ReadProcFileLine(const char* filename, char* buffer, std::size_t size)
+{
+    long len = ReadProcFile(filename, buffer, size);
+    if (len < 0)
+        return -1;
+
+    /* Cut off text after the first line */
+    for (long i = 0; i < len; ++i)
+    {
+        if (buffer[i] == '\n')
+        {
+            buffer[i] = '\0';
+            return i;
+        }
+    }
+
+    return len;
+}
+
+void SetFileSystemRoot(const char* root)
+{
+    if (root != NULL)
+    {
+        /* Remove trailing path separators */
+        std::size_t len = std::strlen(root);
+        while (len > 0 && root[len - 1] == '/')
+            --len;
+
+        if (len < sizeof(g_fileSystemRoot))
+        {
+            std::memcpy(g_fileSystemRoot, root, len);
+            g_fileSystemRoot[len] = '\0';
+            return;
+        }
+    }
+    g_fileSystemRoot[0] = '\0';
+}
+
+const char* GetFileSystemRoot()
+{
+    return g_fileSystemRoot;
+}
+
+bool TokenEquals(const char* token, std::size_t length, const char* s)
+{
+    return (std::strncmp(token, s, length) == 0 && s[length] == '\0');
+}
+
+void CopyToken(char* dst, std::size_t dstSize, const char* token, std::size_t length)
+{
+    if (length >= dstSize)
+        length = dstSize - 1;
+    std::memcpy(dst, token, length);
+    dst[length] = '\0';
+}
+
+unsigned long long MonotonicNanoseconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long long>(ts.tv_sec) * 1000000000ull + static_cast<unsigned long long>(ts.tv_nsec);
+}
+
+
+/*
+ * ProcFile class
+ */
+
+ProcFile::ProcFile() :
+    fd_ ( -1 )
+{
+}
+
+ProcFile::~ProcFile()
+{
+    Close();
+}
+
+bool ProcFile::Open(const char* filename)
+{
+    Close();
+    fd_ = OpenProcFile(filename);
+    return (fd_ >= 0);
+}
+
+void ProcFile::Close()
+{
+    if (fd_ >= 0)
+    {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+long ProcFile::Read(char* buffer, std::size_t size)
+{
+    return (fd_ >= 0 ? ReadProcFile(fd_, buffer, size) : -1);
+}
+
+
+/*
+ * ProcLineReader class
+ */
+
+ProcLineReader::ProcLineReader(char* buffer, std::size_t size) :
+    fd_         ( -1     ),
+    buffer_     ( buffer ),
+    size_       ( size   ),
+    begin_      ( 0      ),
+    end_        ( 0      ),
+    eof_        ( false  ),
+    truncated_  ( false  )
+{
+}
+
+ProcLineReader::~ProcLineReader()
+{
+    CloseProcFile(fd_);
+}
+
+bool ProcLineReader::Open(const char* filename)
+{
+    CloseProcFile(fd_);
+    fd_         = OpenProcFile(filename);
+    begin_      = 0;
+    end_        = 0;
+    eof_        = (fd_ < 0);
+    truncated_  = false;
+    return (fd_ >= 0);
+}
+
+bool ProcLineReader::Fill()
+{
+    if (eof_)
+        return false;
+
+    if (begin_ > 0)
+    {
+        std::memmove(buffer_, buffer_ + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    while (end_ < size_)
+    {
+        const ssize_t n = read(fd_, buffer_ + end_, size_ - end_);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            eof_ = true;
+            break;
+        }
+        if (n == 0)
+        {
+            eof_ = true;
+            break;
+        }
+        end_ += static_cast<std::size_t>(n);
+
+        /* A chunk is complete as soon as it contains a line break */
+        if (std::memchr(buffer_ + end_ - n, '\n', static_cast<std::size_t>(n)) != NULL)
+            break;
+    }
+
+    return true;
+}
+
+bool ProcLineReader::NextLine(const char*& line, std::size_t& length)
+{
+    for (;;)
+    {
+        if (const char* lineEnd = static_cast<const char*>(std::memchr(buffer_ + begin_, '\n', end_ - begin_)))
+        {
+            const std::size_t lineBegin = begin_;
+            begin_ = static_cast<std::size_t>(lineEnd - buffer_) + 1;
+
+            /* Skip the rest of a truncated line */
+            if (truncated_)
+            {
+                truncated_ = false;
+                continue;
+            }
+
+            line    = buffer_ + lineBegin;
+            length  = static_cast<std::size_t>(lineEnd - line);
+            return true;
+        }
+
+        if (truncated_)
+        {
+            begin_ = end_;
+            if (!Fill())
+                return false;
+        }
+        else if (begin_ == 0 && end_ == size_)
+        {
+            /* Line does not fit into the buffer */
+            line        = buffer_;
+            length      = size_;
+            begin_      = end_;
+            truncated_  = true;
+            return true;
+        }
+        else if (!Fill())
+        {
+            /* Return the last line if the file has no trailing new-line character */
+            if (begin_ == end_)
+                return false;
+            line    = buffer_ + begin_;
+            length  = end_ - begin_;
+            begin_  = end_;
+            return true;
+        }
+    }
+}
+
+/*
+ * ProcDirectory class
+ */
+
+// Directory entry of the "getdents64" system call.
+struct LinuxDirent64
+{
+    unsigned long long  d_ino;
+    long long           d_off;
+    unsigned short      d_reclen;
+    unsigned char       d_type;
+    char                d_name[1];
+};
+
+ProcDirectory::ProcDirectory() :
+    fd_     ( -1    ),
+    ownsFd_ ( false ),
+    pos_    ( 0     ),
+    size_   ( 0     )
+{
+}
+
+ProcDirectory::~ProcDirectory()
+{
+    Close();
+}
+
+bool ProcDirectory::Open(const char* filename)
+{
+    Close();
+
+    fd_ = OpenProcFile(filename);
+    if (fd_ < 0)
+        return false;
+
+    ownsFd_ = true;
+
+    return true;
+}
+
+bool ProcDirectory::Attach(int fd)
+{
+    Close();
+
+    if (fd < 0 || lseek(fd, 0, SEEK_SET) < 0)
+        return false;
+
+    fd_ = fd;
+
+    return true;
+}
+
+void ProcDirectory::Close()
+{
+    if (fd_ >= 0 && ownsFd_)
+        close(fd_);
+
+    fd_     = -1;
+    ownsFd_ = false;
+    pos_    = 0;
+    size_   = 0;
+}
+
+const char* ProcDirectory::Next()
+{
+    if (fd_ < 0)
+        return NULL;
+
+    for (;;)
+    {
+        /* Read next chunk of entries if the buffer is exhausted */
+        if (pos_ >= size_)
+        {
+            size_   = syscall(SYS_getdents64, fd_, buffer_, sizeof(buffer_));
+            pos_    = 0;
+
+            if (size_ <= 0)
+            {
+                size_ = 0;
+                return NULL;
+            }
+        }
+
+        const LinuxDirent64* entry = reinterpret_cast<const LinuxDirent64*>(buffer_ + pos_);
+        pos_ += entry->d_reclen;
+
+        const char* name = entry->d_name;
+        if (!(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))))
+            return name;
+    }
+}
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,359 @@
+/*
+ * ProcFile.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROC_FILE_H__
+#define __SI_PROC_FILE_H__
+
+
+#include <SystemIndicator.h>
+#include <cstddef>
+#include <vector>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+Reads the entire file into the specified buffer and appends a null terminator.
+Returns the number of bytes read (without the null terminator), or -1 on failure.
+The content is truncated if the buffer is too small. This does not allocate any heap memory.
+All files in this module are opened relative to the root directory of 'SetFileSystemRoot'.
+*/
+long ReadProcFile(const char* filename, char* buffer, std::size_t size);
+
+// Opens the specified file for reading and returns its file descriptor, or -1 on failure.
+int OpenProcFile(const char* filename);
+
+// Returns true if the specified file or directory exists, e.g. "/sys/block/sda/device".
+bool ProcFileExists(const char* filename);
+
+// Reads the entire file of the specified descriptor (from offset 0) like 'ReadProcFile', until end of file or until the buffer is full.
+long ReadProcFile(int fd, char* buffer, std::size_t size);
+
+// Closes the specified file descriptor if it is valid.
+void CloseProcFile(int fd);
+
+/**
+Sizes the specified buffer for reading the file of the specified descriptor repeatedly, e.g. in the samplers.
+The file is read entirely once, and the buffer is grown to twice its length plus 4 KB, so it has enough space for larger counters and new lines.
+The buffer is never shrunk, so it can be sized for several files. Returns false if the file could not be read or is empty.
+*/
+bool ReserveProcFileBuffer(int fd, std::vector<char>& buffer);
+
+// Reads a file that contains a single unsigned decimal number, e.g. "/sys/devices/system/cpu/cpu0/topology/core_id".
+bool ReadProcFileUInt(const char* filename, unsigned long long& value);
+
+// Reads a file that contains a single signed decimal number, e.g. "/sys/devices/system/cpu/cpu0/topology/die_id".
+bool ReadProcFileInt(const char* filename, long long& value);
+
+// Reads a single line of text, e.g. "/sys/devices/system/cpu/cpu0/cache/index0/type", without the trailing new-line character.
+long ReadProcFileLine(const char* filename, char* buffer, std::size_t size);
+
+/**
+File handle for procfs and sysfs files that are read repeatedly.
+The file is kept open and each 'Read' starts at offset 0, so the kernel regenerates the content
+without the overhead of opening and closing the file for every sample.
+*/
+class ProcFile
+{
+
+    public:
+
+        ProcFile();
+        ~ProcFile();
+
+        ProcFile(const ProcFile&) = delete;
+        ProcFile& operator = (const ProcFile&) = delete;
+
+        bool Open(const char* filename);
+        void Close();
+
+        // Reads the entire file like 'ReadProcFile'.
+        long Read(char* buffer, std::size_t size);
+
+        bool IsOpen() const
+        {
+            return (fd_ >= 0);
+        }
+
+    private:
+
+        int fd_;
+
+};
+
+
+/**
+Line reader for procfs files that can be larger than any fixed buffer, e.g. "/proc/net/dev" on hosts with thousands of interfaces.
+The file is read sequentially in chunks into the specified buffer, so memory usage is bounded and no heap memory is allocated.
+Lines that do not fit into the buffer are truncated.
+*/
+class ProcLineReader
+{
+
+    public:
+
+        ProcLineReader(char* buffer, std::size_t size);
+        ~ProcLineReader();
+
+        ProcLineReader(const ProcLineReader&) = delete;
+        ProcLineReader& operator = (const ProcLineReader&) = delete;
+
+        bool Open(const char* filename);
+
+        // Returns the next line without the trailing new-line character, or false at the end of the file.
+        bool NextLine(const char*& line, std::size_t& length);
+
+    private:
+
+        // Moves the unread characters to the front of the buffer and appends the next chunk of the file.
+        bool Fill();
+
+        int         fd_;
+        char*       buffer_;
+        std::size_t size_;
+        std::size_t begin_;
+        std::size_t end_;
+        bool        eof_;
+        bool        truncated_;
+
+};
+
+/**
+Directory handle for procfs and sysfs directories, e.g. "/sys/class/net".
+The directory is opened relative to the root directory of 'SetFileSystemRoot'. The entries "." and ".." are skipped.
+Entries are read with the "getdents64" system call into an internal buffer, so enumerating a directory does not allocate any heap memory.
+*/
+class ProcDirectory
+{
+
+    public:
+
+        ProcDirectory();
+        ~ProcDirectory();
+
+        ProcDirectory(const ProcDirectory&) = delete;
+        ProcDirectory& operator = (const ProcDirectory&) = delete;
+
+        bool Open(const char* filename);
+
+        /**
+        Enumerates the directory of the specified file descriptor (e.g. from 'OpenProcFile'), which is kept open on 'Close'.
+        The directory is rewound first, so a procfs directory that is kept open is regenerated.
+        */
+        bool Attach(int fd);
+
+        void Close();
+
+        // Returns the name of the next directory entry, or null at the end of the directory.
+        const char* Next();
+
+        bool IsOpen() const
+        {
+            return (fd_ >= 0);
+        }
+
+    private:
+
+        int         fd_;
+        bool        ownsFd_;
+        long        pos_;
+        long        size_;
+        alignas(8) char buffer_[4096];
+
+};
+
+
+/**
+Minimal scanner for the text formats in procfs and sysfs, e.g. "MemTotal:  16303412 kB".
+It works directly on the file buffer, so parsing does not allocate any heap memory.
+*/
+class TextScanner
+{
+
+    public:
+
+        TextScanner(const char* text, std::size_t length) :
+            pos_ ( text          ),
+            end_ ( text + length )
+        {
+        }
+
+        bool AtEnd() const
+        {
+            return (pos_ >= end_);
+        }
+
+        const char* Position() const
+        {
+            return pos_;
+        }
+
+        // Skips spaces and tabs, but not new-line characters.
+        void SkipSpaces()
+        {
+            while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\t'))
+                ++pos_;
+        }
+
+        // Skips all characters up to and including the next new-line character.
+        void SkipLine()
+        {
+            while (pos_ < end_ && *pos_ != '\n')
+                ++pos_;
+            if (pos_ < end_)
+                ++pos_;
+        }
+
+        // Returns true if the scanner is at the end of the current line (after skipping spaces).
+        bool AtEndOfLine()
+        {
+            SkipSpaces();
+            return (pos_ >= end_ || *pos_ == '\n');
+        }
+
+        // Skips the specified character if it is the next one.
+        bool Accept(char c)
+        {
+            if (pos_ < end_ && *pos_ == c)
+            {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        // Skips the specified string if it is the next one.
+        bool Accept(const char* s)
+        {
+            const char* p = pos_;
+            while (*s != '\0')
+            {
+                if (p >= end_ || *p != *s)
+                    return false;
+                ++p;
+                ++s;
+            }
+            pos_ = p;
+            return true;
+        }
+
+        // Reads an unsigned decimal number after skipping leading spaces.
+        bool ReadUInt(unsigned long long& value)
+        {
+            SkipSpaces();
+
+            if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9')
+                return false;
+
+            unsigned long long n = 0;
+            while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9')
+                n = n*10 + static_cast<unsigned long long>(*pos_++ - '0');
+
+            value = n;
+            return true;
+        }
+
+        // Reads a signed decimal number after skipping leading spaces.
+        bool ReadInt(long long& value)
+        {
+            SkipSpaces();
+
+            const bool negative = Accept('-');
+
+            unsigned long long n = 0;
+            if (!ReadUInt(n))
+                return false;
+
+            value = (negative ? -static_cast<long long>(n) : static_cast<long long>(n));
+            return true;
+        }
+
+        // Reads a decimal number with an optional fraction (e.g. "0.25") after skipping leading spaces.
+        bool ReadReal(double& value)
+        {
+            unsigned long long integral = 0;
+            if (!ReadUInt(integral))
+                return false;
+
+            double n = static_cast<double>(integral);
+
+            if (Accept('.'))
+            {
+                double scale = 0.1;
+                while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9')
+                {
+                    n += scale * (*pos_++ - '0');
+                    scale *= 0.1;
+                }
+            }
+
+            value = n;
+            return true;
+        }
+
+        // Reads the next token that is delimited by white spaces and returns its length (0 at the end of the line).
+        std::size_t ReadToken(const char*& token)
+        {
+            SkipSpaces();
+            token = pos_;
+            while (pos_ < end_ && *pos_ != ' ' && *pos_ != '\t' && *pos_ != '\n')
+                ++pos_;
+            return static_cast<std::size_t>(pos_ - token);
+        }
+
+        /*
+        Reads all characters up to the specified delimiter (which is skipped) within the current line.
+        Returns the length of the key, or 0 if the delimiter was not found.
+        */
+        std::size_t ReadKey(const char*& key, char delimiter)
+        {
+            SkipSpaces();
+            const char* start = pos_;
+            while (pos_ < end_ && *pos_ != delimiter && *pos_ != '\n')
+                ++pos_;
+
+            if (pos_ >= end_ || *pos_ != delimiter)
+                return 0;
+
+            key = start;
+            return static_cast<std::size_t>(pos_++ - start);
+        }
+
+    private:
+
+        const char* pos_;
+        const char* end_;
+
+};
+
+
+// Returns true if the specified token (not null-terminated) equals the specified null-terminated string.
+bool TokenEquals(const char* token, std::size_t length, const char* s);
+
+// Copies the specified token (not null-terminated) into the specified string, truncated to the string size.
+void CopyToken(char* dst, std::size_t dstSize, const char* token, std::size_t length);
+
+// Returns the time of the monotonic clock in nanoseconds, which is the time base of all samplers.
+unsigned long long MonotonicNanoseconds();
+
+// Returns the difference of two cumulative counters, or 0 if the counter was reset (e.g. on 32-bit overflow or when a driver is reloaded).
+inline double CounterDelta(unsigned long long current, unsigned long long previous)
+{
+    return (current >= previous ? static_cast<double>(current - previous) : 0.0);
+}
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
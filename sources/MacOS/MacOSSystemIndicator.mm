@@ -6,20 +6,361 @@
  */
 
 #include <SystemIndicator.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorTopology.h>
+#include <SystemIndicatorPlacement.h>
+#include <SystemIndicatorLimits.h>
+#include <SystemIndicatorSampler.h>
+#include <SystemIndicatorFrequency.h>
+#include <SystemIndicatorProfileCache.h>
+#include <SystemIndicatorPressure.h>
+#include <SystemIndicatorStorage.h>
+#include <SystemIndicatorNetwork.h>
+#include <SystemIndicatorProcess.h>
+#include <algorithm>
+#include "../Collector.h"
 
 
 namespace SystemIndicator
 {
 
 
-InformationEntryMap QueryInformation()
+static void QueryOSFamily(InformationSnapshot& snapshot)
 {
-    /* Setup output entries */
-    InformationEntryMap info;
+    snapshot.SetText(ENTRY_OS_FAMILY, "MACOS");
+}
+
+bool QueryMemoryInfo(MemoryInfo& info)
+{
+    /* Not available yet */
+    info = MemoryInfo();
+    return false;
+}
+
+bool QueryHugePageInfo(HugePageInfo& info)
+{
+    /* Not available yet */
+    info = HugePageInfo();
+    return false;
+}
+
+bool QueryTransparentHugePages(TransparentHugePageInfo& info)
+{
+    /* Transparent huge pages are not supported on MacOS */
+    info = TransparentHugePageInfo();
+    return false;
+}
+
+bool QueryMemoryFragmentation(MemoryFragmentation& fragmentation)
+{
+    /* Not available yet */
+    fragmentation.zones.clear();
+    return false;
+}
+
+bool QueryAvailableMemoryBlocks(unsigned int order, unsigned long long& blocks)
+{
+    /* Not available yet */
+    blocks = 0;
+    return false;
+}
+
+void SetFileSystemRoot(const char* root)
+{
+    /* Only used for procfs and sysfs on Linux */
+}
+
+const char* GetFileSystemRoot()
+{
+    return "";
+}
+
+bool QueryCacheInfo(std::vector<CacheInfo>& caches)
+{
+    /* Not available yet */
+    caches.clear();
+    return false;
+}
+
+bool QueryCPUTopology(CPUTopology& topology)
+{
+    /* Not available yet */
+    topology = CPUTopology();
+    return false;
+}
+
+bool QueryNUMAInfo(NUMAInfo& info)
+{
+    /* Not available yet */
+    info = NUMAInfo();
+    return false;
+}
+
+bool QueryNUMAMemory(NUMAInfo& info)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool QueryResourceLimits(ResourceLimits& limits)
+{
+    /* Not available yet */
+    limits = ResourceLimits();
+    return false;
+}
+
+bool QueryCPUFrequencies(std::vector<CPUFrequency>& frequencies)
+{
+    /* Not available yet */
+    return false;
+}
 
-    info[ ENTRY_OS_FAMILY ] = "MACOS";
+bool ReadRawMonotonicClock(unsigned long long& ns)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool GetDefaultProfileCachePath(char* buffer, std::size_t size)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool SaveHardwareProfile(const char* filename, const InformationSnapshot& profile)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool LoadHardwareProfile(const char* filename, InformationSnapshot& profile)
+{
+    /* Not available yet */
+    return false;
+}
+
+CPUSampler::CPUSampler() :
+    fd_ ( -1 )
+{
+    std::fill(totalCounters_, totalCounters_ + numCounters, 0ull);
+}
+
+CPUSampler::~CPUSampler()
+{
+}
+
+bool CPUSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
 
-    return info;
+bool QueryBlockDevices(std::vector<BlockDevice>& devices)
+{
+    /* Not available yet */
+    devices.clear();
+    return false;
+}
+
+bool QueryBlockDeviceQueue(const char* name, BlockDeviceQueue& queue)
+{
+    /* Not available yet */
+    queue = BlockDeviceQueue();
+    return false;
+}
+
+bool QueryBlockDeviceOfPath(const char* path, char* name, std::size_t size)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool QueryDiskCounters(BlockDeviceCounters& total)
+{
+    /* Not available yet */
+    total = BlockDeviceCounters();
+    return false;
+}
+
+DiskSampler::DiskSampler() :
+    fd_         ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+DiskSampler::~DiskSampler()
+{
+}
+
+bool DiskSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+bool QueryNetworkInterfaces(std::vector<NetworkInterface>& interfaces)
+{
+    /* Not available yet */
+    interfaces.clear();
+    return false;
+}
+
+bool QueryNetworkInterface(const char* name, NetworkInterface& networkInterface)
+{
+    /* Not available yet */
+    networkInterface = NetworkInterface();
+    return false;
+}
+
+bool QueryNetworkInterfaceCounters(const char* name, NetworkCounters& counters)
+{
+    /* Not available yet */
+    counters = NetworkCounters();
+    return false;
+}
+
+bool QueryNetworkCounters(NetworkCounters& total)
+{
+    /* Not available yet */
+    total = NetworkCounters();
+    return false;
+}
+
+bool QueryNetworkStackCounters(NetworkStackCounters& counters)
+{
+    /* Not available yet */
+    counters = NetworkStackCounters();
+    return false;
+}
+
+NetworkSampler::NetworkSampler() :
+    fd_         ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+NetworkSampler::~NetworkSampler()
+{
+}
+
+bool NetworkSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+NetworkStackSampler::NetworkStackSampler() :
+    timestamp_  ( 0   ),
+    interval_   ( 0.0 )
+{
+    fds_[0] = fds_[1] = fds_[2] = -1;
+}
+
+NetworkStackSampler::~NetworkStackSampler()
+{
+}
+
+bool NetworkStackSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+bool QueryProcessUsage(ProcessUsage& usage, bool countOpenFiles)
+{
+    /* Not available yet */
+    usage = ProcessUsage();
+    return false;
+}
+
+bool QueryProcessOpenFiles(unsigned int& count)
+{
+    /* Not available yet */
+    count = 0;
+    return false;
+}
+
+bool QueryProcessMemoryDetails(ProcessMemoryDetails& details)
+{
+    /* Not available yet */
+    details = ProcessMemoryDetails();
+    return false;
+}
+
+ProcessSampler::ProcessSampler() :
+    statmFd_    ( -1 ),
+    statusFd_   ( -1 ),
+    taskDirFd_  ( -1 ),
+    fdDirFd_    ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+ProcessSampler::~ProcessSampler()
+{
+}
+
+bool ProcessSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+PressureMonitor::PressureMonitor()
+{
+    fds_[0] = fds_[1] = fds_[2] = -1;
+}
+
+PressureMonitor::~PressureMonitor()
+{
+}
+
+bool PressureMonitor::Open(const PressureScope scope)
+{
+    /* Pressure stall information is not supported on MacOS */
+    return false;
+}
+
+void PressureMonitor::Close()
+{
+}
+
+bool PressureMonitor::Read(PressureInfo& info)
+{
+    /* Pressure stall information is not supported on MacOS */
+    info = PressureInfo();
+    return false;
+}
+
+bool SetThreadAffinity(const CPUSet& cpus)
+{
+    /* Thread affinity is not supported on MacOS */
+    return false;
+}
+
+bool GetThreadAffinity(CPUSet& cpus)
+{
+    /* Thread affinity is not supported on MacOS */
+    cpus.Clear();
+    return false;
+}
+
+bool GetProcessAffinity(CPUSet& cpus)
+{
+    /* Thread affinity is not supported on MacOS */
+    cpus.Clear();
+    return false;
+}
+
+// Only ENTRY_OS_FAMILY (the first entry) is available yet, all other entries are zero initialized (i.e. unavailable).
+static const EntryCollector g_entryCollectors[ENTRY_COUNT] =
+{
+    { QueryOSFamily, ENTRY_COST_CONSTANT }, // ENTRY_OS_FAMILY
+};
+
+const EntryCollector* GetEntryCollectors()
+{
+    return g_entryCollectors;
 }
 
 
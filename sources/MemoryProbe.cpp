@@ -0,0 +1,376 @@
+/*
+ * MemoryProbe.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorProbe.h>
+#include <SystemIndicatorPlacement.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <random>
+#include <thread>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal constants and types
+ */
+
+typedef std::chrono::steady_clock Clock;
+
+// Size of the nodes for pointer chasing; each node is a separate cache line.
+static const std::size_t        g_nodeSize          = 64;
+
+// Number of dependent loads per latency measurement.
+static const std::size_t        g_numLoads          = 1u << 21;
+
+// Number of passes per bandwidth measurement; the fastest pass is used.
+static const unsigned int       g_numPasses         = 3;
+
+static const unsigned long long g_minWorkingSet     = 4096;
+
+// Prevents the compiler from optimizing away the measured kernels.
+static volatile unsigned long long g_probeSink = 0;
+
+
+/*
+ * Internal functions
+ */
+
+static double ElapsedSeconds(const Clock::time_point& start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*
+Builds a single random cycle over all nodes of the buffer (Sattolo's algorithm), where each node stores a pointer to the next node.
+The buffer must be aligned to 'g_nodeSize'.
+*/
+static void BuildPointerChain(char* buffer, std::size_t numNodes, std::mt19937& random)
+{
+    std::vector<std::size_t> order(numNodes);
+    for (std::size_t i = 0; i < numNodes; ++i)
+        order[i] = i;
+
+    for (std::size_t i = numNodes - 1; i > 0; --i)
+    {
+        std::uniform_int_distribution<std::size_t> dist(0, i - 1);
+        std::swap(order[i], order[dist(random)]);
+    }
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        char* node = buffer + order[i] * g_nodeSize;
+        char* next = buffer + order[(i + 1) % numNodes] * g_nodeSize;
+        std::memcpy(node, &next, sizeof(next));
+    }
+}
+
+// Follows the pointer chain for the specified number of loads (multiple of 8) and returns the last node.
+static void* ChasePointers(void* node, std::size_t numLoads)
+{
+    void** p = reinterpret_cast<void**>(node);
+
+    for (std::size_t i = 0; i < numLoads; i += 8)
+    {
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+        p = reinterpret_cast<void**>(*p);
+    }
+
+    return p;
+}
+
+// Measures the average latency (in nanoseconds) of a dependent load within the specified working set. Returns a negative value on failure.
+static double MeasureLatency(unsigned long long workingSet, std::mt19937& random)
+{
+    const std::size_t numNodes = static_cast<std::size_t>(std::max(workingSet, g_minWorkingSet) / g_nodeSize);
+
+    std::vector<char> storage;
+    try
+    {
+        storage.resize(numNodes * g_nodeSize + g_nodeSize);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return -1.0;
+    }
+
+    /* Align the nodes to cache lines */
+    char* buffer = storage.data();
+    buffer += (g_nodeSize - reinterpret_cast<std::size_t>(buffer) % g_nodeSize) % g_nodeSize;
+
+    BuildPointerChain(buffer, numNodes, random);
+
+    /* Warm up caches and TLB with one pass over the entire chain */
+    void* node = ChasePointers(buffer, std::min(numNodes, g_numLoads) & ~static_cast<std::size_t>(7));
+
+    const Clock::time_point start = Clock::now();
+    node = ChasePointers(node, g_numLoads);
+    const double seconds = ElapsedSeconds(start);
+
+    g_probeSink += reinterpret_cast<std::size_t>(node);
+
+    return seconds * 1.0e9 / g_numLoads;
+}
+
+enum BandwidthKernel
+{
+    KERNEL_READ,
+    KERNEL_WRITE,
+    KERNEL_COPY,
+};
+
+// Runs the specified kernel over the arrays and returns the number of bytes that were transferred.
+static unsigned long long RunKernel(BandwidthKernel kernel, unsigned long long* src, unsigned long long* dst, std::size_t count)
+{
+    switch (kernel)
+    {
+        case KERNEL_READ:
+        {
+            unsigned long long sum = 0;
+            for (std::size_t i = 0; i < count; ++i)
+                sum += src[i];
+            g_probeSink += sum;
+            return count * sizeof(unsigned long long);
+        }
+
+        case KERNEL_WRITE:
+        {
+            const unsigned long long value = g_probeSink;
+            for (std::size_t i = 0; i < count; ++i)
+                dst[i] = value;
+            return count * sizeof(unsigned long long);
+        }
+
+        case KERNEL_COPY:
+        {
+            std::memcpy(dst, src, count * sizeof(unsigned long long));
+            return count * sizeof(unsigned long long) * 2;
+        }
+    }
+
+    return 0;
+}
+
+// Worker of the multi-threaded bandwidth measurement.
+static void RunBandwidthWorker(
+    const CPUSet* mask, BandwidthKernel kernel, std::size_t count,
+    std::atomic<unsigned int>& ready, std::atomic<bool>& start, std::atomic<unsigned long long>& bytes)
+{
+    if (mask != NULL)
+        SetThreadAffinity(*mask);
+
+    /* Allocate arrays after pinning, so the pages are allocated on the local NUMA node */
+    std::vector<unsigned long long> src, dst;
+    try
+    {
+        src.resize(count, 1);
+        dst.resize(count, 0);
+    }
+    catch (const std::bad_alloc&)
+    {
+        ++ready;
+        return;
+    }
+
+    ++ready;
+    while (!start.load())
+        std::this_thread::yield();
+
+    unsigned long long transferred = 0;
+    for (unsigned int pass = 0; pass < g_numPasses; ++pass)
+        transferred += RunKernel(kernel, src.data(), dst.data(), count);
+
+    bytes += transferred;
+}
+
+// Measures the total bandwidth (in GB/s) of the specified kernel with one thread for each affinity mask (or a single unpinned thread).
+static double MeasureBandwidth(BandwidthKernel kernel, const std::vector<CPUSet>& masks, std::size_t threads, std::size_t count)
+{
+    std::atomic<unsigned int> ready(0);
+    std::atomic<bool> start(false);
+    std::atomic<unsigned long long> bytes(0);
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        const CPUSet* mask = (i < masks.size() ? &masks[i] : NULL);
+        workers.push_back(std::thread(RunBandwidthWorker, mask, kernel, count, std::ref(ready), std::ref(start), std::ref(bytes)));
+    }
+
+    while (ready.load() < threads)
+        std::this_thread::yield();
+
+    const Clock::time_point startTime = Clock::now();
+
+    start = true;
+    for (std::thread& worker : workers)
+        worker.join();
+
+    return static_cast<double>(bytes.load()) / ElapsedSeconds(startTime) * 1.0e-9;
+}
+
+// Measures the single-threaded bandwidth (in GB/s) of the specified kernel; the fastest pass is used.
+static double MeasureSingleBandwidth(BandwidthKernel kernel, unsigned long long* src, unsigned long long* dst, std::size_t count)
+{
+    /* Warm up pages */
+    RunKernel(kernel, src, dst, count);
+
+    double best = 0.0;
+
+    for (unsigned int pass = 0; pass < g_numPasses; ++pass)
+    {
+        const Clock::time_point start = Clock::now();
+        const unsigned long long bytes = RunKernel(kernel, src, dst, count);
+        best = std::max(best, static_cast<double>(bytes) / ElapsedSeconds(start) * 1.0e-9);
+    }
+
+    return best;
+}
+
+// Returns the nominal size (in bytes) of the data or unified cache of the specified level, or 0 if there is no such cache.
+static unsigned long long GetNominalCacheSize(const std::vector<CacheInfo>& caches, unsigned int level)
+{
+    for (const CacheInfo& cache : caches)
+    {
+        if (cache.level == level && cache.type != CACHE_TYPE_INSTRUCTION)
+            return cache.size;
+    }
+    return 0;
+}
+
+static bool MeasureLatencies(MemoryProbe& probe, const MemoryProbeConfig& config, std::mt19937& random)
+{
+    std::vector<CacheInfo> caches;
+    QueryCacheInfo(caches);
+
+    /* Measure each cache level with half of its nominal size, as long as it is larger than the previous level */
+    unsigned long long prevSize = 0;
+
+    for (unsigned int level = 1; level <= 3; ++level)
+    {
+        const unsigned long long size = GetNominalCacheSize(caches, level);
+        if (size == 0 || size <= prevSize || size / 2 > config.maxWorkingSet)
+            continue;
+
+        MemoryLevelLatency entry;
+        entry.level         = level;
+        entry.nominalSize   = size;
+        entry.workingSet    = std::max(size / 2, prevSize);
+        entry.latency       = MeasureLatency(entry.workingSet, random);
+
+        if (entry.latency < 0.0)
+            return false;
+
+        probe.levels.push_back(entry);
+        prevSize = size;
+    }
+
+    /* Measure main memory with the largest working set */
+    MemoryLevelLatency dram;
+    dram.workingSet = config.maxWorkingSet;
+    dram.latency    = MeasureLatency(dram.workingSet, random);
+
+    if (dram.latency < 0.0)
+        return false;
+
+    probe.levels.push_back(dram);
+
+    /* Measure latency curve */
+    if (config.latencyCurve)
+    {
+        for (unsigned long long size = g_minWorkingSet; size <= config.maxWorkingSet; size *= 2)
+        {
+            LatencySample sample;
+            sample.workingSet   = size;
+            sample.latency      = MeasureLatency(size, random);
+
+            if (sample.latency < 0.0)
+                return false;
+
+            probe.latencyCurve.push_back(sample);
+        }
+    }
+
+    return true;
+}
+
+static bool MeasureBandwidths(MemoryProbe& probe, const MemoryProbeConfig& config)
+{
+    /* Measure single-threaded bandwidth */
+    const std::size_t count = static_cast<std::size_t>(std::max(config.bandwidthSize, g_minWorkingSet) / sizeof(unsigned long long));
+
+    try
+    {
+        std::vector<unsigned long long> src(count, 1), dst(count, 0);
+
+        probe.singleThread.read     = MeasureSingleBandwidth(KERNEL_READ,  src.data(), dst.data(), count);
+        probe.singleThread.write    = MeasureSingleBandwidth(KERNEL_WRITE, src.data(), dst.data(), count);
+        probe.singleThread.copy     = MeasureSingleBandwidth(KERNEL_COPY,  src.data(), dst.data(), count);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+
+    /* Measure multi-threaded bandwidth with one thread per core first, then SMT siblings */
+    unsigned int threads = config.threads;
+    if (threads == 0)
+    {
+        CPUSet affinity;
+        threads = (GetProcessAffinity(affinity) ? affinity.Count() : std::thread::hardware_concurrency());
+    }
+    threads = std::max(threads, 1u);
+
+    PlacementRequest request;
+    request.workers = threads;
+    request.policy  = PLACEMENT_ONE_PER_CORE;
+
+    std::vector<CPUSet> masks;
+    PlanThreadPlacement(request, masks);
+
+    const std::size_t threadCount = std::max<std::size_t>(count / threads, g_minWorkingSet / sizeof(unsigned long long));
+
+    probe.threads               = threads;
+    probe.allThreads.read       = MeasureBandwidth(KERNEL_READ,  masks, threads, threadCount);
+    probe.allThreads.write      = MeasureBandwidth(KERNEL_WRITE, masks, threads, threadCount);
+    probe.allThreads.copy       = MeasureBandwidth(KERNEL_COPY,  masks, threads, threadCount);
+
+    return true;
+}
+
+
+/*
+ * Global functions
+ */
+
+bool MeasureMemoryHierarchy(MemoryProbe& probe, const MemoryProbeConfig& config)
+{
+    probe = MemoryProbe();
+
+    /* Use a fixed seed, so the pointer chains are reproducible between runs */
+    std::mt19937 random(0x5eed);
+
+    return (MeasureLatencies(probe, config, random) && MeasureBandwidths(probe, config));
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
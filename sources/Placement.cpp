@@ -0,0 +1,254 @@
+/*
+ * Placement.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorPlacement.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+/*
+Appends all CPUs of the specified domain in SMT-last order to the output list, i.e. the first
+allowed SMT sibling of every core, then the second sibling of every core, and so on.
+*/
+static void AppendSMTLastOrder(const CPUTopology& topology, const CPUSet& domain, std::vector<int>& cpus)
+{
+    for (int smtIndex = 0;; ++smtIndex)
+    {
+        bool anyAdded = false;
+
+        for (std::size_t i = 0; i < topology.cores.size(); ++i)
+        {
+            const CPUSet& siblings = topology.cores[i].cpus;
+
+            /* Find the n-th sibling of this core within the domain */
+            int n = 0;
+            for (int cpu = siblings.First(); cpu >= 0; cpu = siblings.Next(cpu))
+            {
+                if (domain.Has(static_cast<unsigned int>(cpu)) && n++ == smtIndex)
+                {
+                    cpus.push_back(cpu);
+                    anyAdded = true;
+                    break;
+                }
+            }
+        }
+
+        if (!anyAdded)
+            break;
+    }
+}
+
+static CPUSet MakeSingleCPUSet(int cpu)
+{
+    CPUSet cpus;
+    cpus.Add(static_cast<unsigned int>(cpu));
+    return cpus;
+}
+
+// Assigns one CPU of the specified order to each worker and wraps around if there are more workers than CPUs.
+static bool AssignCPUs(const std::vector<int>& order, unsigned int workers, std::vector<CPUSet>& masks)
+{
+    if (order.empty())
+        return false;
+
+    for (unsigned int i = 0; i < workers; ++i)
+        masks.push_back(MakeSingleCPUSet(order[i % order.size()]));
+
+    return true;
+}
+
+static bool PlanOnePerCore(const CPUTopology& topology, const CPUSet& allowed, unsigned int workers, std::vector<CPUSet>& masks)
+{
+    std::vector<CPUSet> cores;
+
+    for (std::size_t i = 0; i < topology.cores.size(); ++i)
+    {
+        CPUSet cpus = topology.cores[i].cpus;
+        cpus &= allowed;
+        if (!cpus.Empty())
+            cores.push_back(cpus);
+    }
+
+    if (cores.empty())
+        return false;
+
+    for (unsigned int i = 0; i < workers; ++i)
+        masks.push_back(cores[i % cores.size()]);
+
+    return true;
+}
+
+static bool PlanSMTLast(const CPUTopology& topology, const CPUSet& allowed, unsigned int workers, std::vector<CPUSet>& masks)
+{
+    std::vector<int> order;
+    AppendSMTLastOrder(topology, allowed, order);
+    return AssignCPUs(order, workers, masks);
+}
+
+static bool PlanSpreadL3(const CPUTopology& topology, const std::vector<CacheInfo>& caches, const CPUSet& allowed, unsigned int workers, std::vector<CPUSet>& masks)
+{
+    /* Collect L3 cache domains, or packages if there is no L3 cache with CPU sharing information */
+    std::vector<CPUSet> domains;
+
+    for (std::size_t i = 0; i < caches.size(); ++i)
+    {
+        if (caches[i].level == 3 && caches[i].type != CACHE_TYPE_INSTRUCTION)
+        {
+            for (std::size_t j = 0; j < caches[i].instances.size(); ++j)
+                domains.push_back(caches[i].instances[j].cpus);
+        }
+    }
+
+    if (domains.empty())
+    {
+        for (std::size_t i = 0; i < topology.packages.size(); ++i)
+            domains.push_back(topology.packages[i].cpus);
+    }
+
+    /* Order the CPUs of each domain with SMT siblings last */
+    std::vector<std::vector<int>> orders;
+
+    for (std::size_t i = 0; i < domains.size(); ++i)
+    {
+        domains[i] &= allowed;
+
+        std::vector<int> order;
+        AppendSMTLastOrder(topology, domains[i], order);
+
+        if (!order.empty())
+            orders.push_back(order);
+    }
+
+    if (orders.empty())
+        return PlanSMTLast(topology, allowed, workers, masks);
+
+    /* Distribute workers round-robin across all domains */
+    for (unsigned int i = 0; i < workers; ++i)
+    {
+        const std::vector<int>& order = orders[i % orders.size()];
+        const std::size_t round = i / orders.size();
+        masks.push_back(MakeSingleCPUSet(order[round % order.size()]));
+    }
+
+    return true;
+}
+
+static bool PlanCompactNode(const CPUTopology& topology, const CPUSet& allowed, int node, unsigned int workers, std::vector<CPUSet>& masks)
+{
+    if (node < 0)
+    {
+        /* Select the node with the most allowed CPUs */
+        std::size_t maxCount = 0;
+
+        for (std::size_t i = 0; i < topology.nodes.size(); ++i)
+        {
+            CPUSet cpus = topology.nodes[i].cpus;
+            cpus &= allowed;
+
+            const std::size_t count = cpus.Count();
+            if (count > maxCount)
+            {
+                maxCount    = count;
+                node        = static_cast<int>(i);
+            }
+        }
+
+        if (node < 0)
+            return false;
+    }
+    else if (static_cast<std::size_t>(node) >= topology.nodes.size())
+        return false;
+
+    CPUSet domain = topology.nodes[node].cpus;
+    domain &= allowed;
+
+    std::vector<int> order;
+    AppendSMTLastOrder(topology, domain, order);
+
+    return AssignCPUs(order, workers, masks);
+}
+
+
+/*
+ * Global functions
+ */
+
+const char* PlacementPolicyName(const PlacementPolicy policy)
+{
+    switch (policy)
+    {
+        case PLACEMENT_ONE_PER_CORE:    return "one-per-core";
+        case PLACEMENT_SMT_LAST:        return "smt-last";
+        case PLACEMENT_SPREAD_L3:       return "spread-l3";
+        case PLACEMENT_COMPACT_NODE:    return "compact-node";
+    }
+    return "";
+}
+
+bool PlanThreadPlacement(
+    const CPUTopology&              topology,
+    const std::vector<CacheInfo>&   caches,
+    const PlacementRequest&         request,
+    std::vector<CPUSet>&            masks)
+{
+    masks.clear();
+    masks.reserve(request.workers);
+
+    CPUSet allowed = topology.online;
+    if (!request.allowed.Empty())
+        allowed &= request.allowed;
+
+    if (allowed.Empty())
+        return false;
+
+    switch (request.policy)
+    {
+        case PLACEMENT_ONE_PER_CORE:
+            return PlanOnePerCore(topology, allowed, request.workers, masks);
+        case PLACEMENT_SMT_LAST:
+            return PlanSMTLast(topology, allowed, request.workers, masks);
+        case PLACEMENT_SPREAD_L3:
+            return PlanSpreadL3(topology, caches, allowed, request.workers, masks);
+        case PLACEMENT_COMPACT_NODE:
+            return PlanCompactNode(topology, allowed, request.node, request.workers, masks);
+    }
+
+    return false;
+}
+
+bool PlanThreadPlacement(const PlacementRequest& request, std::vector<CPUSet>& masks)
+{
+    CPUTopology topology;
+    if (!QueryCPUTopology(topology))
+        return false;
+
+    std::vector<CacheInfo> caches;
+    if (request.policy == PLACEMENT_SPREAD_L3)
+        QueryCacheInfo(caches);
+
+    if (request.allowed.Empty())
+    {
+        PlacementRequest hostRequest = request;
+        if (GetThreadAffinity(hostRequest.allowed))
+            return PlanThreadPlacement(topology, caches, hostRequest, masks);
+    }
+
+    return PlanThreadPlacement(topology, caches, request, masks);
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,31 @@
+/*
+ * Pressure.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorPressure.h>
+
+
+namespace SystemIndicator
+{
+
+
+bool PressureMonitor::IsOpen() const
+{
+    return (fds_[0] >= 0 || fds_[1] >= 0 || fds_[2] >= 0);
+}
+
+bool QueryPressure(PressureInfo& info, const PressureScope scope)
+{
+    PressureMonitor monitor;
+    return (monitor.Open(scope) && monitor.Read(info));
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,695 @@
+/*
+ * ProcessorInfo.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProcessorInfo.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#   define SI_CPUID_MSVC
+#   include <intrin.h>
+#   include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#   define SI_CPUID_GNUC
+#   include <cpuid.h>
+#endif
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+#if defined(SI_CPUID_MSVC) || defined(SI_CPUID_GNUC)
+
+// Executes the CPUID instruction for the specified leaf and sub-leaf and stores EAX, EBX, ECX, and EDX in 'regs'.
+static void CPUID(unsigned int leaf, unsigned int subLeaf, unsigned int regs[4])
+{
+    #ifdef SI_CPUID_MSVC
+
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned int>(info[i]);
+
+    #else
+
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+
+    #endif
+}
+
+// Returns the extended control register (XCR) that is specified by 'index'. Must only be called if OSXSAVE is set.
+static unsigned long long XGETBV(unsigned int index)
+{
+    #ifdef SI_CPUID_MSVC
+
+    return static_cast<unsigned long long>(_xgetbv(index));
+
+    #else
+
+    /* Emit opcode directly, so we don't depend on assembler support or '-mxsave' */
+    unsigned int eax = 0, edx = 0;
+    __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (index));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+
+    #endif
+}
+
+static bool IsBitSet(unsigned int value, int bit)
+{
+    return ((value >> bit) & 0x1) != 0;
+}
+
+#endif
+
+// Copies the source string into the destination buffer and removes leading and trailing white spaces.
+static void CopyTrimmed(char* dst, std::size_t dstSize, const char* src, std::size_t srcLen)
+{
+    while (srcLen > 0 && (*src == ' ' || *src == '\t'))
+    {
+        ++src;
+        --srcLen;
+    }
+    while (srcLen > 0 && (src[srcLen - 1] == ' ' || src[srcLen - 1] == '\t' || src[srcLen - 1] == '\n'))
+        --srcLen;
+
+    if (srcLen >= dstSize)
+        srcLen = dstSize - 1;
+
+    std::memcpy(dst, src, srcLen);
+    dst[srcLen] = '\0';
+}
+
+struct CPUFeatureEntry
+{
+    CPUFeature  feature;
+    const char* name;
+};
+
+// Display names of all features in the order they are listed by 'GetExtensions'.
+static const CPUFeatureEntry g_featureNames[] =
+{
+    { CPU_FEATURE_SSE,              "SSE"           },
+    { CPU_FEATURE_SSE2,             "SSE2"          },
+    { CPU_FEATURE_SSE3,             "SSE3"          },
+    { CPU_FEATURE_SSSE3,            "SSSE3"         },
+    { CPU_FEATURE_SSE4_1,           "SSE4.1"        },
+    { CPU_FEATURE_SSE4_2,           "SSE4.2"        },
+    { CPU_FEATURE_SSE4A,            "SSE4a"         },
+    { CPU_FEATURE_AVX,              "AVX"           },
+    { CPU_FEATURE_AVX2,             "AVX2"          },
+    { CPU_FEATURE_FMA,              "FMA"           },
+    { CPU_FEATURE_FMA4,             "FMA4"          },
+    { CPU_FEATURE_F16C,             "F16C"          },
+    { CPU_FEATURE_AVX512F,          "AVX-512F"      },
+    { CPU_FEATURE_AVX512CD,         "AVX-512CD"     },
+    { CPU_FEATURE_AVX512DQ,         "AVX-512DQ"     },
+    { CPU_FEATURE_AVX512BW,         "AVX-512BW"     },
+    { CPU_FEATURE_AVX512VL,         "AVX-512VL"     },
+    { CPU_FEATURE_AVX512IFMA,       "AVX-512IFMA"   },
+    { CPU_FEATURE_AVX512VBMI,       "AVX-512VBMI"   },
+    { CPU_FEATURE_AVX512VBMI2,      "AVX-512VBMI2"  },
+    { CPU_FEATURE_AVX512VNNI,       "AVX-512VNNI"   },
+    { CPU_FEATURE_AVX512BITALG,     "AVX-512BITALG" },
+    { CPU_FEATURE_AVX512VPOPCNTDQ,  "AVX-512VPOPCNTDQ" },
+    { CPU_FEATURE_NEON,             "NEON"          },
+    { CPU_FEATURE_SVE,              "SVE"           },
+    { CPU_FEATURE_MMX,              "MMX"           },
+    { CPU_FEATURE_EXT_MMX,          "Ext. MMX"      },
+    { CPU_FEATURE_3DNOW,            "3DNow!"        },
+    { CPU_FEATURE_EXT_3DNOW,        "Ext. 3DNow!"   },
+    { CPU_FEATURE_POPCNT,           "POPCNT"        },
+    { CPU_FEATURE_LZCNT,            "LZCNT"         },
+    { CPU_FEATURE_BMI1,             "BMI1"          },
+    { CPU_FEATURE_BMI2,             "BMI2"          },
+    { CPU_FEATURE_ADX,              "ADX"           },
+    { CPU_FEATURE_MOVBE,            "MOVBE"         },
+    { CPU_FEATURE_AES,              "AES"           },
+    { CPU_FEATURE_PCLMULQDQ,        "PCLMULQDQ"     },
+    { CPU_FEATURE_SHA,              "SHA"           },
+    { CPU_FEATURE_RDRAND,           "RDRAND"        },
+    { CPU_FEATURE_RDSEED,           "RDSEED"        },
+    { CPU_FEATURE_INVARIANT_TSC,    "Invariant TSC" },
+    { CPU_FEATURE_HTT,              "HTT"           },
+};
+
+#ifdef __linux__
+
+// Flag names as they appear in the "flags" (x86) or "Features" (ARM) line of "/proc/cpuinfo".
+static const CPUFeatureEntry g_procCPUInfoFlags[] =
+{
+    { CPU_FEATURE_MMX,              "mmx"               },
+    { CPU_FEATURE_EXT_MMX,          "mmxext"            },
+    { CPU_FEATURE_3DNOW,            "3dnow"             },
+    { CPU_FEATURE_EXT_3DNOW,        "3dnowext"          },
+    { CPU_FEATURE_SSE,              "sse"               },
+    { CPU_FEATURE_SSE2,             "sse2"              },
+    { CPU_FEATURE_SSE3,             "pni"               },
+    { CPU_FEATURE_SSSE3,            "ssse3"             },
+    { CPU_FEATURE_SSE4_1,           "sse4_1"            },
+    { CPU_FEATURE_SSE4_2,           "sse4_2"            },
+    { CPU_FEATURE_SSE4A,            "sse4a"             },
+    { CPU_FEATURE_AVX,              "avx"               },
+    { CPU_FEATURE_AVX2,             "avx2"              },
+    { CPU_FEATURE_FMA,              "fma"               },
+    { CPU_FEATURE_FMA4,             "fma4"              },
+    { CPU_FEATURE_F16C,             "f16c"              },
+    { CPU_FEATURE_AVX512F,          "avx512f"           },
+    { CPU_FEATURE_AVX512CD,         "avx512cd"          },
+    { CPU_FEATURE_AVX512DQ,         "avx512dq"          },
+    { CPU_FEATURE_AVX512BW,         "avx512bw"          },
+    { CPU_FEATURE_AVX512VL,         "avx512vl"          },
+    { CPU_FEATURE_AVX512IFMA,       "avx512ifma"        },
+    { CPU_FEATURE_AVX512VBMI,       "avx512vbmi"        },
+    { CPU_FEATURE_AVX512VBMI2,      "avx512_vbmi2"      },
+    { CPU_FEATURE_AVX512VNNI,       "avx512_vnni"       },
+    { CPU_FEATURE_AVX512BITALG,     "avx512_bitalg"     },
+    { CPU_FEATURE_AVX512VPOPCNTDQ,  "avx512_vpopcntdq"  },
+    { CPU_FEATURE_POPCNT,           "popcnt"            },
+    { CPU_FEATURE_LZCNT,            "abm"               },
+    { CPU_FEATURE_BMI1,             "bmi1"              },
+    { CPU_FEATURE_BMI2,             "bmi2"              },
+    { CPU_FEATURE_ADX,              "adx"               },
+    { CPU_FEATURE_MOVBE,            "movbe"             },
+    { CPU_FEATURE_AES,              "aes"               },
+    { CPU_FEATURE_PCLMULQDQ,        "pclmulqdq"         },
+    { CPU_FEATURE_SHA,              "sha_ni"            },
+    { CPU_FEATURE_SHA,              "sha2"              },
+    { CPU_FEATURE_RDRAND,           "rdrand"            },
+    { CPU_FEATURE_RDSEED,           "rdseed"            },
+    { CPU_FEATURE_HTT,              "ht"                },
+    { CPU_FEATURE_INVARIANT_TSC,    "nonstop_tsc"       },
+    { CPU_FEATURE_NEON,             "neon"              },
+    { CPU_FEATURE_NEON,             "asimd"             },
+    { CPU_FEATURE_SVE,              "sve"               },
+};
+
+// Returns the name of an ARM CPU implementer code as listed in "/proc/cpuinfo".
+static const char* ARMImplementerName(unsigned long implementer)
+{
+    switch (implementer)
+    {
+        case 0x41: return "ARM";
+        case 0x42: return "Broadcom";
+        case 0x43: return "Cavium";
+        case 0x46: return "Fujitsu";
+        case 0x48: return "HiSilicon";
+        case 0x4e: return "NVIDIA";
+        case 0x50: return "APM";
+        case 0x51: return "Qualcomm";
+        case 0x53: return "Samsung";
+        case 0x56: return "Marvell";
+        case 0x61: return "Apple";
+        case 0x69: return "Intel";
+        case 0xc0: return "Ampere";
+    }
+    return 0;
+}
+
+#endif
+
+
+/*
+ * Global functions
+ */
+
+const char* CPUFeatureName(const CPUFeature feature)
+{
+    for (std::size_t i = 0; i < sizeof(g_featureNames)/sizeof(g_featureNames[0]); ++i)
+    {
+        if (g_featureNames[i].feature == feature)
+            return g_featureNames[i].name;
+    }
+    return "";
+}
+
+const CPUFeatureSet& QueryCPUFeatures()
+{
+    /* Detect features only once; initialization of local statics is thread-safe */
+    static const CPUFeatureSet features = ProcessorInfo().GetFeatures();
+    return features;
+}
+
+// Reads the TSC and the raw monotonic clock at the same point in time; the TSC is bracketed around the clock read to reduce the error.
+static bool ReadClockPair(unsigned long long& tsc, unsigned long long& ns)
+{
+    unsigned long long minDelta = ~0ull;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        unsigned long long clock = 0;
+        const unsigned long long before = ReadTimestampCounter();
+        if (!ReadRawMonotonicClock(clock))
+            return false;
+        const unsigned long long after = ReadTimestampCounter();
+
+        if (after - before < minDelta)
+        {
+            minDelta    = after - before;
+            tsc         = before + (after - before) / 2;
+            ns          = clock;
+        }
+    }
+
+    return true;
+}
+
+// Measures the TSC frequency (in Hz) against the raw monotonic clock for the specified duration (in nanoseconds).
+static unsigned long long CalibrateTSCFrequency(unsigned long long duration)
+{
+    unsigned long long tsc0 = 0, ns0 = 0, tsc1 = 0, ns1 = 0;
+
+    if (ReadTimestampCounter() == 0 || !ReadClockPair(tsc0, ns0))
+        return 0;
+
+    do
+    {
+        if (!ReadClockPair(tsc1, ns1))
+            return 0;
+    }
+    while (ns1 - ns0 < duration);
+
+    return static_cast<unsigned long long>(static_cast<double>(tsc1 - tsc0) * 1.0e9 / static_cast<double>(ns1 - ns0) + 0.5);
+}
+
+static TSCInfo DetectTSCInfo()
+{
+    const ProcessorInfo cpuInfo;
+
+    TSCInfo info;
+    info.invariant = cpuInfo.HasFeature(CPU_FEATURE_INVARIANT_TSC);
+
+    if (cpuInfo.GetTSCFrequency() > 0)
+    {
+        info.frequency  = cpuInfo.GetTSCFrequency();
+        info.source     = cpuInfo.GetTSCSource();
+    }
+    else if ((info.frequency = CalibrateTSCFrequency(20000000ull)) > 0)
+        info.source = TSC_SOURCE_CALIBRATED;
+
+    return info;
+}
+
+const TSCInfo& QueryTSCInfo()
+{
+    /* Detect frequency only once; initialization of local statics is thread-safe */
+    static const TSCInfo info = DetectTSCInfo();
+    return info;
+}
+
+const char* TSCSourceName(const TSCSource source)
+{
+    switch (source)
+    {
+        case TSC_SOURCE_NONE:       return "none";
+        case TSC_SOURCE_CPUID:      return "CPUID 0x15";
+        case TSC_SOURCE_CPUID_BASE: return "CPUID 0x16";
+        case TSC_SOURCE_HYPERVISOR: return "hypervisor";
+        case TSC_SOURCE_CALIBRATED: return "calibrated";
+    }
+    return "";
+}
+
+
+/*
+ * ProcessorInfo class
+ */
+
+ProcessorInfo::ProcessorInfo() :
+    stepping_       ( 0                 ),
+    model_          ( 0                 ),
+    family_         ( 0                 ),
+    type_           ( 0                 ),
+    modelExt_       ( 0                 ),
+    familyExt_      ( 0                 ),
+    tscFrequency_   ( 0                 ),
+    tscSource_      ( TSC_SOURCE_NONE   )
+{
+    std::memset(name_, 0, sizeof(name_));
+    std::memset(vendor_, 0, sizeof(vendor_));
+
+    #if defined(SI_CPUID_MSVC) || defined(SI_CPUID_GNUC)
+    ParseCPUID();
+    #else
+    ParseProcCPUInfo();
+    #endif
+}
+
+const char* ProcessorInfo::GetVendorName() const
+{
+         if (std::strcmp(GetVendorID(), "AuthenticAMD") == 0) return "AMD";
+    else if (std::strcmp(GetVendorID(), "GenuineIntel") == 0) return "Intel";
+    else if (std::strcmp(GetVendorID(), "CyrixInstead") == 0) return "Cyrix";
+    else if (std::strcmp(GetVendorID(), "CentaurHauls") == 0) return "Centaur";
+    else if (std::strcmp(GetVendorID(), "RiseRiseRise") == 0) return "Rise";
+    else if (std::strcmp(GetVendorID(), "GenuineTMx86") == 0) return "Transmeta";
+    else if (std::strcmp(GetVendorID(), "SiS SiS SiS ") == 0) return "SiS";
+    else if (std::strcmp(GetVendorID(), "UMC UMC UMC ") == 0) return "UMC";
+    else if (std::strcmp(GetVendorID(), "VIA VIA VIA ") == 0) return "VIA";
+    else if (std::strcmp(GetVendorID(), "VMwareVMware") == 0) return "VMware";
+    else if (std::strcmp(GetVendorID(), "HygonGenuine") == 0) return "Hygon";
+    else                                                      return GetVendorID();
+}
+
+std::size_t ProcessorInfo::GetExtensions(char* buffer, std::size_t size) const
+{
+    if (size == 0)
+        return 0;
+
+    std::size_t len = 0;
+
+    for (std::size_t i = 0; i < sizeof(g_featureNames)/sizeof(g_featureNames[0]); ++i)
+    {
+        if (HasFeature(g_featureNames[i].feature))
+        {
+            const int n = std::snprintf(buffer + len, size - len, (len > 0 ? ", %s" : "%s"), g_featureNames[i].name);
+            if (n < 0 || static_cast<std::size_t>(n) >= size - len)
+                return size - 1;
+            len += static_cast<std::size_t>(n);
+        }
+    }
+
+    if (len == 0)
+    {
+        std::strncpy(buffer, "<none>", size - 1);
+        buffer[size - 1] = '\0';
+        len = std::strlen(buffer);
+    }
+
+    return len;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ProcessorInfo::SetFeature(const CPUFeature feature, bool enabled)
+{
+    if (enabled)
+        features_.Add(feature);
+    else
+        features_.Remove(feature);
+}
+
+/*
+This is the 'core' CPU info function:
+-> call CPUID instruction and parse output
+*/
+void ProcessorInfo::ParseCPUID()
+{
+    #if defined(SI_CPUID_MSVC) || defined(SI_CPUID_GNUC)
+
+    unsigned int regs[4] = { 0 };
+
+    /* First CPUID function, always supported (on reasonable cpu) */
+    CPUID(0x00000000, 0, regs);
+
+    const unsigned int maxLeaf = regs[0];
+    std::memcpy(vendor_ + 0, &regs[1], 4); // EBX
+    std::memcpy(vendor_ + 4, &regs[3], 4); // EDX
+    std::memcpy(vendor_ + 8, &regs[2], 4); // ECX
+
+    if (maxLeaf == 0)
+        return;
+
+    /* Get standard features */
+    CPUID(0x00000001, 0, regs);
+
+    const unsigned int cpu_feat_eax = regs[0];
+    const unsigned int cpu_feat_ecx = regs[2];
+    const unsigned int cpu_feat_edx = regs[3];
+
+    stepping_       = cpu_feat_eax & 0xf;
+    model_          = (cpu_feat_eax >> 4) & 0xf;
+    family_         = (cpu_feat_eax >> 8) & 0xf;
+    type_           = (cpu_feat_eax >> 12) & 0x3;
+    modelExt_       = (cpu_feat_eax >> 16) & 0xf;
+    familyExt_      = (cpu_feat_eax >> 20) & 0xff;
+
+    SetFeature( CPU_FEATURE_MMX,        IsBitSet(cpu_feat_edx, 23) );
+    SetFeature( CPU_FEATURE_SSE,        IsBitSet(cpu_feat_edx, 25) );
+    SetFeature( CPU_FEATURE_SSE2,       IsBitSet(cpu_feat_edx, 26) );
+    SetFeature( CPU_FEATURE_HTT,        IsBitSet(cpu_feat_edx, 28) );
+
+    SetFeature( CPU_FEATURE_SSE3,       IsBitSet(cpu_feat_ecx,  0) );
+    SetFeature( CPU_FEATURE_PCLMULQDQ,  IsBitSet(cpu_feat_ecx,  1) );
+    SetFeature( CPU_FEATURE_SSSE3,      IsBitSet(cpu_feat_ecx,  9) );
+    SetFeature( CPU_FEATURE_FMA,        IsBitSet(cpu_feat_ecx, 12) );
+    SetFeature( CPU_FEATURE_SSE4_1,     IsBitSet(cpu_feat_ecx, 19) );
+    SetFeature( CPU_FEATURE_SSE4_2,     IsBitSet(cpu_feat_ecx, 20) );
+    SetFeature( CPU_FEATURE_MOVBE,      IsBitSet(cpu_feat_ecx, 22) );
+    SetFeature( CPU_FEATURE_POPCNT,     IsBitSet(cpu_feat_ecx, 23) );
+    SetFeature( CPU_FEATURE_AES,        IsBitSet(cpu_feat_ecx, 25) );
+    SetFeature( CPU_FEATURE_AVX,        IsBitSet(cpu_feat_ecx, 28) );
+    SetFeature( CPU_FEATURE_F16C,       IsBitSet(cpu_feat_ecx, 29) );
+    SetFeature( CPU_FEATURE_RDRAND,     IsBitSet(cpu_feat_ecx, 30) );
+
+    /* Get structured extended features (leaf 7, sub-leaf 0) */
+    if (maxLeaf >= 0x00000007)
+    {
+        CPUID(0x00000007, 0, regs);
+
+        const unsigned int cpu_feat7_ebx = regs[1];
+        const unsigned int cpu_feat7_ecx = regs[2];
+
+        SetFeature( CPU_FEATURE_BMI1,               IsBitSet(cpu_feat7_ebx,  3) );
+        SetFeature( CPU_FEATURE_AVX2,               IsBitSet(cpu_feat7_ebx,  5) );
+        SetFeature( CPU_FEATURE_BMI2,               IsBitSet(cpu_feat7_ebx,  8) );
+        SetFeature( CPU_FEATURE_AVX512F,            IsBitSet(cpu_feat7_ebx, 16) );
+        SetFeature( CPU_FEATURE_AVX512DQ,           IsBitSet(cpu_feat7_ebx, 17) );
+        SetFeature( CPU_FEATURE_RDSEED,             IsBitSet(cpu_feat7_ebx, 18) );
+        SetFeature( CPU_FEATURE_ADX,                IsBitSet(cpu_feat7_ebx, 19) );
+        SetFeature( CPU_FEATURE_AVX512IFMA,         IsBitSet(cpu_feat7_ebx, 21) );
+        SetFeature( CPU_FEATURE_AVX512CD,           IsBitSet(cpu_feat7_ebx, 28) );
+        SetFeature( CPU_FEATURE_SHA,                IsBitSet(cpu_feat7_ebx, 29) );
+        SetFeature( CPU_FEATURE_AVX512BW,           IsBitSet(cpu_feat7_ebx, 30) );
+        SetFeature( CPU_FEATURE_AVX512VL,           IsBitSet(cpu_feat7_ebx, 31) );
+
+        SetFeature( CPU_FEATURE_AVX512VBMI,         IsBitSet(cpu_feat7_ecx,  1) );
+        SetFeature( CPU_FEATURE_AVX512VBMI2,        IsBitSet(cpu_feat7_ecx,  6) );
+        SetFeature( CPU_FEATURE_AVX512VNNI,         IsBitSet(cpu_feat7_ecx, 11) );
+        SetFeature( CPU_FEATURE_AVX512BITALG,       IsBitSet(cpu_feat7_ecx, 12) );
+        SetFeature( CPU_FEATURE_AVX512VPOPCNTDQ,    IsBitSet(cpu_feat7_ecx, 14) );
+    }
+
+    /* Get TSC frequency from the crystal clock ratio (leaf 0x15) or the processor base frequency (leaf 0x16) */
+    if (maxLeaf >= 0x00000015)
+    {
+        CPUID(0x00000015, 0, regs);
+
+        const unsigned long long denominator    = regs[0];
+        const unsigned long long numerator      = regs[1];
+        const unsigned long long crystal        = regs[2];
+
+        if (denominator != 0 && numerator != 0 && crystal != 0)
+        {
+            tscFrequency_   = crystal * numerator / denominator;
+            tscSource_      = TSC_SOURCE_CPUID;
+        }
+        else if (maxLeaf >= 0x00000016)
+        {
+            /* Crystal clock frequency is not enumerated on some processors, but the TSC runs at the base frequency */
+            CPUID(0x00000016, 0, regs);
+            if ((regs[0] & 0xffff) != 0)
+            {
+                tscFrequency_   = static_cast<unsigned long long>(regs[0] & 0xffff) * 1000000ull;
+                tscSource_      = TSC_SOURCE_CPUID_BASE;
+            }
+        }
+    }
+
+    /* Get TSC frequency (in kHz) from the hypervisor leaves, as supported by VMware and KVM */
+    if (tscSource_ == TSC_SOURCE_NONE && IsBitSet(cpu_feat_ecx, 31))
+    {
+        CPUID(0x40000000, 0, regs);
+        if (regs[0] >= 0x40000010 && regs[0] < 0x40010000)
+        {
+            CPUID(0x40000010, 0, regs);
+            if (regs[0] != 0)
+            {
+                tscFrequency_   = static_cast<unsigned long long>(regs[0]) * 1000ull;
+                tscSource_      = TSC_SOURCE_HYPERVISOR;
+            }
+        }
+    }
+
+    /*
+    Check which register states the OS saves on context switches (XCR0):
+    bit 1 = SSE, bit 2 = AVX, bits 5-7 = AVX-512 opmask and upper ZMM registers
+    */
+    const bool osxsave = IsBitSet(cpu_feat_ecx, 27);
+    const unsigned long long xcr0 = (osxsave ? XGETBV(0) : 0);
+
+    const bool osAVX    = ((xcr0 & 0x06) == 0x06);
+    const bool osAVX512 = ((xcr0 & 0xe6) == 0xe6);
+
+    if (!osAVX)
+    {
+        SetFeature( CPU_FEATURE_AVX,  false );
+        SetFeature( CPU_FEATURE_AVX2, false );
+        SetFeature( CPU_FEATURE_FMA,  false );
+        SetFeature( CPU_FEATURE_F16C, false );
+    }
+
+    if (!osAVX512)
+    {
+        SetFeature( CPU_FEATURE_AVX512F,            false );
+        SetFeature( CPU_FEATURE_AVX512CD,           false );
+        SetFeature( CPU_FEATURE_AVX512DQ,           false );
+        SetFeature( CPU_FEATURE_AVX512BW,           false );
+        SetFeature( CPU_FEATURE_AVX512VL,           false );
+        SetFeature( CPU_FEATURE_AVX512IFMA,         false );
+        SetFeature( CPU_FEATURE_AVX512VBMI,         false );
+        SetFeature( CPU_FEATURE_AVX512VBMI2,        false );
+        SetFeature( CPU_FEATURE_AVX512VNNI,         false );
+        SetFeature( CPU_FEATURE_AVX512BITALG,       false );
+        SetFeature( CPU_FEATURE_AVX512VPOPCNTDQ,    false );
+    }
+
+    /* Test which extended functions are supported */
+    CPUID(0x80000000, 0, regs);
+
+    const unsigned int maxExtLeaf = regs[0];
+
+    if (maxExtLeaf >= 0x80000001)
+    {
+        /* Get extended features */
+        CPUID(0x80000001, 0, regs);
+
+        const unsigned int cpu_feat_ext_ecx = regs[2];
+        const unsigned int cpu_feat_ext_edx = regs[3];
+
+        SetFeature( CPU_FEATURE_LZCNT,      IsBitSet(cpu_feat_ext_ecx,  5) );
+        SetFeature( CPU_FEATURE_SSE4A,      IsBitSet(cpu_feat_ext_ecx,  6) );
+        SetFeature( CPU_FEATURE_FMA4,       IsBitSet(cpu_feat_ext_ecx, 16) && osAVX );
+
+        SetFeature( CPU_FEATURE_EXT_MMX,    IsBitSet(cpu_feat_ext_edx, 22) );
+        SetFeature( CPU_FEATURE_EXT_3DNOW,  IsBitSet(cpu_feat_ext_edx, 30) );
+        SetFeature( CPU_FEATURE_3DNOW,      IsBitSet(cpu_feat_ext_edx, 31) );
+    }
+
+    if (maxExtLeaf >= 0x80000004)
+    {
+        /* Get name of the cpu */
+        char name[48];
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            CPUID(0x80000002 + i, 0, regs);
+            std::memcpy(name + i*16, regs, 16);
+        }
+
+        CopyTrimmed(name_, sizeof(name_), name, strnlen(name, sizeof(name)));
+    }
+
+    if (maxExtLeaf >= 0x80000007)
+    {
+        /* Get advanced power management information */
+        CPUID(0x80000007, 0, regs);
+        SetFeature( CPU_FEATURE_INVARIANT_TSC, IsBitSet(regs[3], 8) );
+    }
+
+    #endif
+}
+
+/*
+Fallback for architectures without CPUID instruction:
+-> parse first processor entry in "/proc/cpuinfo"
+*/
+void ProcessorInfo::ParseProcCPUInfo()
+{
+    #ifdef __linux__
+
+    FILE* file = std::fopen("/proc/cpuinfo", "r");
+    if (!file)
+        return;
+
+    char line[4096];
+    bool hasName = false;
+
+    while (std::fgets(line, sizeof(line), file))
+    {
+        /* Only parse the first processor entry, which ends with an empty line */
+        if (line[0] == '\n')
+        {
+            if (hasName || vendor_[0] != '\0')
+                break;
+            continue;
+        }
+
+        /* Split line into key and value */
+        char* colon = std::strchr(line, ':');
+        if (!colon)
+            continue;
+
+        std::size_t keyLen = static_cast<std::size_t>(colon - line);
+        while (keyLen > 0 && (line[keyLen - 1] == ' ' || line[keyLen - 1] == '\t'))
+            --keyLen;
+        line[keyLen] = '\0';
+
+        const char* value = colon + 1;
+        const std::size_t valueLen = std::strlen(value);
+
+        if (std::strcmp(line, "model name") == 0 || std::strcmp(line, "Processor") == 0 || std::strcmp(line, "cpu") == 0 || std::strcmp(line, "uarch") == 0)
+        {
+            /* Prefer "model name" over other name fields */
+            if (!hasName || std::strcmp(line, "model name") == 0)
+            {
+                CopyTrimmed(name_, sizeof(name_), value, valueLen);
+                hasName = true;
+            }
+        }
+        else if (std::strcmp(line, "vendor_id") == 0)
+            CopyTrimmed(vendor_, sizeof(vendor_), value, valueLen);
+        else if (std::strcmp(line, "CPU implementer") == 0)
+        {
+            if (const char* implementer = ARMImplementerName(std::strtoul(value, 0, 0)))
+                CopyTrimmed(vendor_, sizeof(vendor_), implementer, std::strlen(implementer));
+        }
+        else if (std::strcmp(line, "flags") == 0 || std::strcmp(line, "Features") == 0)
+        {
+            /* Match each white-space separated flag against the table of known flags */
+            for (const char* s = value; *s != '\0';)
+            {
+                while (*s == ' ' || *s == '\t' || *s == '\n')
+                    ++s;
+
+                const char* flag = s;
+                while (*s != '\0' && *s != ' ' && *s != '\t' && *s != '\n')
+                    ++s;
+
+                const std::size_t flagLen = static_cast<std::size_t>(s - flag);
+                if (flagLen == 0)
+                    continue;
+
+                for (std::size_t i = 0; i < sizeof(g_procCPUInfoFlags)/sizeof(g_procCPUInfoFlags[0]); ++i)
+                {
+                    const char* name = g_procCPUInfoFlags[i].name;
+                    if (std::strlen(name) == flagLen && std::strncmp(name, flag, flagLen) == 0)
+                        SetFeature(g_procCPUInfoFlags[i].feature, true);
+                }
+            }
+        }
+    }
+
+    std::fclose(file);
+
+    #endif
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
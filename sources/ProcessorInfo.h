@@ -0,0 +1,233 @@
+/*
+ * ProcessorInfo.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROCESSOR_INFO_H__
+#define __SI_PROCESSOR_INFO_H__
+
+
+#include <SystemIndicator.h>
+#include <SystemIndicatorFrequency.h>
+#include <cstddef>
+
+
+namespace SystemIndicator
+{
+
+
+/**
+Processor information query class.
+\remarks On x86 and x86-64 this uses the CPUID instruction (with MSVC, GCC, and clang).
+On other architectures under Linux, the information is parsed from "/proc/cpuinfo".
+\see http://www.gamedev.net/topic/438752-idenitfying-cpu-brand--model-c/
+*/
+class ProcessorInfo
+{
+
+    public:
+
+        ProcessorInfo();
+
+        //! Returns true if the specified feature is supported.
+        bool HasFeature(const CPUFeature feature) const
+        {
+            return features_.Has(feature);
+        }
+
+        //! Returns the set of all supported features.
+        const CPUFeatureSet& GetFeatures() const
+        {
+            return features_;
+        }
+
+        //! Returns true if 'IA SSE' is supported.
+        bool HasSSE() const
+        {
+            return HasFeature(CPU_FEATURE_SSE);
+        }
+
+        //! Returns true if 'IA SSE2' is supported.
+        bool HasSSE2() const
+        {
+            return HasFeature(CPU_FEATURE_SSE2);
+        }
+
+        //! Returns true if 'IA SSE3' is supported.
+        bool HasSSE3() const
+        {
+            return HasFeature(CPU_FEATURE_SSE3);
+        }
+
+        //! Returns true if 'IA Supplemental SSE3' is supported.
+        bool HasSSSE3() const
+        {
+            return HasFeature(CPU_FEATURE_SSSE3);
+        }
+
+        //! Returns true if 'IA SSE4.1' is supported.
+        bool HasSSE4_1() const
+        {
+            return HasFeature(CPU_FEATURE_SSE4_1);
+        }
+
+        //! Returns true if 'IA SSE4.2' is supported.
+        bool HasSSE4_2() const
+        {
+            return HasFeature(CPU_FEATURE_SSE4_2);
+        }
+
+        //! Returns true if 'IA MMX' is supported.
+        bool HasMMX() const
+        {
+            return HasFeature(CPU_FEATURE_MMX);
+        }
+
+        //! Returns true if 'Extended MMX' is supported.
+        bool HasExtMMX() const
+        {
+            return HasFeature(CPU_FEATURE_EXT_MMX);
+        }
+
+        //! Returns true if 'AMD 3DNow!' is supported.
+        bool Has3DNow() const
+        {
+            return HasFeature(CPU_FEATURE_3DNOW);
+        }
+
+        //! Returns true if 'AMD Extended 3DNow!' is supported.
+        bool HasExt3DNow() const
+        {
+            return HasFeature(CPU_FEATURE_EXT_3DNOW);
+        }
+
+        //! Returns true if HTT (hyper-threading) is supported.
+        bool HasHTT() const
+        {
+            return HasFeature(CPU_FEATURE_HTT);
+        }
+
+        //! Returns true if AVX is supported by the CPU and enabled by the OS.
+        bool HasAVX() const
+        {
+            return HasFeature(CPU_FEATURE_AVX);
+        }
+
+        //! Returns true if AVX2 is supported by the CPU and enabled by the OS.
+        bool HasAVX2() const
+        {
+            return HasFeature(CPU_FEATURE_AVX2);
+        }
+
+        //! Returns true if AVX-512 foundation is supported by the CPU and enabled by the OS.
+        bool HasAVX512F() const
+        {
+            return HasFeature(CPU_FEATURE_AVX512F);
+        }
+
+        //! Returns the CPU name, e.g. "Intel(R) Core(TM) i7-3770K CPU @ 3.50GHz".
+        const char* GetName() const
+        {
+            return name_;
+        }
+
+        //! Returns the vendor ID string, e.g. "GenuineIntel".
+        const char* GetVendorID() const
+        {
+            return vendor_;
+        }
+
+        //! Returns the vendor name, e.g. "Intel".
+        const char* GetVendorName() const;
+
+        /**
+        \brief Writes a comma separated list of all supported features into the specified buffer, e.g. "SSE, SSE2, SSE3".
+        \return Length of the written string (without the null terminator). The string is truncated if the buffer is too small.
+        \remarks Writes "<none>" if no feature is supported.
+        */
+        std::size_t GetExtensions(char* buffer, std::size_t size) const;
+
+        int GetStepping() const
+        {
+            return stepping_;
+        }
+
+        int GetModel() const
+        {
+            return model_;
+        }
+
+        int GetFamily() const
+        {
+            return family_;
+        }
+
+        int GetType() const
+        {
+            return type_;
+        }
+
+        int GetExtModel() const
+        {
+            return modelExt_;
+        }
+
+        int GetExtFamily() const
+        {
+            return familyExt_;
+        }
+
+        //! Returns the TSC frequency (in Hz) that is enumerated by CPUID, or 0 if not available.
+        unsigned long long GetTSCFrequency() const
+        {
+            return tscFrequency_;
+        }
+
+        //! Returns the CPUID leaf the TSC frequency was taken from.
+        TSCSource GetTSCSource() const
+        {
+            return tscSource_;
+        }
+
+    private:
+
+        void SetFeature(const CPUFeature feature, bool enabled);
+
+        void ParseCPUID();
+        void ParseProcCPUInfo();
+
+        CPUFeatureSet       features_;
+
+        int                 stepping_;
+        int                 model_;
+        int                 family_;
+        int                 type_;
+        int                 modelExt_;
+        int                 familyExt_;
+
+        unsigned long long  tscFrequency_;
+        TSCSource           tscSource_;
+
+        char                name_[49];      // max 48 chars + null terminator
+        char                vendor_[13];    // max 12 chars + null terminator
+
+};
+
+
+/**
+Reads a raw monotonic clock (in nanoseconds) that is not adjusted by NTP, e.g. 'CLOCK_MONOTONIC_RAW' on Linux.
+This is implemented by each platform and used to calibrate the TSC frequency.
+*/
+bool ReadRawMonotonicClock(unsigned long long& ns);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
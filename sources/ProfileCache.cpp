@@ -0,0 +1,105 @@
+/*
+ * ProfileCache.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfileCache.h"
+#include <cstring>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal constants
+ */
+
+static const char           g_profileCacheMagic[4]      = { 'S', 'I', 'P', 'C' };
+static const unsigned int   g_profileCacheVersion       = 1;
+
+
+/*
+ * Internal members
+ */
+
+static char g_profileCachePath[512] = { 0 };
+static bool g_profileCached         = false;
+
+
+/*
+ * Internal functions
+ */
+
+void InitProfileCacheHeader(ProfileCacheHeader& header, const char* bootID)
+{
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, g_profileCacheMagic, sizeof(header.magic));
+    header.formatVersion    = g_profileCacheVersion;
+    header.libraryVersion   = SI_VERSION;
+    header.headerSize       = sizeof(ProfileCacheHeader);
+    std::strncpy(header.bootID, bootID, sizeof(header.bootID) - 1);
+}
+
+bool IsProfileCacheHeaderValid(const ProfileCacheHeader& header, const char* bootID)
+{
+    return
+    (
+        std::memcmp(header.magic, g_profileCacheMagic, sizeof(header.magic)) == 0 &&
+        header.formatVersion == g_profileCacheVersion &&
+        header.libraryVersion == SI_VERSION &&
+        header.headerSize == sizeof(ProfileCacheHeader) &&
+        bootID[0] != '\0' &&
+        std::strncmp(header.bootID, bootID, sizeof(header.bootID)) == 0
+    );
+}
+
+bool LoadCachedHardwareProfile(InformationSnapshot& profile)
+{
+    if (g_profileCachePath[0] != '\0' && LoadHardwareProfile(g_profileCachePath, profile))
+        g_profileCached = true;
+    return g_profileCached;
+}
+
+void StoreCachedHardwareProfile(const InformationSnapshot& profile)
+{
+    if (g_profileCachePath[0] != '\0')
+        SaveHardwareProfile(g_profileCachePath, profile);
+}
+
+
+/*
+ * Global functions
+ */
+
+bool EnableProfileCache(const char* filename)
+{
+    if (filename == NULL)
+    {
+        if (GetDefaultProfileCachePath(g_profileCachePath, sizeof(g_profileCachePath)))
+            return true;
+        g_profileCachePath[0] = '\0';
+        return false;
+    }
+
+    const std::size_t len = std::strlen(filename);
+    if (len == 0 || len >= sizeof(g_profileCachePath))
+        return false;
+
+    std::memcpy(g_profileCachePath, filename, len + 1);
+    return true;
+}
+
+bool IsHardwareProfileCached()
+{
+    return g_profileCached;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
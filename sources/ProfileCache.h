@@ -0,0 +1,52 @@
+/*
+ * ProfileCache.h
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef __SI_PROFILE_CACHE_INTERNAL_H__
+#define __SI_PROFILE_CACHE_INTERNAL_H__
+
+
+#include <SystemIndicatorProfileCache.h>
+
+
+namespace SystemIndicator
+{
+
+
+// Header of the profile cache file. The file is only valid on the same machine, so all integers are in native byte order.
+struct ProfileCacheHeader
+{
+    char            magic[4];       // "SIPC"
+    unsigned int    formatVersion;  // Version of this header layout.
+    unsigned int    libraryVersion; // Value of 'SI_VERSION' of the writer.
+    unsigned int    headerSize;     // Size of this header; the binary record of the profile follows directly.
+    char            bootID[48];     // Null-terminated boot ID of the system the file was written in.
+};
+
+// Initializes the specified header for the current library version and the specified boot ID.
+void InitProfileCacheHeader(ProfileCacheHeader& header, const char* bootID);
+
+// Returns true if the specified header was written by this library version in the current boot (specified by its boot ID).
+bool IsProfileCacheHeaderValid(const ProfileCacheHeader& header, const char* bootID);
+
+/*
+Loads the hardware profile from the cache file if the cache was enabled with 'EnableProfileCache'.
+This is called once by 'GetHardwareProfile'.
+*/
+bool LoadCachedHardwareProfile(InformationSnapshot& profile);
+
+// Stores the hardware profile in the cache file if the cache was enabled with 'EnableProfileCache'.
+void StoreCachedHardwareProfile(const InformationSnapshot& profile);
+
+
+} // /namespace SystemIndicator
+
+
+#endif
+
+
+
+// ================================================================================
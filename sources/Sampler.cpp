@@ -0,0 +1,49 @@
+/*
+ * Sampler.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorSampler.h>
+
+
+namespace SystemIndicator
+{
+
+
+void CPUSampler::UpdateUsage(unsigned long long* counters, const unsigned long long* current, CPUUsage& usage)
+{
+    /* Compute deltas; counters can go backwards, e.g. for "iowait" or after CPU hotplug */
+    double deltas[numCounters];
+    double elapsed = 0.0;
+
+    for (std::size_t i = 0; i < numCounters; ++i)
+    {
+        deltas[i] = (current[i] > counters[i] ? static_cast<double>(current[i] - counters[i]) : 0.0);
+        elapsed += deltas[i];
+        counters[i] = current[i];
+    }
+
+    if (elapsed <= 0.0)
+        return;
+
+    const double scale = 100.0 / elapsed;
+
+    usage.user      = deltas[0] * scale;
+    usage.nice      = deltas[1] * scale;
+    usage.system    = deltas[2] * scale;
+    usage.idle      = deltas[3] * scale;
+    usage.iowait    = deltas[4] * scale;
+    usage.irq       = deltas[5] * scale;
+    usage.softirq   = deltas[6] * scale;
+    usage.steal     = deltas[7] * scale;
+    usage.busy      = 100.0 - usage.idle - usage.iowait;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
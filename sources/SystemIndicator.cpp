@@ -6,132 +6,376 @@
  */
 
 #include <SystemIndicator.h>
+#include "Collector.h"
+#include "ProfileCache.h"
 
 #ifdef _WIN32
 #define NOMINMAX
 #endif
 
-#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 
 namespace SystemIndicator
 {
 
 
-typedef std::map<InformationEntry, std::string> EntryNameMap;
+/*
+ * InformationSnapshot class
+ */
+
+InformationSnapshot::InformationSnapshot()
+{
+    Clear();
+}
 
-static void PrintBlank(std::ostream& stream, std::size_t& counter)
+void InformationSnapshot::Clear()
 {
-    if (counter > 0)
+    for (int i = 0; i < ENTRY_COUNT; ++i)
     {
-        stream << std::endl;
-        counter = 0;
+        values_[i].type     = VALUE_NONE;
+        values_[i].textSlot = 0;
     }
+    textSize_ = 0;
+}
+
+void InformationSnapshot::SetNumber(const InformationEntry entry, unsigned long long number)
+{
+    Value& value = values_[entry];
+    value.number    = number;
+    value.type      = VALUE_NUMBER;
 }
 
-static void PrintEntry(
-    std::ostream& stream, std::size_t& counter, std::size_t maxLen,
-    const InformationEntryMap& entries, const std::string& entryName, const InformationEntry entry)
+bool InformationSnapshot::SetText(const InformationEntry entry, const char* text, std::size_t length)
 {
-    InformationEntryMap::const_iterator it = entries.find(entry);
-    if (it != entries.end())
+    Value& value = values_[entry];
+    bool result = true;
+
+    /*
+    Overwrite previous text in place if it fits into the slot of this entry, otherwise append new text to the buffer.
+    The slot is kept when the entry is removed, so refreshing volatile text entries doesn't exhaust the buffer.
+    */
+    std::size_t offset = textSize_;
+
+    if (length < value.textSlot)
+        offset = value.textOffset;
+    else if (length + 1 > textCapacity - textSize_)
     {
-        stream << entryName << ':' << std::string(maxLen + 1 - entryName.size(), ' ') << it->second << std::endl;
-        ++counter;
+        if (textSize_ >= textCapacity)
+        {
+            value.type = VALUE_NONE;
+            return false;
+        }
+        length = textCapacity - textSize_ - 1;
+        result = false;
     }
+
+    std::memcpy(text_ + offset, text, length);
+    text_[offset + length] = '\0';
+
+    if (offset == textSize_)
+    {
+        textSize_ += length + 1;
+        value.textSlot = static_cast<unsigned short>(length + 1);
+    }
+
+    value.number        = 0;
+    value.textOffset    = static_cast<unsigned short>(offset);
+    value.textLength    = static_cast<unsigned short>(length);
+    value.type          = VALUE_TEXT;
+
+    return result;
 }
 
-static void PrintCacheEntry(
-    std::ostream& stream, std::size_t& counter, std::size_t maxLen,
-    const InformationEntryMap& entries, const std::string& entryName,
-    const InformationEntry cacheEntry, const InformationEntry cacheSizeEntry)
+bool InformationSnapshot::SetText(const InformationEntry entry, const char* text)
 {
-    InformationEntryMap::const_iterator itC = entries.find(cacheEntry);
-    InformationEntryMap::const_iterator itS = entries.find(cacheSizeEntry);
-    if (itC != entries.end() && itS != entries.end())
+    return SetText(entry, text, std::strlen(text));
+}
+
+void InformationSnapshot::Remove(const InformationEntry entry)
+{
+    values_[entry].type = VALUE_NONE;
+}
+
+
+/*
+ * Global functions
+ */
+
+// Runs the collectors for the specified entries, each collector only once.
+static void RunCollectors(InformationSnapshot& snapshot, const InformationEntrySet& entries)
+{
+    const EntryCollector* collectors = GetEntryCollectors();
+
+    CollectorFunc executed[ENTRY_COUNT];
+    int numExecuted = 0;
+
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        CollectorFunc collect = collectors[i].collect;
+        if (!collect || !entries.Has(static_cast<InformationEntry>(i)))
+            continue;
+
+        bool alreadyExecuted = false;
+        for (int j = 0; j < numExecuted && !alreadyExecuted; ++j)
+            alreadyExecuted = (executed[j] == collect);
+
+        if (!alreadyExecuted)
+        {
+            collect(snapshot);
+            executed[numExecuted++] = collect;
+        }
+    }
+}
+
+// Removes all entries from the snapshot that are not contained in the specified set.
+static void RemoveOtherEntries(InformationSnapshot& snapshot, const InformationEntrySet& entries)
+{
+    for (int i = 0; i < ENTRY_COUNT; ++i)
     {
-        stream << entryName << ':' << std::string(maxLen + 1 - entryName.size(), ' ') << itC->second << "x " << itS->second << " KB" << std::endl;
-        ++counter;
+        if (!entries.Has(static_cast<InformationEntry>(i)))
+            snapshot.Remove(static_cast<InformationEntry>(i));
     }
 }
 
-std::ostream& operator << (std::ostream& stream, InformationEntryMap entries)
+static InformationEntrySet GetEntrySet(bool volatileEntries)
 {
-    /* Setup entry names */
-    EntryNameMap entryNames;
+    InformationEntrySet entries;
 
-    entryNames[ ENTRY_OS_NAME            ] = "Operating System";
-    entryNames[ ENTRY_COMPILER           ] = "Compiler";
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        if (IsVolatileEntry(static_cast<InformationEntry>(i)) == volatileEntries)
+            entries.Add(static_cast<InformationEntry>(i));
+    }
 
-    entryNames[ ENTRY_CPU_NAME           ] = "CPU Name";
-    entryNames[ ENTRY_CPU_VENDOR         ] = "CPU Vendor";
-    entryNames[ ENTRY_CPU_TYPE           ] = "CPU Type";
-    entryNames[ ENTRY_CPU_ARCH           ] = "CPU Architecture";
-    entryNames[ ENTRY_CPU_EXT            ] = "CPU Extensions";
+    return entries;
+}
 
-    entryNames[ ENTRY_PROCESSORS         ] = "Processors";
-    entryNames[ ENTRY_LOGICAL_PROCESSORS ] = "Logical Processors";
-    entryNames[ ENTRY_PROCESSOR_SPEED    ] = "Processor Speed";
+// Returns true if the specified static entry depends on the calling process (e.g. its CPU affinity), so it must not be shared with other processes.
+static bool IsProcessEntry(const InformationEntry entry)
+{
+    return (entry == ENTRY_EFFECTIVE_PROCESSORS || entry == ENTRY_EFFECTIVE_MEMORY);
+}
 
-    entryNames[ ENTRY_L1CACHES           ] = "L1 Cache";
-    entryNames[ ENTRY_L2CACHES           ] = "L2 Cache";
-    entryNames[ ENTRY_L3CACHES           ] = "L3 Cache";
+static InformationSnapshot QueryHardwareProfile()
+{
+    const InformationEntrySet staticEntries = GetEntrySet(false);
 
-    entryNames[ ENTRY_TOTAL_MEMORY       ] = "Total Memory";
-    entryNames[ ENTRY_FREE_MEMORY        ] = "Free Memory";
+    InformationEntrySet processEntries;
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        if (IsProcessEntry(static_cast<InformationEntry>(i)))
+            processEntries.Add(static_cast<InformationEntry>(i));
+    }
 
-    /* Get longest available entry name */
-    std::size_t maxLen = 0;
+    InformationSnapshot profile;
 
-    for (EntryNameMap::const_iterator it = entryNames.begin(); it != entryNames.end(); ++it)
+    if (LoadCachedHardwareProfile(profile))
+    {
+        /* Only query the entries of this process, all other static entries are from the cache */
+        RunCollectors(profile, processEntries);
+        RemoveOtherEntries(profile, staticEntries);
+    }
+    else
     {
-        if (entries.find(it->first) != entries.end())
-            maxLen = std::max(maxLen, it->second.size());
+        RunCollectors(profile, staticEntries);
+        RemoveOtherEntries(profile, staticEntries);
+
+        /* Store the profile without the entries of this process */
+        InformationSnapshot sharedProfile = profile;
+        for (int i = 0; i < ENTRY_COUNT; ++i)
+        {
+            if (processEntries.Has(static_cast<InformationEntry>(i)))
+                sharedProfile.Remove(static_cast<InformationEntry>(i));
+        }
+        StoreCachedHardwareProfile(sharedProfile);
+    }
+
+    return profile;
+}
+
+bool IsVolatileEntry(const InformationEntry entry)
+{
+    switch (entry)
+    {
+        case ENTRY_PROCESSOR_SPEED:
+        case ENTRY_FREE_MEMORY:
+        case ENTRY_AVAILABLE_MEMORY:
+        case ENTRY_CACHED_MEMORY:
+        case ENTRY_BUFFERED_MEMORY:
+        case ENTRY_DIRTY_MEMORY:
+        case ENTRY_COMMITTED_MEMORY:
+        case ENTRY_TOTAL_SWAP:
+        case ENTRY_FREE_SWAP:
+        case ENTRY_HUGE_PAGES:
+        case ENTRY_FREE_HUGE_PAGES:
+        case ENTRY_RESERVED_HUGE_PAGES:
+        case ENTRY_ANON_HUGE_PAGE_MEMORY:
+        case ENTRY_TRANSPARENT_HUGE_PAGES:
+        case ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG:
+        case ENTRY_FREE_HUGE_PAGE_BLOCKS:
+        case ENTRY_DISK_READS:
+        case ENTRY_DISK_WRITES:
+        case ENTRY_DISK_BYTES_READ:
+        case ENTRY_DISK_BYTES_WRITTEN:
+        case ENTRY_DISK_IN_FLIGHT:
+        case ENTRY_DISK_IO_TIME:
+        case ENTRY_DISK_WEIGHTED_IO_TIME:
+        case ENTRY_NETWORK_BYTES_RECEIVED:
+        case ENTRY_NETWORK_BYTES_SENT:
+        case ENTRY_NETWORK_PACKETS_RECEIVED:
+        case ENTRY_NETWORK_PACKETS_SENT:
+        case ENTRY_NETWORK_RECEIVE_ERRORS:
+        case ENTRY_NETWORK_SEND_ERRORS:
+        case ENTRY_NETWORK_RECEIVE_DROPS:
+        case ENTRY_NETWORK_SEND_DROPS:
+        case ENTRY_TCP_SEGMENTS_SENT:
+        case ENTRY_TCP_RETRANSMITTED_SEGMENTS:
+        case ENTRY_TCP_LISTEN_OVERFLOWS:
+        case ENTRY_TCP_LISTEN_DROPS:
+        case ENTRY_TCP_BACKLOG_DROPS:
+        case ENTRY_TCP_ESTABLISHED:
+        case ENTRY_TCP_SOCKETS:
+        case ENTRY_TCP_TIME_WAIT:
+        case ENTRY_TCP_MEMORY:
+        case ENTRY_UDP_SOCKETS:
+        case ENTRY_UDP_MEMORY:
+        case ENTRY_UDP_RECEIVE_BUFFER_ERRORS:
+        case ENTRY_SOCKETS:
+        case ENTRY_PROCESS_VIRTUAL_MEMORY:
+        case ENTRY_PROCESS_RESIDENT_MEMORY:
+        case ENTRY_PROCESS_PEAK_RESIDENT_MEMORY:
+        case ENTRY_PROCESS_SWAPPED_MEMORY:
+        case ENTRY_PROCESS_MINOR_FAULTS:
+        case ENTRY_PROCESS_MAJOR_FAULTS:
+        case ENTRY_PROCESS_VOLUNTARY_SWITCHES:
+        case ENTRY_PROCESS_INVOLUNTARY_SWITCHES:
+        case ENTRY_PROCESS_USER_TIME:
+        case ENTRY_PROCESS_SYSTEM_TIME:
+        case ENTRY_PROCESS_THREADS:
+        case ENTRY_PROCESS_OPEN_FILES:
+        case ENTRY_CPU_PRESSURE_SOME_AVG10:
+        case ENTRY_CPU_PRESSURE_SOME_AVG60:
+        case ENTRY_CPU_PRESSURE_SOME_AVG300:
+        case ENTRY_CPU_PRESSURE_SOME_TOTAL:
+        case ENTRY_MEMORY_PRESSURE_SOME_AVG10:
+        case ENTRY_MEMORY_PRESSURE_SOME_AVG60:
+        case ENTRY_MEMORY_PRESSURE_SOME_AVG300:
+        case ENTRY_MEMORY_PRESSURE_SOME_TOTAL:
+        case ENTRY_MEMORY_PRESSURE_FULL_AVG10:
+        case ENTRY_MEMORY_PRESSURE_FULL_AVG60:
+        case ENTRY_MEMORY_PRESSURE_FULL_AVG300:
+        case ENTRY_MEMORY_PRESSURE_FULL_TOTAL:
+        case ENTRY_IO_PRESSURE_SOME_AVG10:
+        case ENTRY_IO_PRESSURE_SOME_AVG60:
+        case ENTRY_IO_PRESSURE_SOME_AVG300:
+        case ENTRY_IO_PRESSURE_SOME_TOTAL:
+        case ENTRY_IO_PRESSURE_FULL_AVG10:
+        case ENTRY_IO_PRESSURE_FULL_AVG60:
+        case ENTRY_IO_PRESSURE_FULL_AVG300:
+        case ENTRY_IO_PRESSURE_FULL_TOTAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const InformationSnapshot& GetHardwareProfile()
+{
+    /* Query static entries only once; initialization of local statics is thread-safe */
+    static const InformationSnapshot profile = QueryHardwareProfile();
+    return profile;
+}
+
+void QueryInformation(InformationSnapshot& snapshot)
+{
+    QueryInformation(snapshot, InformationEntrySet::All());
+}
+
+void QueryInformation(InformationSnapshot& snapshot, const InformationEntrySet& entries)
+{
+    /* Copy static entries from the hardware profile and only collect the volatile entries */
+    snapshot = GetHardwareProfile();
+
+    InformationEntrySet volatileEntries = GetEntrySet(true);
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        if (!entries.Has(static_cast<InformationEntry>(i)))
+            volatileEntries.Remove(static_cast<InformationEntry>(i));
+    }
+
+    RunCollectors(snapshot, volatileEntries);
+    RemoveOtherEntries(snapshot, entries);
+}
+
+void RefreshInformation(InformationSnapshot& snapshot)
+{
+    static const InformationEntrySet volatileEntries = GetEntrySet(true);
+
+    /* Remove old values first, so entries that can no longer be collected don't keep stale values */
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        if (volatileEntries.Has(static_cast<InformationEntry>(i)))
+            snapshot.Remove(static_cast<InformationEntry>(i));
+    }
+
+    RunCollectors(snapshot, volatileEntries);
+}
+
+InformationEntryCost GetEntryCost(const InformationEntry entry)
+{
+    const EntryCollector& collector = GetEntryCollectors()[entry];
+    return (collector.collect != 0 ? collector.cost : ENTRY_COST_UNAVAILABLE);
+}
+
+InformationEntryMap QueryInformation()
+{
+    InformationSnapshot snapshot;
+    QueryInformation(snapshot);
+    return MakeEntryMap(snapshot);
+}
+
+InformationEntryMap MakeEntryMap(const InformationSnapshot& snapshot)
+{
+    InformationEntryMap entries;
+
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const InformationEntry entry = static_cast<InformationEntry>(i);
+
+        switch (snapshot.GetType(entry))
+        {
+            case VALUE_NUMBER:
+            {
+                char number[32];
+                const unsigned long long value = snapshot.GetNumber(entry);
+                const unsigned int decimals = InformationEntryDecimals(entry);
+
+                if (decimals > 0)
+                {
+                    unsigned long long scale = 1;
+                    for (unsigned int j = 0; j < decimals; ++j)
+                        scale *= 10;
+                    std::snprintf(number, sizeof(number), "%llu.%0*llu", value / scale, static_cast<int>(decimals), value % scale);
+                }
+                else
+                    std::snprintf(number, sizeof(number), "%llu", value);
+
+                entries[entry] = number;
+            }
+            break;
+
+            case VALUE_TEXT:
+                entries[entry] = snapshot.GetText(entry);
+                break;
+
+            default:
+                break;
+        }
     }
 
-    /* Extend some value */
-    if (entries.find(ENTRY_PROCESSOR_SPEED) != entries.end())
-        entries[ENTRY_PROCESSOR_SPEED] += " MHz";
-    if (entries.find(ENTRY_TOTAL_MEMORY) != entries.end())
-        entries[ENTRY_TOTAL_MEMORY] += " MB";
-    if (entries.find(ENTRY_FREE_MEMORY) != entries.end())
-        entries[ENTRY_FREE_MEMORY] += " MB";
-
-    /* Write information to output stream */
-    std::size_t num = 0;
-
-    #define PRINT_ENTRY(ENTRY) \
-        PrintEntry(stream, num, maxLen, entries, entryNames[ENTRY], ENTRY)
-    #define PRINT_CACHE_ENTRY(CENTRY, SENTRY) \
-        PrintCacheEntry(stream, num, maxLen, entries, entryNames[CENTRY], CENTRY, SENTRY)
-    #define PRINT_BLANK \
-        PrintBlank(stream, num)
-
-    PRINT_ENTRY         ( ENTRY_OS_NAME                      );
-    PRINT_ENTRY         ( ENTRY_COMPILER                     );
-    PRINT_BLANK;
-    PRINT_ENTRY         ( ENTRY_CPU_NAME                     );
-    PRINT_ENTRY         ( ENTRY_CPU_VENDOR                   );
-    PRINT_ENTRY         ( ENTRY_CPU_TYPE                     );
-    PRINT_ENTRY         ( ENTRY_CPU_ARCH                     );
-    PRINT_ENTRY         ( ENTRY_CPU_EXT                      );
-    PRINT_BLANK;
-    PRINT_ENTRY         ( ENTRY_PROCESSORS                   );
-    PRINT_ENTRY         ( ENTRY_LOGICAL_PROCESSORS           );
-    PRINT_ENTRY         ( ENTRY_PROCESSOR_SPEED              );
-    PRINT_BLANK;
-    PRINT_CACHE_ENTRY   ( ENTRY_L1CACHES, ENTRY_L1CACHE_SIZE );
-    PRINT_CACHE_ENTRY   ( ENTRY_L2CACHES, ENTRY_L2CACHE_SIZE );
-    PRINT_CACHE_ENTRY   ( ENTRY_L3CACHES, ENTRY_L3CACHE_SIZE );
-    PRINT_BLANK;
-    PRINT_ENTRY         ( ENTRY_TOTAL_MEMORY                 );
-    PRINT_ENTRY         ( ENTRY_FREE_MEMORY                  );
-
-    #undef PRINT_BLANK
-    #undef PRINT_CACHE_ENTRY
-    #undef PRINT_ENTRY
-
-    return stream;
+    return entries;
 }
 
 
@@ -0,0 +1,88 @@
+/*
+ * Win32Frequency.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorFrequency.h>
+#include <Windows.h>
+#include <powrprof.h>
+#include "../ProcessorInfo.h"
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Output structure of 'CallNtPowerInformation(ProcessorInformation)', which is not declared in the Windows SDK headers.
+struct ProcessorPowerInformation
+{
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+};
+
+
+/*
+ * Global functions
+ */
+
+bool QueryCPUFrequencies(std::vector<CPUFrequency>& frequencies)
+{
+    /* This only covers the processor group of the calling thread */
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    std::vector<ProcessorPowerInformation> powerInfo(systemInfo.dwNumberOfProcessors);
+    const ULONG size = static_cast<ULONG>(powerInfo.size() * sizeof(ProcessorPowerInformation));
+
+    if (CallNtPowerInformation(ProcessorInformation, NULL, 0, powerInfo.data(), size) != 0)
+        return false;
+
+    frequencies.resize(powerInfo.size());
+
+    for (std::size_t i = 0; i < powerInfo.size(); ++i)
+    {
+        CPUFrequency& frequency = frequencies[i];
+        frequency = CPUFrequency();
+        frequency.cpu           = powerInfo[i].Number;
+        frequency.current       = static_cast<unsigned long long>(powerInfo[i].CurrentMhz) * 1000;
+        frequency.maximum       = static_cast<unsigned long long>(powerInfo[i].MhzLimit) * 1000;
+        frequency.hardwareMax   = static_cast<unsigned long long>(powerInfo[i].MaxMhz) * 1000;
+    }
+
+    return !frequencies.empty();
+}
+
+bool ReadRawMonotonicClock(unsigned long long& ns)
+{
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0 && !QueryPerformanceFrequency(&frequency))
+        return false;
+
+    LARGE_INTEGER counter;
+    if (!QueryPerformanceCounter(&counter))
+        return false;
+
+    /* Split conversion to avoid overflow of 'counter * 1e9' */
+    const unsigned long long ticks      = static_cast<unsigned long long>(counter.QuadPart);
+    const unsigned long long ticksPerS  = static_cast<unsigned long long>(frequency.QuadPart);
+
+    ns = (ticks / ticksPerS) * 1000000000ull + (ticks % ticksPerS) * 1000000000ull / ticksPerS;
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,79 @@
+/*
+ * Win32Limits.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorLimits.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorPlacement.h>
+#include <Windows.h>
+#include <cmath>
+
+
+namespace SystemIndicator
+{
+
+
+bool QueryResourceLimits(ResourceLimits& limits)
+{
+    limits = ResourceLimits();
+
+    /* Query host values */
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    limits.hostCPUs = systemInfo.dwNumberOfProcessors;
+
+    MemoryInfo memInfo;
+    if (QueryMemoryInfo(memInfo))
+        limits.hostMemory = memInfo.total;
+
+    /* Query job object limits (the equivalent of cgroups on Windows) */
+    JOBOBJECT_CPU_RATE_CONTROL_INFORMATION cpuRate = {};
+    if (QueryInformationJobObject(NULL, JobObjectCpuRateControlInformation, &cpuRate, sizeof(cpuRate), NULL))
+    {
+        /* Hard cap is specified in 1/100 of a percent of all processors */
+        if ((cpuRate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) != 0 && (cpuRate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP) != 0)
+            limits.cpuQuota = static_cast<double>(cpuRate.CpuRate) / 10000.0 * limits.hostCPUs;
+    }
+
+    JOBOBJECT_EXTENDED_LIMIT_INFORMATION extendedLimits = {};
+    if (QueryInformationJobObject(NULL, JobObjectExtendedLimitInformation, &extendedLimits, sizeof(extendedLimits), NULL))
+    {
+        const DWORD flags = extendedLimits.BasicLimitInformation.LimitFlags;
+        if ((flags & JOB_OBJECT_LIMIT_JOB_MEMORY) != 0)
+            limits.memoryMax = extendedLimits.JobMemoryLimit / 1024;
+        else if ((flags & JOB_OBJECT_LIMIT_PROCESS_MEMORY) != 0)
+            limits.memoryMax = extendedLimits.ProcessMemoryLimit / 1024;
+    }
+
+    GetProcessAffinity(limits.cpus);
+
+    /* Determine effective limits */
+    limits.effectiveCPUs = limits.hostCPUs;
+
+    const unsigned int allowedCPUs = static_cast<unsigned int>(limits.cpus.Count());
+    if (allowedCPUs > 0 && allowedCPUs < limits.effectiveCPUs)
+        limits.effectiveCPUs = allowedCPUs;
+
+    if (limits.cpuQuota > 0.0)
+    {
+        const unsigned int quotaCPUs = static_cast<unsigned int>(std::ceil(limits.cpuQuota));
+        if (quotaCPUs < limits.effectiveCPUs)
+            limits.effectiveCPUs = (quotaCPUs > 0 ? quotaCPUs : 1);
+    }
+
+    limits.effectiveMemory = limits.hostMemory;
+    if (limits.memoryMax > 0 && limits.memoryMax < limits.effectiveMemory)
+        limits.effectiveMemory = limits.memoryMax;
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,102 @@
+/*
+ * Win32Network.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorNetwork.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Global functions
+ */
+
+bool QueryNetworkInterfaces(std::vector<NetworkInterface>& interfaces)
+{
+    /* Not available yet */
+    interfaces.clear();
+    return false;
+}
+
+bool QueryNetworkInterface(const char* name, NetworkInterface& networkInterface)
+{
+    /* Not available yet */
+    networkInterface = NetworkInterface();
+    return false;
+}
+
+bool QueryNetworkInterfaceCounters(const char* name, NetworkCounters& counters)
+{
+    /* Not available yet */
+    counters = NetworkCounters();
+    return false;
+}
+
+bool QueryNetworkCounters(NetworkCounters& total)
+{
+    /* Not available yet */
+    total = NetworkCounters();
+    return false;
+}
+
+bool QueryNetworkStackCounters(NetworkStackCounters& counters)
+{
+    /* Not available yet */
+    counters = NetworkStackCounters();
+    return false;
+}
+
+
+/*
+ * NetworkSampler class
+ */
+
+NetworkSampler::NetworkSampler() :
+    fd_         ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+NetworkSampler::~NetworkSampler()
+{
+}
+
+bool NetworkSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+
+/*
+ * NetworkStackSampler class
+ */
+
+NetworkStackSampler::NetworkStackSampler() :
+    timestamp_  ( 0   ),
+    interval_   ( 0.0 )
+{
+    fds_[0] = fds_[1] = fds_[2] = -1;
+}
+
+NetworkStackSampler::~NetworkStackSampler()
+{
+}
+
+bool NetworkStackSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
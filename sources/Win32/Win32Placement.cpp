@@ -0,0 +1,73 @@
+/*
+ * Win32Placement.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorPlacement.h>
+#include <Windows.h>
+
+
+namespace SystemIndicator
+{
+
+
+bool SetThreadAffinity(const CPUSet& cpus)
+{
+    /* Only the CPUs of the current processor group are supported */
+    DWORD_PTR mask = 0;
+
+    for (int cpu = cpus.First(); cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR)*8); cpu = cpus.Next(cpu))
+        mask |= (static_cast<DWORD_PTR>(1) << cpu);
+
+    return (mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0);
+}
+
+bool GetThreadAffinity(CPUSet& cpus)
+{
+    cpus.Clear();
+
+    /* Query the thread affinity by setting it to the process affinity and restoring it afterwards */
+    DWORD_PTR processMask = 0, systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+
+    const DWORD_PTR threadMask = SetThreadAffinityMask(GetCurrentThread(), processMask);
+    if (threadMask == 0)
+        return false;
+
+    SetThreadAffinityMask(GetCurrentThread(), threadMask);
+
+    for (unsigned int cpu = 0; cpu < sizeof(DWORD_PTR)*8; ++cpu)
+    {
+        if (((threadMask >> cpu) & 0x1) != 0)
+            cpus.Add(cpu);
+    }
+
+    return true;
+}
+
+bool GetProcessAffinity(CPUSet& cpus)
+{
+    cpus.Clear();
+
+    DWORD_PTR processMask = 0, systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+
+    for (unsigned int cpu = 0; cpu < sizeof(DWORD_PTR)*8; ++cpu)
+    {
+        if (((processMask >> cpu) & 0x1) != 0)
+            cpus.Add(cpu);
+    }
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
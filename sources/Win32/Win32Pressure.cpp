@@ -0,0 +1,50 @@
+/*
+ * Win32Pressure.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorPressure.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * PressureMonitor class
+ */
+
+PressureMonitor::PressureMonitor()
+{
+    fds_[0] = fds_[1] = fds_[2] = -1;
+}
+
+PressureMonitor::~PressureMonitor()
+{
+}
+
+bool PressureMonitor::Open(const PressureScope scope)
+{
+    /* Not available on this platform */
+    return false;
+}
+
+void PressureMonitor::Close()
+{
+}
+
+bool PressureMonitor::Read(PressureInfo& info)
+{
+    /* Not available on this platform */
+    info = PressureInfo();
+    return false;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
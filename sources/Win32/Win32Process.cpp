@@ -0,0 +1,69 @@
+/*
+ * Win32Process.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorProcess.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Global functions
+ */
+
+bool QueryProcessUsage(ProcessUsage& usage, bool countOpenFiles)
+{
+    /* Not available yet */
+    usage = ProcessUsage();
+    return false;
+}
+
+bool QueryProcessOpenFiles(unsigned int& count)
+{
+    /* Not available yet */
+    count = 0;
+    return false;
+}
+
+bool QueryProcessMemoryDetails(ProcessMemoryDetails& details)
+{
+    /* Not available yet */
+    details = ProcessMemoryDetails();
+    return false;
+}
+
+
+/*
+ * ProcessSampler class
+ */
+
+ProcessSampler::ProcessSampler() :
+    statmFd_    ( -1 ),
+    statusFd_   ( -1 ),
+    taskDirFd_  ( -1 ),
+    fdDirFd_    ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+ProcessSampler::~ProcessSampler()
+{
+}
+
+bool ProcessSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
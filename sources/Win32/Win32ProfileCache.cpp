@@ -0,0 +1,42 @@
+/*
+ * Win32ProfileCache.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorProfileCache.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Global functions
+ */
+
+bool GetDefaultProfileCachePath(char* buffer, std::size_t size)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool SaveHardwareProfile(const char* filename, const InformationSnapshot& profile)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool LoadHardwareProfile(const char* filename, InformationSnapshot& profile)
+{
+    /* Not available yet */
+    return false;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,61 @@
+/*
+ * Win32Sampler.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorSampler.h>
+#include <Windows.h>
+#include <algorithm>
+
+
+namespace SystemIndicator
+{
+
+
+static unsigned long long FileTimeToUInt64(const FILETIME& fileTime)
+{
+    return ((static_cast<unsigned long long>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime);
+}
+
+CPUSampler::CPUSampler() :
+    fd_ ( -1 )
+{
+    std::fill(totalCounters_, totalCounters_ + numCounters, 0ull);
+
+    /* Take initial sample, so the first call to 'Sample' reports the utilization since construction */
+    Sample();
+    total_ = CPUUsage();
+}
+
+CPUSampler::~CPUSampler()
+{
+}
+
+bool CPUSampler::Sample()
+{
+    /* Only the total utilization is available; the kernel time includes the idle time */
+    FILETIME idleTime, kernelTime, userTime;
+    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime))
+        return false;
+
+    const unsigned long long idle   = FileTimeToUInt64(idleTime);
+    const unsigned long long kernel = FileTimeToUInt64(kernelTime);
+
+    unsigned long long current[numCounters] = { 0 };
+    current[0] = FileTimeToUInt64(userTime);
+    current[2] = (kernel > idle ? kernel - idle : 0);
+    current[3] = idle;
+
+    UpdateUsage(totalCounters_, current, total_);
+
+    return true;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,72 @@
+/*
+ * Win32Storage.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorStorage.h>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Global functions
+ */
+
+bool QueryBlockDevices(std::vector<BlockDevice>& devices)
+{
+    /* Not available yet */
+    devices.clear();
+    return false;
+}
+
+bool QueryBlockDeviceQueue(const char* name, BlockDeviceQueue& queue)
+{
+    /* Not available yet */
+    queue = BlockDeviceQueue();
+    return false;
+}
+
+bool QueryBlockDeviceOfPath(const char* path, char* name, std::size_t size)
+{
+    /* Not available yet */
+    return false;
+}
+
+bool QueryDiskCounters(BlockDeviceCounters& total)
+{
+    /* Not available yet */
+    total = BlockDeviceCounters();
+    return false;
+}
+
+
+/*
+ * DiskSampler class
+ */
+
+DiskSampler::DiskSampler() :
+    fd_         ( -1 ),
+    timestamp_  ( 0  )
+{
+}
+
+DiskSampler::~DiskSampler()
+{
+}
+
+bool DiskSampler::Sample()
+{
+    /* Not available yet */
+    return false;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -6,8 +6,11 @@
  */
 
 #include <SystemIndicator.h>
-#include "ProcessorInfo.h"
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorLimits.h>
+#include "../ProcessorInfo.h"
 #include "../Helper.h"
+#include "../Collector.h"
 #include <Windows.h>
 #include <vector>
 #include <array>
@@ -136,17 +139,84 @@ static std::string QueryCPUArchitecture()
     return "";
 }
 
-static void QueryMemoryStatus(std::string& total, std::string& avail)
+static void QueryMemoryStatus(InformationSnapshot& snapshot)
 {
     /* Query memory status */
     MEMORYSTATUSEX memoryStatus;
     memoryStatus.dwLength = sizeof(memoryStatus);
-    GlobalMemoryStatusEx(&memoryStatus);
+    if (!GlobalMemoryStatusEx(&memoryStatus))
+        return;
 
     static const DWORDLONG divMB = 1024*1024;
 
-    total = ToString(memoryStatus.ullTotalPhys / divMB);
-    avail = ToString(memoryStatus.ullAvailPhys / divMB);
+    snapshot.SetNumber(ENTRY_TOTAL_MEMORY, memoryStatus.ullTotalPhys / divMB);
+    snapshot.SetNumber(ENTRY_FREE_MEMORY, memoryStatus.ullAvailPhys / divMB);
+}
+
+bool QueryMemoryInfo(MemoryInfo& info)
+{
+    info = MemoryInfo();
+
+    MEMORYSTATUSEX memoryStatus;
+    memoryStatus.dwLength = sizeof(memoryStatus);
+    if (!GlobalMemoryStatusEx(&memoryStatus))
+        return false;
+
+    static const DWORDLONG divKB = 1024;
+
+    info.total          = memoryStatus.ullTotalPhys / divKB;
+    info.free           = memoryStatus.ullAvailPhys / divKB;
+    info.available      = memoryStatus.ullAvailPhys / divKB;
+    info.commitLimit    = memoryStatus.ullTotalPageFile / divKB;
+    info.committed      = (memoryStatus.ullTotalPageFile - memoryStatus.ullAvailPageFile) / divKB;
+
+    return true;
+}
+
+bool QueryHugePageInfo(HugePageInfo& info)
+{
+    info = HugePageInfo();
+
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    info.basePageSize = systemInfo.dwPageSize / 1024;
+
+    /* Large pages are allocated on demand with "VirtualAlloc(MEM_LARGE_PAGES)", so there are no pools to report */
+    info.defaultHugePageSize = GetLargePageMinimum() / 1024;
+
+    return (info.basePageSize > 0);
+}
+
+bool QueryTransparentHugePages(TransparentHugePageInfo& info)
+{
+    /* Transparent huge pages are not supported on Windows */
+    info = TransparentHugePageInfo();
+    return false;
+}
+
+bool QueryMemoryFragmentation(MemoryFragmentation& fragmentation)
+{
+    /* Not available yet */
+    fragmentation.zones.clear();
+    return false;
+}
+
+bool QueryAvailableMemoryBlocks(unsigned int order, unsigned long long& blocks)
+{
+    /* Not available yet */
+    blocks = 0;
+    return false;
+}
+
+void SetFileSystemRoot(const char* root)
+{
+    /* Only used for procfs and sysfs on Linux */
+}
+
+const char* GetFileSystemRoot()
+{
+    return "";
 }
 
 static std::string QueryOSName()
@@ -291,38 +361,6 @@ static std::string QueryOSName()
     return UNKNOWN_WIN_VER;
 }
 
-static void AddCPUExt(std::string& ext, bool enabled, const std::string& feature)
-{
-    if (enabled)
-    {
-        if (!ext.empty())
-            ext += ", ";
-        ext += feature;
-    }
-}
-
-static std::string QueryCPUExtensions(const ProcessorInfo& cpuInfo)
-{
-    std::string ext;
-
-    AddCPUExt( ext, cpuInfo.HasSSE     (), "SSE"         );
-    AddCPUExt( ext, cpuInfo.HasSSE2    (), "SSE2"        );
-    AddCPUExt( ext, cpuInfo.HasSSE3    (), "SSE3"        );
-    AddCPUExt( ext, cpuInfo.HasSSSE3   (), "SSSE3"       );
-    AddCPUExt( ext, cpuInfo.HasSSE4_1  (), "SSE4.1"      );
-    AddCPUExt( ext, cpuInfo.HasSSE4_2  (), "SSE4.2"      );
-    AddCPUExt( ext, cpuInfo.HasMMX     (), "MMX"         );
-    AddCPUExt( ext, cpuInfo.HasExtMMX  (), "Ext. MMX"    );
-    AddCPUExt( ext, cpuInfo.Has3DNow   (), "3DNow!"      );
-    AddCPUExt( ext, cpuInfo.HasExt3DNow(), "Ext. 3DNow!" );
-    AddCPUExt( ext, cpuInfo.HasHTT     (), "HTT"         );
-
-    if (ext.empty())
-        ext = "<none>";
-
-    return ext;
-}
-
 struct LogicalCPUInfo
 {
     LogicalCPUInfo() :
@@ -416,56 +454,220 @@ static bool QueryLogicalProcessorInfo(LogicalCPUInfo& cpuInfo)
     return true;
 }
 
-InformationEntryMap QueryInformation()
+static void CollectOSFamily(InformationSnapshot& snapshot)
 {
-    static const unsigned int divKB = 1024;
+    snapshot.SetText(ENTRY_OS_FAMILY, "WIN32");
+}
+
+static void CollectOSName(InformationSnapshot& snapshot)
+{
+    snapshot.SetText(ENTRY_OS_NAME, QueryOSName().c_str());
+}
+
+static void CollectCompiler(InformationSnapshot& snapshot)
+{
+    snapshot.SetText(ENTRY_COMPILER, QueryCompilerVersion().c_str());
+}
 
-    /* Query processor information */
+static void CollectProcessorInfo(InformationSnapshot& snapshot)
+{
     ProcessorInfo cpuInfo;
-    LogicalCPUInfo cpuInfo2;
 
-    QueryLogicalProcessorInfo(cpuInfo2);
+    char cpuExt[512];
+    const std::size_t cpuExtLen = cpuInfo.GetExtensions(cpuExt, sizeof(cpuExt));
 
-    /* Query memory status */
-    std::string totalMem, availMem;
-    QueryMemoryStatus(totalMem, availMem);
+    snapshot.SetText( ENTRY_CPU_NAME,   cpuInfo.GetName()       );
+    snapshot.SetText( ENTRY_CPU_VENDOR, cpuInfo.GetVendorName() );
+    snapshot.SetText( ENTRY_CPU_EXT,    cpuExt, cpuExtLen       );
+}
+
+static void CollectCPUType(InformationSnapshot& snapshot)
+{
+    snapshot.SetText(ENTRY_CPU_TYPE, (IsWoW64() ? "64-Bit" : "32-Bit"));
+}
 
-    /* Setup output entries */
-    InformationEntryMap info;
+static void CollectCPUArchitecture(InformationSnapshot& snapshot)
+{
+    snapshot.SetText(ENTRY_CPU_ARCH, QueryCPUArchitecture().c_str());
+}
 
-    info[ ENTRY_OS_FAMILY          ] = "WIN32";
-    info[ ENTRY_OS_NAME            ] = QueryOSName();
-    info[ ENTRY_COMPILER           ] = QueryCompilerVersion();
+static void CollectLogicalProcessorInfo(InformationSnapshot& snapshot)
+{
+    static const unsigned int divKB = 1024;
 
-    info[ ENTRY_CPU_NAME           ] = cpuInfo.GetName();
-    info[ ENTRY_CPU_VENDOR         ] = cpuInfo.GetVendorName();
-    info[ ENTRY_CPU_TYPE           ] = (IsWoW64() ? "64-Bit" : "32-Bit");
-    info[ ENTRY_CPU_ARCH           ] = QueryCPUArchitecture();
-    info[ ENTRY_CPU_EXT            ] = QueryCPUExtensions(cpuInfo);
+    LogicalCPUInfo cpuInfo;
+    if (!QueryLogicalProcessorInfo(cpuInfo))
+        return;
 
-    info[ ENTRY_PROCESSORS         ] = ToString(cpuInfo2.numCores);
-    info[ ENTRY_LOGICAL_PROCESSORS ] = ToString(cpuInfo2.numLogicalCores);
-    info[ ENTRY_PROCESSOR_SPEED    ] = ToString(QueryProcessorSpeed());
+    snapshot.SetNumber ( ENTRY_PROCESSORS,         cpuInfo.numCores                 );
+    snapshot.SetNumber ( ENTRY_LOGICAL_PROCESSORS, cpuInfo.numLogicalCores          );
 
-    info[ ENTRY_L1CACHES           ] = ToString(cpuInfo2.caches[0].count);
-    info[ ENTRY_L1CACHE_SIZE       ] = ToString(cpuInfo2.caches[0].size / divKB);
-    info[ ENTRY_L1CACHE_LINE_SIZE  ] = ToString(cpuInfo2.caches[0].lineSize);
+    snapshot.SetNumber ( ENTRY_L1CACHES,           cpuInfo.caches[0].count          );
+    snapshot.SetNumber ( ENTRY_L1CACHE_SIZE,       cpuInfo.caches[0].size / divKB   );
+    snapshot.SetNumber ( ENTRY_L1CACHE_LINE_SIZE,  cpuInfo.caches[0].lineSize       );
 
-    info[ ENTRY_L2CACHES           ] = ToString(cpuInfo2.caches[1].count);
-    info[ ENTRY_L2CACHE_SIZE       ] = ToString(cpuInfo2.caches[1].size / divKB);
-    info[ ENTRY_L2CACHE_LINE_SIZE  ] = ToString(cpuInfo2.caches[1].lineSize);
+    snapshot.SetNumber ( ENTRY_L2CACHES,           cpuInfo.caches[1].count          );
+    snapshot.SetNumber ( ENTRY_L2CACHE_SIZE,       cpuInfo.caches[1].size / divKB   );
+    snapshot.SetNumber ( ENTRY_L2CACHE_LINE_SIZE,  cpuInfo.caches[1].lineSize       );
 
-    if (cpuInfo2.caches[2].count > 0)
+    if (cpuInfo.caches[2].count > 0)
     {
-        info[ ENTRY_L3CACHES          ] = ToString(cpuInfo2.caches[2].count);
-        info[ ENTRY_L3CACHE_SIZE      ] = ToString(cpuInfo2.caches[2].size / divKB);
-        info[ ENTRY_L3CACHE_LINE_SIZE ] = ToString(cpuInfo2.caches[2].lineSize);
+        snapshot.SetNumber ( ENTRY_L3CACHES,          cpuInfo.caches[2].count           );
+        snapshot.SetNumber ( ENTRY_L3CACHE_SIZE,      cpuInfo.caches[2].size / divKB    );
+        snapshot.SetNumber ( ENTRY_L3CACHE_LINE_SIZE, cpuInfo.caches[2].lineSize        );
     }
+}
+
+static void CollectProcessorSpeed(InformationSnapshot& snapshot)
+{
+    snapshot.SetNumber(ENTRY_PROCESSOR_SPEED, QueryProcessorSpeed());
+}
 
-    info[ ENTRY_TOTAL_MEMORY       ] = totalMem;
-    info[ ENTRY_FREE_MEMORY        ] = availMem;
+static void CollectEffectiveLimits(InformationSnapshot& snapshot)
+{
+    ResourceLimits limits;
+    if (!QueryResourceLimits(limits))
+        return;
 
-    return info;
+    snapshot.SetNumber(ENTRY_EFFECTIVE_PROCESSORS, limits.effectiveCPUs);
+    if (limits.effectiveMemory > 0)
+        snapshot.SetNumber(ENTRY_EFFECTIVE_MEMORY, limits.effectiveMemory / 1024);
+}
+
+static const EntryCollector g_entryCollectors[] =
+{
+    { CollectOSFamily,              ENTRY_COST_CONSTANT     }, // ENTRY_OS_FAMILY
+    { CollectOSName,                ENTRY_COST_SYSCALL      }, // ENTRY_OS_NAME
+    { CollectCompiler,              ENTRY_COST_CONSTANT     }, // ENTRY_COMPILER
+
+    { CollectProcessorInfo,         ENTRY_COST_INSTRUCTION  }, // ENTRY_CPU_NAME
+    { CollectProcessorInfo,         ENTRY_COST_INSTRUCTION  }, // ENTRY_CPU_VENDOR
+    { CollectCPUType,               ENTRY_COST_SYSCALL      }, // ENTRY_CPU_TYPE
+    { CollectCPUArchitecture,       ENTRY_COST_SYSCALL      }, // ENTRY_CPU_ARCH
+    { CollectProcessorInfo,         ENTRY_COST_INSTRUCTION  }, // ENTRY_CPU_EXT
+
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_PROCESSORS
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_LOGICAL_PROCESSORS
+    { CollectProcessorSpeed,        ENTRY_COST_FILE_IO      }, // ENTRY_PROCESSOR_SPEED
+    { CollectEffectiveLimits,       ENTRY_COST_SYSCALL      }, // ENTRY_EFFECTIVE_PROCESSORS
+
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHES
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHE_SIZE
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L1CACHE_LINE_SIZE
+
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHES
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHE_SIZE
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L2CACHE_LINE_SIZE
+
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHES
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHE_SIZE
+    { CollectLogicalProcessorInfo,  ENTRY_COST_ENUMERATION  }, // ENTRY_L3CACHE_LINE_SIZE
+
+    { QueryMemoryStatus,            ENTRY_COST_SYSCALL      }, // ENTRY_TOTAL_MEMORY
+    { CollectEffectiveLimits,       ENTRY_COST_SYSCALL      }, // ENTRY_EFFECTIVE_MEMORY
+    { QueryMemoryStatus,            ENTRY_COST_SYSCALL      }, // ENTRY_FREE_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_AVAILABLE_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_CACHED_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_BUFFERED_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DIRTY_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_COMMITTED_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TOTAL_SWAP
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_FREE_SWAP
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_HUGE_PAGE_SIZE
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_HUGE_PAGES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_FREE_HUGE_PAGES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_RESERVED_HUGE_PAGES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ANON_HUGE_PAGE_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TRANSPARENT_HUGE_PAGES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TRANSPARENT_HUGE_PAGE_DEFRAG
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_FREE_HUGE_PAGE_BLOCKS
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_READS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_WRITES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_BYTES_READ
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_BYTES_WRITTEN
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_IN_FLIGHT
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_IO_TIME
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_DISK_WEIGHTED_IO_TIME
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_ROTATIONAL
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_LOGICAL_BLOCK_SIZE
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_PHYSICAL_BLOCK_SIZE
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_OPTIMAL_IO_SIZE
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_MAX_IO_SIZE
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_READ_AHEAD
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_QUEUE_REQUESTS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_ROOT_DISK_SCHEDULER
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_BYTES_RECEIVED
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_BYTES_SENT
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_PACKETS_RECEIVED
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_PACKETS_SENT
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_RECEIVE_ERRORS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_SEND_ERRORS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_RECEIVE_DROPS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_NETWORK_SEND_DROPS
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_SEGMENTS_SENT
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_RETRANSMITTED_SEGMENTS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_LISTEN_OVERFLOWS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_LISTEN_DROPS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_BACKLOG_DROPS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_ESTABLISHED
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_SOCKETS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_TIME_WAIT
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_TCP_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_UDP_SOCKETS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_UDP_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_UDP_RECEIVE_BUFFER_ERRORS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_SOCKETS
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_VIRTUAL_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_RESIDENT_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_PEAK_RESIDENT_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_SWAPPED_MEMORY
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_MINOR_FAULTS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_MAJOR_FAULTS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_VOLUNTARY_SWITCHES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_INVOLUNTARY_SWITCHES
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_USER_TIME
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_SYSTEM_TIME
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_THREADS
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_PROCESS_OPEN_FILES
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_CPU_PRESSURE_SOME_AVG10
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_CPU_PRESSURE_SOME_AVG60
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_CPU_PRESSURE_SOME_AVG300
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_CPU_PRESSURE_SOME_TOTAL
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_SOME_AVG10
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_SOME_AVG60
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_SOME_AVG300
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_SOME_TOTAL
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_FULL_AVG10
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_FULL_AVG60
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_FULL_AVG300
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_MEMORY_PRESSURE_FULL_TOTAL
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_SOME_AVG10
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_SOME_AVG60
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_SOME_AVG300
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_SOME_TOTAL
+
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_FULL_AVG10
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_FULL_AVG60
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_FULL_AVG300
+    { 0,                            ENTRY_COST_UNAVAILABLE  }, // ENTRY_IO_PRESSURE_FULL_TOTAL
+};
+
+static_assert(sizeof(g_entryCollectors)/sizeof(g_entryCollectors[0]) == ENTRY_COUNT, "collector table must have one descriptor for each information entry");
+
+const EntryCollector* GetEntryCollectors()
+{
+    return g_entryCollectors;
 }
 
 
@@ -0,0 +1,292 @@
+/*
+ * Win32Topology.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicatorTopology.h>
+#include <Windows.h>
+#include <algorithm>
+
+
+namespace SystemIndicator
+{
+
+
+/*
+ * Internal functions
+ */
+
+static CPUSet MakeCPUSet(ULONG_PTR bitMask)
+{
+    CPUSet cpus;
+    for (unsigned int i = 0; i < sizeof(ULONG_PTR)*8; ++i)
+    {
+        if (((bitMask >> i) & 0x1) != 0)
+            cpus.Add(i);
+    }
+    return cpus;
+}
+
+static CacheType MakeCacheType(PROCESSOR_CACHE_TYPE type)
+{
+    switch (type)
+    {
+        case CacheData:         return CACHE_TYPE_DATA;
+        case CacheInstruction:  return CACHE_TYPE_INSTRUCTION;
+        default:                return CACHE_TYPE_UNIFIED;
+    }
+}
+
+// Queries all logical processor information records; this is limited to the processor group of the calling thread (up to 64 CPUs).
+static bool QueryLogicalProcessorInformation(std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION>& infos)
+{
+    /* Query buffer size */
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(NULL, &bufferSize);
+
+    /* Query processor information buffer */
+    infos.resize(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION) + 1);
+    bufferSize = static_cast<DWORD>(infos.size() * sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+
+    if (!GetLogicalProcessorInformation(infos.data(), &bufferSize))
+        return false;
+
+    infos.resize(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    return true;
+}
+
+static unsigned int CacheRank(const CacheInfo& cache)
+{
+    const unsigned int typeRank = (cache.type == CACHE_TYPE_DATA ? 0 : cache.type == CACHE_TYPE_INSTRUCTION ? 1 : 2);
+    return cache.level * 4 + typeRank;
+}
+
+static bool CompareCacheRank(const CacheInfo& lhs, const CacheInfo& rhs)
+{
+    return (CacheRank(lhs) < CacheRank(rhs));
+}
+
+
+/*
+ * Global functions
+ */
+
+bool QueryCacheInfo(std::vector<CacheInfo>& caches)
+{
+    caches.clear();
+
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos;
+    if (!QueryLogicalProcessorInformation(infos))
+        return false;
+
+    /* Enumerate all cache descriptors; each record describes one cache instance */
+    for (std::size_t i = 0; i < infos.size(); ++i)
+    {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION* info = &infos[i];
+        if (info->Relationship != RelationCache)
+            continue;
+
+        const CACHE_DESCRIPTOR& desc = info->Cache;
+        const CacheType type = MakeCacheType(desc.Type);
+
+        std::vector<CacheInfo>::iterator it = caches.begin();
+        while (it != caches.end() && !(it->level == desc.Level && it->type == type))
+            ++it;
+
+        if (it == caches.end())
+        {
+            caches.push_back(CacheInfo());
+            it = caches.end() - 1;
+            it->level       = desc.Level;
+            it->type        = type;
+            it->size        = desc.Size;
+            it->lineSize    = desc.LineSize;
+            it->ways        = (desc.Associativity == CACHE_FULLY_ASSOCIATIVE ? 0 : desc.Associativity);
+        }
+
+        CacheInstance instance;
+        instance.cpus = MakeCPUSet(info->ProcessorMask);
+
+        it->instances.push_back(instance);
+        it->instanceCount = static_cast<unsigned int>(it->instances.size());
+    }
+
+    std::sort(caches.begin(), caches.end(), CompareCacheRank);
+
+    return !caches.empty();
+}
+
+bool QueryCPUTopology(CPUTopology& topology)
+{
+    topology = CPUTopology();
+
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos;
+    if (!QueryLogicalProcessorInformation(infos))
+        return false;
+
+    /* Enumerate packages, cores, and NUMA nodes */
+    for (std::size_t i = 0; i < infos.size(); ++i)
+    {
+        const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& info = infos[i];
+        switch (info.Relationship)
+        {
+            case RelationProcessorPackage:
+            {
+                CPUTopology::Package package;
+                package.id      = static_cast<int>(topology.packages.size());
+                package.cpus    = MakeCPUSet(info.ProcessorMask);
+                topology.packages.push_back(package);
+            }
+            break;
+
+            case RelationProcessorCore:
+            {
+                CPUTopology::Core core;
+                core.id     = static_cast<int>(topology.cores.size());
+                core.cpus   = MakeCPUSet(info.ProcessorMask);
+                topology.cores.push_back(core);
+                topology.online |= core.cpus;
+            }
+            break;
+
+            case RelationNumaNode:
+            {
+                CPUTopology::Node node;
+                node.id     = static_cast<int>(info.NumaNode.NodeNumber);
+                node.cpus   = MakeCPUSet(info.ProcessorMask);
+                topology.nodes.push_back(node);
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    if (topology.online.Empty())
+        return false;
+
+    /* Windows does not report dies, so each package has a single die */
+    for (std::size_t i = 0; i < topology.packages.size(); ++i)
+    {
+        CPUTopology::Die die;
+        die.id      = 0;
+        die.package = static_cast<int>(i);
+        die.cpus    = topology.packages[i].cpus;
+        topology.dies.push_back(die);
+    }
+
+    /* Build logical CPU lookup table */
+    topology.cpus.resize(static_cast<std::size_t>(topology.online.Last()) + 1);
+
+    for (std::size_t i = 0; i < topology.packages.size(); ++i)
+    {
+        const CPUSet& cpus = topology.packages[i].cpus;
+        for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+        {
+            topology.cpus[cpu].package  = static_cast<int>(i);
+            topology.cpus[cpu].die      = static_cast<int>(i);
+        }
+    }
+
+    for (std::size_t i = 0; i < topology.cores.size(); ++i)
+    {
+        CPUTopology::Core& core = topology.cores[i];
+        int smtIndex = 0;
+
+        for (int cpu = core.cpus.First(); cpu >= 0; cpu = core.cpus.Next(cpu))
+        {
+            topology.cpus[cpu].core     = static_cast<int>(i);
+            topology.cpus[cpu].smtIndex = smtIndex++;
+        }
+
+        const int first = core.cpus.First();
+        core.package    = topology.cpus[first].package;
+        core.die        = topology.cpus[first].die;
+    }
+
+    for (std::size_t i = 0; i < topology.nodes.size(); ++i)
+    {
+        const CPUSet& cpus = topology.nodes[i].cpus;
+        for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+            topology.cpus[cpu].node = static_cast<int>(i);
+    }
+
+    return true;
+}
+
+
+bool QueryNUMAInfo(NUMAInfo& info)
+{
+    info = NUMAInfo();
+
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode))
+        return false;
+
+    /* Enumerate nodes and their processor masks */
+    CPUSet online;
+
+    for (ULONG id = 0; id <= highestNode; ++id)
+    {
+        ULONGLONG mask = 0;
+        if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(id), &mask))
+            continue;
+
+        NUMANodeInfo node;
+        node.id     = static_cast<int>(id);
+        node.cpus   = MakeCPUSet(static_cast<ULONG_PTR>(mask));
+        online |= node.cpus;
+        info.nodes.push_back(node);
+    }
+
+    if (info.nodes.empty())
+        return false;
+
+    /* Windows does not report node distances, so only the local distance is known */
+    const std::size_t numNodes = info.nodes.size();
+    info.distances.resize(numNodes * numNodes, 0);
+    for (std::size_t i = 0; i < numNodes; ++i)
+        info.distances[i * numNodes + i] = 10;
+
+    /* Build CPU-to-node mapping */
+    info.cpuNodes.resize(online.Empty() ? 0 : static_cast<std::size_t>(online.Last()) + 1, -1);
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        const CPUSet& cpus = info.nodes[i].cpus;
+        for (int cpu = cpus.First(); cpu >= 0; cpu = cpus.Next(cpu))
+            info.cpuNodes[cpu] = static_cast<int>(i);
+    }
+
+    return QueryNUMAMemory(info);
+}
+
+bool QueryNUMAMemory(NUMAInfo& info)
+{
+    if (info.nodes.empty())
+        return false;
+
+    bool result = true;
+
+    for (std::size_t i = 0; i < info.nodes.size(); ++i)
+    {
+        /* Only the available memory is reported per node */
+        ULONGLONG availableBytes = 0;
+        if (GetNumaAvailableMemoryNodeEx(static_cast<USHORT>(info.nodes[i].id), &availableBytes))
+            info.nodes[i].free = availableBytes / 1024;
+        else
+            result = false;
+    }
+
+    return result;
+}
+
+
+} // /namespace SystemIndicator
+
+
+
+// ================================================================================
@@ -0,0 +1,1664 @@
+/*
+ * Bench.cpp
+ * 
+ * This file is part of the "SystemIndicator" project (Copyright (c) 2016 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <SystemIndicator.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorTopology.h>
+#include <SystemIndicatorCollector.h>
+#include <SystemIndicatorExport.h>
+#include <SystemIndicatorFrequency.h>
+#include <SystemIndicatorPlacement.h>
+#include <SystemIndicatorPressure.h>
+#include <SystemIndicatorProbe.h>
+#include <SystemIndicatorProfileCache.h>
+#include <SystemIndicatorSampler.h>
+#include <SystemIndicatorStorage.h>
+#include <SystemIndicatorNetwork.h>
+#include <SystemIndicatorProcess.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../sources/Collector.h"
+
+#ifdef __linux__
+#   include <ftw.h>
+#   include <stdlib.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace SystemIndicator;
+
+
+// Prevents the compiler from optimizing away the benchmarked results.
+static volatile unsigned long long g_sink = 0;
+
+// Number of heap allocations of the entire process (see the allocation functions below).
+static std::atomic<unsigned long long> g_allocations(0);
+
+
+/*
+ * Allocation counting
+ */
+
+#ifdef __GLIBC__
+
+/*
+Interpose the C allocation functions, so allocations inside the C library (e.g. by 'fopen') are counted as well.
+The 'operator new' of the C++ library calls 'malloc' and is therefore counted, too.
+*/
+extern "C"
+{
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+} // /extern "C"
+
+#else
+
+// Replace the global allocation functions; the array and nothrow variants forward to these by default.
+void* operator new (std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+// Runs the specified function for the specified number of iterations and returns the average duration (in nanoseconds).
+template <typename Func>
+static double MeasureNanoseconds(unsigned int iterations, Func func)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::time_point start = Clock::now();
+
+    for (unsigned int i = 0; i < iterations; ++i)
+        func();
+
+    const Clock::time_point end = Clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+// Latency distribution (in nanoseconds) and heap allocations per call of a benchmarked function.
+struct LatencyDistribution
+{
+    double          cold;           // Latency of the first call.
+    double          p50;
+    double          p99;
+    double          allocations;    // Average number of heap allocations per warm call.
+    unsigned int    samples;
+};
+
+/*
+Runs the specified function once (cold) and then repeatedly (warm) for about 100 milliseconds,
+with at least 10 and at most 10000 samples, and returns the latency distribution of the warm calls.
+*/
+template <typename Func>
+static LatencyDistribution MeasureDistribution(Func func)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    LatencyDistribution dist;
+
+    /* Measure cold call */
+    Clock::time_point start = Clock::now();
+    func();
+    dist.cold = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    /* Measure warm calls; the allocations are only counted within the measured calls */
+    std::vector<double> samples;
+    samples.reserve(10000);
+
+    unsigned long long allocations = 0;
+    const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(100);
+
+    while (samples.size() < 10000 && (samples.size() < 10 || Clock::now() < deadline))
+    {
+        const unsigned long long allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        start = Clock::now();
+        func();
+        const Clock::time_point end = Clock::now();
+        allocations += g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    dist.samples        = static_cast<unsigned int>(samples.size());
+    dist.p50            = samples[samples.size() / 2];
+    dist.p99            = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    dist.allocations    = static_cast<double>(allocations) / samples.size();
+
+    return dist;
+}
+
+static void PrintResult(const char* name, double nanoseconds)
+{
+    std::printf("  %-36s %12.1f ns\n", name, nanoseconds);
+}
+
+static const char* EntryCostName(const InformationEntryCost cost)
+{
+    switch (cost)
+    {
+        case ENTRY_COST_UNAVAILABLE:    return "unavailable";
+        case ENTRY_COST_CONSTANT:       return "constant";
+        case ENTRY_COST_INSTRUCTION:    return "instruction";
+        case ENTRY_COST_SYSCALL:        return "syscall";
+        case ENTRY_COST_FILE_IO:        return "file I/O";
+        case ENTRY_COST_ENUMERATION:    return "enumeration";
+    }
+    return "";
+}
+
+static void PrintDistributionHeader(const char* title)
+{
+    std::printf("%s:\n", title);
+    std::printf("  %-40s %12s %12s %12s %8s %8s\n", "", "cold", "p50", "p99", "allocs", "samples");
+}
+
+static void PrintDistribution(const char* name, const LatencyDistribution& dist)
+{
+    std::printf(
+        "  %-40s %9.1f us %9.1f us %9.1f us %8.1f %8u\n",
+        name, dist.cold * 1.0e-3, dist.p50 * 1.0e-3, dist.p99 * 1.0e-3, dist.allocations, dist.samples
+    );
+}
+
+/*
+Measures the latency of each entry collector. Entries that share the same collector are queried together,
+so each collector is only listed once with the name of its first entry and the number of entries it fills.
+This must run first, so the cold latency includes the first-time initialization of each collector.
+*/
+static void BenchCollectors()
+{
+    PrintDistributionHeader("Entry collectors");
+
+    const EntryCollector* collectors = GetEntryCollectors();
+    InformationSnapshot snapshot;
+
+    for (int i = 0; i < ENTRY_COUNT; ++i)
+    {
+        const CollectorFunc collect = collectors[i].collect;
+        if (collect == 0)
+            continue;
+
+        /* Skip collectors that have already been measured for a previous entry */
+        int numEntries = 0;
+        bool measured = false;
+
+        for (int j = 0; j < ENTRY_COUNT; ++j)
+        {
+            if (collectors[j].collect == collect)
+            {
+                if (j < i)
+                    measured = true;
+                ++numEntries;
+            }
+        }
+
+        if (measured)
+            continue;
+
+        const LatencyDistribution dist = MeasureDistribution(
+            [&]()
+            {
+                snapshot.Clear();
+                collect(snapshot);
+                g_sink += snapshot.GetNumber(static_cast<InformationEntry>(i));
+            }
+        );
+
+        char name[64];
+        if (numEntries > 1)
+            std::snprintf(name, sizeof(name), "%s (+%d, %s)", InformationEntryName(static_cast<InformationEntry>(i)), numEntries - 1, EntryCostName(collectors[i].cost));
+        else
+            std::snprintf(name, sizeof(name), "%s (%s)", InformationEntryName(static_cast<InformationEntry>(i)), EntryCostName(collectors[i].cost));
+
+        PrintDistribution(name, dist);
+    }
+
+    std::printf("\n");
+}
+
+static void BenchQueries()
+{
+    PrintDistributionHeader("Queries");
+
+    PrintDistribution(
+        "GetHardwareProfile",
+        MeasureDistribution(
+            []()
+            {
+                g_sink += GetHardwareProfile().GetNumber(ENTRY_PROCESSORS);
+            }
+        )
+    );
+
+    InformationSnapshot snapshot;
+
+    PrintDistribution(
+        "QueryInformation (full)",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryInformation(snapshot);
+                g_sink += snapshot.GetNumber(ENTRY_FREE_MEMORY);
+            }
+        )
+    );
+
+    PrintDistribution(
+        "RefreshInformation",
+        MeasureDistribution(
+            [&]()
+            {
+                RefreshInformation(snapshot);
+                g_sink += snapshot.GetNumber(ENTRY_FREE_MEMORY);
+            }
+        )
+    );
+
+    PrintDistribution(
+        "QueryInformation (entry map)",
+        MeasureDistribution(
+            []()
+            {
+                g_sink += QueryInformation().size();
+            }
+        )
+    );
+
+    const InformationEntryMap entries = QueryInformation();
+
+    PrintDistribution(
+        "MakeEntryMap",
+        MeasureDistribution(
+            [&]()
+            {
+                g_sink += MakeEntryMap(snapshot).size();
+            }
+        )
+    );
+
+    char buffer[8192];
+
+    PrintDistribution(
+        "FormatInformation (buffer)",
+        MeasureDistribution(
+            [&]()
+            {
+                g_sink += FormatInformation(snapshot, buffer, sizeof(buffer));
+            }
+        )
+    );
+
+    std::ostringstream stream;
+
+    PrintDistribution(
+        "operator << (snapshot)",
+        MeasureDistribution(
+            [&]()
+            {
+                stream.str(std::string());
+                stream << snapshot;
+                g_sink += static_cast<unsigned long long>(stream.tellp());
+            }
+        )
+    );
+
+    PrintDistribution(
+        "operator << (entry map)",
+        MeasureDistribution(
+            [&]()
+            {
+                stream.str(std::string());
+                stream << entries;
+                g_sink += static_cast<unsigned long long>(stream.tellp());
+            }
+        )
+    );
+
+    std::printf("\n");
+}
+
+static void BenchExporters()
+{
+    std::printf("Exporters (full snapshot):\n");
+
+    InformationSnapshot snapshot;
+    QueryInformation(snapshot);
+
+    static const struct
+    {
+        ExportFormat    format;
+        const char*     name;
+    }
+    formats[] =
+    {
+        { EXPORT_FORMAT_JSON,       "JSON"          },
+        { EXPORT_FORMAT_PROMETHEUS, "Prometheus"    },
+        { EXPORT_FORMAT_BINARY,     "Binary"        },
+    };
+
+    char buffer[16384];
+
+    for (const auto& fmt : formats)
+    {
+        std::size_t length = 0;
+
+        const double ns = MeasureNanoseconds(
+            100000, [&]()
+            {
+                length = ExportInformation(snapshot, fmt.format, buffer, sizeof(buffer));
+                g_sink += length;
+            }
+        );
+
+        std::printf(
+            "  %-36s %12.1f ns %12.0f snapshots/s %8u bytes\n",
+            fmt.name, ns, 1.0e9 / ns, static_cast<unsigned int>(length)
+        );
+    }
+
+    /* Measure reading the binary record back into a snapshot */
+    const std::size_t length = ExportInformation(snapshot, EXPORT_FORMAT_BINARY, buffer, sizeof(buffer));
+    InformationSnapshot decoded;
+
+    const double readNs = MeasureNanoseconds(
+        100000, [&]()
+        {
+            g_sink += ReadBinaryRecord(buffer, length, decoded);
+        }
+    );
+    std::printf("  %-36s %12.1f ns %12.0f snapshots/s\n", "ReadBinaryRecord", readNs, 1.0e9 / readNs);
+
+    std::printf("\n");
+}
+
+static void BenchCPUSampler()
+{
+    std::printf("CPU sampler:\n");
+
+    CPUSampler sampler;
+
+    const double ns = MeasureNanoseconds(
+        10000, [&]()
+        {
+            sampler.Sample();
+            g_sink += static_cast<unsigned long long>(sampler.GetTotalUsage().busy);
+        }
+    );
+    PrintResult("CPUSampler::Sample", ns);
+    std::printf("  %-36s %12u\n", "Logical CPUs", static_cast<unsigned int>(sampler.GetCPUCount()));
+
+    std::printf("\n");
+}
+
+static void BenchTimestampCounter()
+{
+    std::printf("Time-stamp counter:\n");
+
+    const double tscInfoNs = MeasureNanoseconds(
+        1, []()
+        {
+            g_sink += QueryTSCInfo().frequency;
+        }
+    );
+    PrintResult("QueryTSCInfo (first call)", tscInfoNs);
+
+    const double rdtscNs = MeasureNanoseconds(
+        1000000, []()
+        {
+            g_sink += ReadTimestampCounter();
+        }
+    );
+    PrintResult("ReadTimestampCounter", rdtscNs);
+
+    const double clockNs = MeasureNanoseconds(
+        1000000, []()
+        {
+            g_sink += static_cast<unsigned long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+    );
+    PrintResult("std::chrono::steady_clock::now", clockNs);
+
+    /* Compare TSC against the steady clock over a short interval */
+    const TSCInfo& tsc = QueryTSCInfo();
+    if (tsc.frequency > 0)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const unsigned long long startTSC = ReadTimestampCounter();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const unsigned long long endTSC = ReadTimestampCounter();
+        const double clockElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        const double tscElapsed = tsc.ToNanoseconds(endTSC - startTSC);
+
+        std::printf("  %-36s %12llu Hz (%s)\n", "TSC frequency", tsc.frequency, TSCSourceName(tsc.source));
+        std::printf("  %-36s %12.1f ppm\n", "TSC deviation from steady clock", (tscElapsed - clockElapsed) / clockElapsed * 1.0e6);
+    }
+
+    std::printf("\n");
+}
+
+static void BenchMemoryInfo()
+{
+    std::printf("Memory info:\n");
+
+    MemoryInfo info;
+
+    const double ns = MeasureNanoseconds(
+        100000, [&]()
+        {
+            QueryMemoryInfo(info);
+            g_sink += info.available;
+        }
+    );
+    PrintResult("QueryMemoryInfo", ns);
+    std::printf("  %-36s %12.0f samples/s\n", "QueryMemoryInfo", 1.0e9 / ns);
+
+    std::printf("\n");
+
+    PrintDistributionHeader("Huge pages");
+
+    HugePageInfo hugePages;
+
+    PrintDistribution(
+        "QueryHugePageInfo",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryHugePageInfo(hugePages);
+                g_sink += hugePages.pools.size();
+            }
+        )
+    );
+
+    TransparentHugePageInfo transparent;
+
+    PrintDistribution(
+        "QueryTransparentHugePages",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryTransparentHugePages(transparent);
+                g_sink += transparent.anonHugePages;
+            }
+        )
+    );
+
+    MemoryFragmentation fragmentation;
+
+    PrintDistribution(
+        "QueryMemoryFragmentation",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryMemoryFragmentation(fragmentation);
+                g_sink += fragmentation.GetAvailableBlocks(9);
+            }
+        )
+    );
+
+    std::printf("\n");
+}
+
+static void BenchStorage()
+{
+    PrintDistributionHeader("Storage");
+
+    BlockDeviceCounters counters;
+
+    PrintDistribution(
+        "QueryDiskCounters",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryDiskCounters(counters);
+                g_sink += counters.reads;
+            }
+        )
+    );
+
+    DiskSampler sampler;
+
+    PrintDistribution(
+        "DiskSampler::Sample",
+        MeasureDistribution(
+            [&]()
+            {
+                sampler.Sample();
+                g_sink += sampler.GetDeviceCount();
+            }
+        )
+    );
+
+    std::vector<BlockDevice> devices;
+
+    PrintDistribution(
+        "QueryBlockDevices",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryBlockDevices(devices);
+                g_sink += devices.size();
+            }
+        )
+    );
+
+    std::printf("\n");
+}
+
+static void BenchNetwork()
+{
+    PrintDistributionHeader("Network");
+
+    NetworkCounters counters;
+
+    PrintDistribution(
+        "QueryNetworkCounters",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryNetworkCounters(counters);
+                g_sink += counters.rxBytes;
+            }
+        )
+    );
+
+    PrintDistribution(
+        "QueryNetworkInterfaceCounters (lo)",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryNetworkInterfaceCounters("lo", counters);
+                g_sink += counters.rxBytes;
+            }
+        )
+    );
+
+    NetworkSampler sampler;
+
+    PrintDistribution(
+        "NetworkSampler::Sample",
+        MeasureDistribution(
+            [&]()
+            {
+                sampler.Sample();
+                g_sink += sampler.GetInterfaceCount();
+            }
+        )
+    );
+
+    NetworkStackCounters stackCounters;
+
+    PrintDistribution(
+        "QueryNetworkStackCounters",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryNetworkStackCounters(stackCounters);
+                g_sink += stackCounters.tcp.retransmittedSegments;
+            }
+        )
+    );
+
+    NetworkStackSampler stackSampler;
+
+    PrintDistribution(
+        "NetworkStackSampler::Sample",
+        MeasureDistribution(
+            [&]()
+            {
+                stackSampler.Sample();
+                g_sink += stackSampler.GetDelta().tcp.listenOverflows;
+            }
+        )
+    );
+
+    std::vector<NetworkInterface> interfaces;
+
+    PrintDistribution(
+        "QueryNetworkInterfaces",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryNetworkInterfaces(interfaces);
+                g_sink += interfaces.size();
+            }
+        )
+    );
+
+    std::printf("\n");
+}
+
+/*
+Measures the self-process queries. The sampler is measured once with the threads of the benchmark only
+and once with additional idle threads, since each thread adds one "stat" file to every sample.
+*/
+static void BenchProcess()
+{
+    PrintDistributionHeader("Process");
+
+    ProcessUsage usage;
+
+    PrintDistribution(
+        "QueryProcessUsage",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryProcessUsage(usage);
+                g_sink += usage.residentMemory;
+            }
+        )
+    );
+
+    ProcessMemoryDetails details;
+
+    PrintDistribution(
+        "QueryProcessMemoryDetails",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryProcessMemoryDetails(details);
+                g_sink += details.pss;
+            }
+        )
+    );
+
+    ProcessSampler sampler;
+
+    PrintDistribution(
+        "ProcessSampler::Sample",
+        MeasureDistribution(
+            [&]()
+            {
+                sampler.Sample();
+                g_sink += sampler.GetThreadCount();
+            }
+        )
+    );
+
+    /* Start idle threads that block until the measurement is done */
+    std::atomic<bool> quit(false);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        threads.emplace_back(
+            [&quit]()
+            {
+                while (!quit.load())
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        );
+    }
+
+    ProcessSampler threadSampler;
+
+    PrintDistribution(
+        "ProcessSampler::Sample (+64 threads)",
+        MeasureDistribution(
+            [&]()
+            {
+                threadSampler.Sample();
+                g_sink += threadSampler.GetThreadCount();
+            }
+        )
+    );
+
+    quit = true;
+    for (auto& thread : threads)
+        thread.join();
+
+    std::printf("\n");
+}
+
+static void BenchPressure()
+{
+    PrintDistributionHeader("Pressure stall information");
+
+    PressureInfo info;
+
+    PrintDistribution(
+        "QueryPressure (system)",
+        MeasureDistribution(
+            [&]()
+            {
+                QueryPressure(info);
+                g_sink += info.memory.some.total;
+            }
+        )
+    );
+
+    static const PressureScope scopes[] = { PRESSURE_SCOPE_SYSTEM, PRESSURE_SCOPE_CGROUP };
+    static const char* const names[] = { "PressureMonitor::Read (system)", "PressureMonitor::Read (cgroup)" };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        PressureMonitor monitor;
+        if (!monitor.Open(scopes[i]))
+        {
+            std::printf("  %-40s %12s\n", names[i], "unavailable");
+            continue;
+        }
+
+        PrintDistribution(
+            names[i],
+            MeasureDistribution(
+                [&]()
+                {
+                    monitor.Read(info);
+                    g_sink += info.memory.some.total;
+                }
+            )
+        );
+    }
+
+    std::printf("\n");
+}
+
+#ifdef __linux__
+
+// Writes the specified text into a file of a synthetic file system tree and creates all parent directories.
+static bool WriteSyntheticFile(const std::string& root, const std::string& filename, const std::string& text)
+{
+    const std::string path = root + filename;
+
+    for (std::size_t pos = root.size() + 1; (pos = path.find('/', pos)) != std::string::npos; ++pos)
+        mkdir(path.substr(0, pos).c_str(), 0755);
+
+    if (FILE* file = std::fopen(path.c_str(), "w"))
+    {
+        std::fputs(text.c_str(), file);
+        std::fclose(file);
+        return true;
+    }
+
+    return false;
+}
+
+static int RemoveSyntheticFile(const char* path, const struct stat*, int, struct FTW*)
+{
+    return remove(path);
+}
+
+static void RemoveSyntheticTree(const std::string& root)
+{
+    nftw(root.c_str(), RemoveSyntheticFile, 64, FTW_DEPTH | FTW_PHYS);
+}
+
+/*
+Creates a synthetic sysfs tree with 2 packages, 256 cores per package, 2 SMT siblings per core (1024 logical CPUs),
+and 4 NUMA nodes. The SMT siblings are enumerated like on most x86 machines, i.e. CPU 'i' and 'i + 512' share a core.
+*/
+static void CreateSyntheticTopology(const std::string& root, unsigned int packages, unsigned int coresPerPackage, unsigned int nodes)
+{
+    const unsigned int cores        = packages * coresPerPackage;
+    const unsigned int cpus         = cores * 2;
+    const unsigned int coresPerNode = cores / nodes;
+
+    char text[128];
+
+    std::snprintf(text, sizeof(text), "0-%u\n", cpus - 1);
+    WriteSyntheticFile(root, "/sys/devices/system/cpu/online", text);
+
+    for (unsigned int cpu = 0; cpu < cpus; ++cpu)
+    {
+        const unsigned int core = cpu % cores;
+        const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+
+        std::snprintf(text, sizeof(text), "%u,%u\n", core, core + cores);
+        WriteSyntheticFile(root, dir + "core_cpus_list", text);
+        WriteSyntheticFile(root, dir + "thread_siblings_list", text);
+
+        /* Each package has a single die */
+        const unsigned int first = core / coresPerPackage * coresPerPackage, last = first + coresPerPackage - 1;
+        std::snprintf(text, sizeof(text), "%u-%u,%u-%u\n", first, last, first + cores, last + cores);
+        WriteSyntheticFile(root, dir + "package_cpus_list", text);
+        WriteSyntheticFile(root, dir + "core_siblings_list", text);
+        WriteSyntheticFile(root, dir + "die_cpus_list", text);
+        WriteSyntheticFile(root, dir + "physical_package_id", std::to_string(core / coresPerPackage) + "\n");
+        WriteSyntheticFile(root, dir + "die_id", "0\n");
+        WriteSyntheticFile(root, dir + "core_id", std::to_string(core % coresPerPackage) + "\n");
+    }
+
+    std::snprintf(text, sizeof(text), "0-%u\n", nodes - 1);
+    WriteSyntheticFile(root, "/sys/devices/system/node/online", text);
+
+    for (unsigned int node = 0; node < nodes; ++node)
+    {
+        const unsigned int first = node * coresPerNode, last = first + coresPerNode - 1;
+        std::snprintf(text, sizeof(text), "%u-%u,%u-%u\n", first, last, first + cores, last + cores);
+        WriteSyntheticFile(root, "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", text);
+
+        std::string distances;
+        for (unsigned int other = 0; other < nodes; ++other)
+            distances += (other == node ? "10 " : "21 ");
+        distances.back() = '\n';
+        WriteSyntheticFile(root, "/sys/devices/system/node/node" + std::to_string(node) + "/distance", distances);
+
+        std::string meminfo;
+        meminfo += "Node " + std::to_string(node) + " MemTotal:       65536000 kB\n";
+        meminfo += "Node " + std::to_string(node) + " MemFree:        32768000 kB\n";
+        meminfo += "Node " + std::to_string(node) + " MemUsed:        32768000 kB\n";
+        meminfo += "Node " + std::to_string(node) + " FilePages:       8192000 kB\n";
+        WriteSyntheticFile(root, "/sys/devices/system/node/node" + std::to_string(node) + "/meminfo", meminfo);
+    }
+}
+
+/*
+Baseline that queries the topology per logical CPU, as a straightforward implementation would:
+it reads and parses all CPU lists and IDs in the topology directory of every CPU.
+*/
+static unsigned long long ReadAllTopologyFiles(const std::string& root, unsigned int cpus)
+{
+    static const char* listFiles[]  = { "core_cpus_list", "die_cpus_list", "package_cpus_list" };
+    static const char* idFiles[]    = { "core_id", "die_id", "physical_package_id" };
+
+    unsigned long long sum = 0;
+    char path[256];
+    char buffer[4096];
+    CPUSet siblings;
+
+    for (unsigned int cpu = 0; cpu < cpus; ++cpu)
+    {
+        for (const char* name : listFiles)
+        {
+            std::snprintf(path, sizeof(path), "%s/sys/devices/system/cpu/cpu%u/topology/%s", root.c_str(), cpu, name);
+            if (FILE* file = std::fopen(path, "r"))
+            {
+                const std::size_t len = std::fread(buffer, 1, sizeof(buffer), file);
+                std::fclose(file);
+                if (siblings.Parse(buffer, len))
+                    sum += siblings.Count();
+            }
+        }
+
+        for (const char* name : idFiles)
+        {
+            std::snprintf(path, sizeof(path), "%s/sys/devices/system/cpu/cpu%u/topology/%s", root.c_str(), cpu, name);
+            if (FILE* file = std::fopen(path, "r"))
+            {
+                const std::size_t len = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+                std::fclose(file);
+                buffer[len] = '\0';
+                sum += std::strtoull(buffer, NULL, 10);
+            }
+        }
+    }
+
+    return sum;
+}
+
+static void BenchSyntheticTopology()
+{
+    std::printf("CPU topology (synthetic, 2 packages x 256 cores x 2 SMT = 1024 CPUs, 4 nodes):\n");
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create synthetic file system tree\n\n");
+        return;
+    }
+
+    const std::string root = rootTemplate;
+    CreateSyntheticTopology(root, 2, 256, 4);
+
+    SetFileSystemRoot(root.c_str());
+
+    CPUTopology topology;
+
+    const double queryNs = MeasureNanoseconds(
+        20, [&]()
+        {
+            QueryCPUTopology(topology);
+            g_sink += topology.cores.size();
+        }
+    );
+    PrintResult("QueryCPUTopology", queryNs);
+
+    const double naiveNs = MeasureNanoseconds(
+        20, [&]()
+        {
+            g_sink += ReadAllTopologyFiles(root, 1024);
+        }
+    );
+    PrintResult("Per-CPU topology query (baseline)", naiveNs);
+
+    const double lookupNs = MeasureNanoseconds(
+        1000000, [&]()
+        {
+            const CPUTopology::LogicalCPU& cpu = topology.cpus[g_sink % topology.cpus.size()];
+            g_sink += cpu.node + cpu.core;
+        }
+    );
+    PrintResult("CPU -> core/node lookup", lookupNs);
+
+    NUMAInfo numa;
+
+    const double numaNs = MeasureNanoseconds(
+        20, [&]()
+        {
+            QueryNUMAInfo(numa);
+            g_sink += numa.nodes.size();
+        }
+    );
+    PrintResult("QueryNUMAInfo", numaNs);
+
+    const double numaMemoryNs = MeasureNanoseconds(
+        1000, [&]()
+        {
+            QueryNUMAMemory(numa);
+            g_sink += numa.nodes[0].free;
+        }
+    );
+    PrintResult("QueryNUMAMemory", numaMemoryNs);
+
+    const double distanceNs = MeasureNanoseconds(
+        1000000, [&]()
+        {
+            const int node = numa.GetCPUNode(static_cast<unsigned int>(g_sink % 1024));
+            g_sink += numa.GetDistance(static_cast<std::size_t>(node), 0);
+        }
+    );
+    PrintResult("CPU -> node distance lookup", distanceNs);
+
+    std::vector<CacheInfo> caches;
+    std::vector<CPUSet> masks;
+
+    PlacementRequest request;
+    request.workers = 1024;
+
+    for (int policy = PLACEMENT_ONE_PER_CORE; policy <= PLACEMENT_COMPACT_NODE; ++policy)
+    {
+        request.policy = static_cast<PlacementPolicy>(policy);
+
+        const double planNs = MeasureNanoseconds(
+            20, [&]()
+            {
+                PlanThreadPlacement(topology, caches, request, masks);
+                g_sink += masks.size();
+            }
+        );
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "PlanThreadPlacement (%s)", PlacementPolicyName(request.policy));
+        PrintResult(name, planNs);
+    }
+
+    std::printf(
+        "  %u packages, %u dies, %u cores, %u logical CPUs, %u nodes\n",
+        static_cast<unsigned int>(topology.packages.size()),
+        static_cast<unsigned int>(topology.dies.size()),
+        static_cast<unsigned int>(topology.cores.size()),
+        static_cast<unsigned int>(topology.online.Count()),
+        static_cast<unsigned int>(topology.nodes.size())
+    );
+
+    SetFileSystemRoot(NULL);
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+// Writes synthetic cpufreq directories for the specified number of CPUs.
+static void CreateSyntheticCPUFreq(const std::string& root, unsigned int cpus)
+{
+    WriteSyntheticFile(root, "/sys/devices/system/cpu/online", "0-" + std::to_string(cpus - 1) + "\n");
+
+    for (unsigned int i = 0; i < cpus; ++i)
+    {
+        const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(i) + "/cpufreq/";
+        WriteSyntheticFile(root, dir + "scaling_cur_freq", std::to_string(2000000 + i * 1000) + "\n");
+        WriteSyntheticFile(root, dir + "scaling_min_freq", "800000\n");
+        WriteSyntheticFile(root, dir + "scaling_max_freq", "3500000\n");
+        WriteSyntheticFile(root, dir + "cpuinfo_min_freq", "800000\n");
+        WriteSyntheticFile(root, dir + "cpuinfo_max_freq", "4200000\n");
+        WriteSyntheticFile(root, dir + "scaling_governor", "schedutil\n");
+    }
+}
+
+static void BenchSyntheticCPUFreq()
+{
+    std::printf("CPU frequencies (synthetic cpufreq, 256 CPUs):\n");
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create synthetic file system tree\n\n");
+        return;
+    }
+
+    const std::string root = rootTemplate;
+    CreateSyntheticCPUFreq(root, 256);
+
+    SetFileSystemRoot(root.c_str());
+
+    std::vector<CPUFrequency> frequencies;
+
+    const double ns = MeasureNanoseconds(
+        100, [&]()
+        {
+            QueryCPUFrequencies(frequencies);
+            g_sink += frequencies.back().current;
+        }
+    );
+    PrintResult("QueryCPUFrequencies", ns);
+    std::printf("  %-36s %12.1f ns\n", "QueryCPUFrequencies (per CPU)", ns / 256);
+
+    SetFileSystemRoot(NULL);
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+// Writes a synthetic "/proc/stat" file with the specified number of CPUs.
+static void CreateSyntheticProcStat(const std::string& root, unsigned int cpus, unsigned long long tick)
+{
+    std::string text = "cpu  " + std::to_string(tick*cpus*3) + " 0 " + std::to_string(tick*cpus) + " " + std::to_string(tick*cpus*6) + " 10 0 5 0 0 0\n";
+
+    for (unsigned int i = 0; i < cpus; ++i)
+    {
+        text += "cpu" + std::to_string(i) + " " + std::to_string(tick*3) + " 0 " + std::to_string(tick) + " ";
+        text += std::to_string(tick*6) + " 10 0 5 0 0 0\n";
+    }
+
+    text += "intr 123456 0 0 0 0\nctxt 987654\nbtime 1700000000\nprocesses 4242\nprocs_running 1\nprocs_blocked 0\n";
+    text += "softirq 1234 0 1 2 3 4 5 6 7 8 9\n";
+
+    WriteSyntheticFile(root, "/proc/stat", text);
+    WriteSyntheticFile(root, "/sys/devices/system/cpu/possible", "0-" + std::to_string(cpus - 1) + "\n");
+}
+
+static void BenchSyntheticSampler()
+{
+    std::printf("CPU sampler (synthetic /proc/stat):\n");
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create synthetic file system tree\n\n");
+        return;
+    }
+
+    const std::string root = rootTemplate;
+
+    SetFileSystemRoot(root.c_str());
+
+    const unsigned int cpuCounts[] = { 4, 64, 256, 1024 };
+
+    for (unsigned int cpus : cpuCounts)
+    {
+        CreateSyntheticProcStat(root, cpus, 1000);
+
+        CPUSampler sampler;
+
+        const double ns = MeasureNanoseconds(
+            10000, [&]()
+            {
+                sampler.Sample();
+                g_sink += static_cast<unsigned long long>(sampler.GetTotalUsage().busy);
+            }
+        );
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "CPUSampler::Sample (%u CPUs)", cpus);
+        PrintResult(name, ns);
+    }
+
+    SetFileSystemRoot(NULL);
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+// Writes a synthetic "/proc/diskstats" and "/sys/block" tree with the specified number of disks, each with 4 partitions.
+static void CreateSyntheticDisks(const std::string& root, unsigned int disks)
+{
+    std::string diskstats;
+
+    for (unsigned int i = 0; i < disks; ++i)
+    {
+        const std::string name = "sd" + std::string(1, static_cast<char>('a' + i / 26)) + std::string(1, static_cast<char>('a' + i % 26));
+        const std::string major = std::to_string(8 + i / 16);
+        const unsigned int minor = (i % 16) * 16;
+
+        diskstats += "   " + major + " " + std::to_string(minor) + " " + name + " 4511 1209 300232 1932 9087 7412 892344 40012 0 31280 41944 0 0 0 0 512 310\n";
+        for (unsigned int j = 1; j <= 4; ++j)
+            diskstats += "   " + major + " " + std::to_string(minor + j) + " " + name + std::to_string(j) + " 1127 302 75058 483 2271 1853 223086 10003 0 7820 10486 0 0 0 0 0 0\n";
+
+        const std::string dir = "/sys/block/" + name + "/";
+        WriteSyntheticFile(root, dir + "device/model", "Synthetic Disk\n");
+        WriteSyntheticFile(root, dir + "queue/logical_block_size", "512\n");
+        WriteSyntheticFile(root, dir + "queue/physical_block_size", "4096\n");
+        WriteSyntheticFile(root, dir + "queue/rotational", "0\n");
+        WriteSyntheticFile(root, dir + "queue/optimal_io_size", "0\n");
+        WriteSyntheticFile(root, dir + "queue/max_sectors_kb", "1280\n");
+        WriteSyntheticFile(root, dir + "queue/read_ahead_kb", "128\n");
+        WriteSyntheticFile(root, dir + "queue/nr_requests", "64\n");
+        WriteSyntheticFile(root, dir + "queue/scheduler", "[none] mq-deadline\n");
+    }
+
+    WriteSyntheticFile(root, "/proc/diskstats", diskstats);
+}
+
+static void BenchSyntheticDisks()
+{
+    std::printf("Storage (synthetic diskstats, 64 disks with 4 partitions each):\n");
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create synthetic file system tree\n\n");
+        return;
+    }
+
+    const std::string root = rootTemplate;
+    CreateSyntheticDisks(root, 64);
+
+    SetFileSystemRoot(root.c_str());
+
+    BlockDeviceCounters counters;
+    const double countersNs = MeasureNanoseconds(
+        100, [&]()
+        {
+            QueryDiskCounters(counters);
+            g_sink += counters.reads;
+        }
+    );
+    PrintResult("QueryDiskCounters", countersNs);
+
+    DiskSampler sampler;
+    const double samplerNs = MeasureNanoseconds(
+        1000, [&]()
+        {
+            sampler.Sample();
+            g_sink += sampler.GetCounters(0).reads;
+        }
+    );
+    PrintResult("DiskSampler::Sample", samplerNs);
+    std::printf("  %-36s %12.1f ns\n", "DiskSampler::Sample (per device)", samplerNs / sampler.GetDeviceCount());
+
+    SetFileSystemRoot(NULL);
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+// Writes a synthetic "/proc/net/dev" and "/sys/class/net" tree with the loopback interface and the specified number of virtual interfaces.
+static void CreateSyntheticInterfaces(const std::string& root, unsigned int count)
+{
+    std::string netdev =
+        "Inter-|   Receive                                                |  Transmit\n"
+        " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed\n";
+
+    for (unsigned int i = 0; i <= count; ++i)
+    {
+        const std::string name = (i == 0 ? std::string("lo") : "veth" + std::to_string(i - 1));
+
+        netdev += std::string(name.size() < 6 ? 6 - name.size() : 0, ' ') + name + ": 83125012   17700    0    0    0     0          0         0 83125012   17700    0    0    0     0       0          0\n";
+
+        const std::string dir = "/sys/class/net/" + name + "/";
+        WriteSyntheticFile(root, dir + "ifindex", std::to_string(i + 1) + "\n");
+        WriteSyntheticFile(root, dir + "mtu", (i == 0 ? "65536\n" : "1500\n"));
+        WriteSyntheticFile(root, dir + "flags", (i == 0 ? "0x9\n" : "0x1003\n"));
+        WriteSyntheticFile(root, dir + "carrier", "1\n");
+        WriteSyntheticFile(root, dir + "queues/rx-0/rps_cpus", "0\n");
+        WriteSyntheticFile(root, dir + "queues/tx-0/xps_cpus", "0\n");
+    }
+
+    WriteSyntheticFile(root, "/proc/net/dev", netdev);
+}
+
+static void BenchSyntheticInterfaces()
+{
+    std::printf("Network (synthetic net/dev, 256 interfaces):\n");
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (!mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create synthetic file system tree\n\n");
+        return;
+    }
+
+    const std::string root = rootTemplate;
+    CreateSyntheticInterfaces(root, 255);
+
+    SetFileSystemRoot(root.c_str());
+
+    NetworkCounters counters;
+    const double countersNs = MeasureNanoseconds(
+        1000, [&]()
+        {
+            QueryNetworkCounters(counters);
+            g_sink += counters.rxBytes;
+        }
+    );
+    PrintResult("QueryNetworkCounters", countersNs);
+
+    NetworkSampler sampler;
+    const double samplerNs = MeasureNanoseconds(
+        1000, [&]()
+        {
+            sampler.Sample();
+            g_sink += sampler.GetCounters(0).rxBytes;
+        }
+    );
+    PrintResult("NetworkSampler::Sample", samplerNs);
+    std::printf("  %-36s %12.1f ns\n", "NetworkSampler::Sample (per interface)", samplerNs / sampler.GetInterfaceCount());
+
+    SetFileSystemRoot(NULL);
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+static const char* const g_profileStartupArg = "--profile-startup";
+
+// Entry point of the child processes of 'BenchProfileCache': prints the latency (in nanoseconds) of the first call of 'GetHardwareProfile'.
+static int RunProfileStartup(const char* cacheFilename)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    if (cacheFilename != NULL)
+        EnableProfileCache(cacheFilename);
+
+    const Clock::time_point start = Clock::now();
+    g_sink += GetHardwareProfile().GetNumber(ENTRY_PROCESSORS);
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    std::printf("%.1f %d\n", ns, (IsHardwareProfileCached() ? 1 : 0));
+    return 0;
+}
+
+// Runs the specified command in new processes and returns the sorted latencies of all processes that loaded the profile as expected.
+static std::vector<double> MeasureProfileStartup(const std::string& command, unsigned int processes, bool expectCached)
+{
+    std::vector<double> samples;
+
+    for (unsigned int i = 0; i < processes; ++i)
+    {
+        if (FILE* pipe = popen(command.c_str(), "r"))
+        {
+            double ns = 0.0;
+            int cached = 0;
+            if (std::fscanf(pipe, "%lf %d", &ns, &cached) == 2 && (cached != 0) == expectCached)
+                samples.push_back(ns);
+            pclose(pipe);
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+static void PrintProfileStartup(const char* name, const std::vector<double>& samples)
+{
+    if (samples.empty())
+        std::printf("  %-40s %12s\n", name, "failed");
+    else
+    {
+        std::printf(
+            "  %-40s %9.1f us %9.1f us %9.1f us %8u\n",
+            name, samples.front() * 1.0e-3, samples[samples.size() / 2] * 1.0e-3, samples.back() * 1.0e-3,
+            static_cast<unsigned int>(samples.size())
+        );
+    }
+}
+
+/*
+Measures the startup cost of short-lived processes, i.e. the first call of 'GetHardwareProfile',
+once without the profile cache (cold query) and once with the profile cache (cached load).
+The hardware profile is only queried once per process, so each sample is taken in a new process of this benchmark.
+*/
+static void BenchProfileCache()
+{
+    std::printf("Hardware profile startup (first GetHardwareProfile in a new process):\n");
+    std::printf("  %-40s %12s %12s %12s %8s\n", "", "min", "p50", "max", "samples");
+
+    char exePath[512];
+    const ssize_t exePathLen = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+
+    char rootTemplate[] = "/tmp/SystemIndicatorBench-XXXXXX";
+    if (exePathLen <= 0 || !mkdtemp(rootTemplate))
+    {
+        std::printf("  failed to create cache directory\n\n");
+        return;
+    }
+    exePath[exePathLen] = '\0';
+
+    const std::string root              = rootTemplate;
+    const std::string cacheFilename     = root + "/profile.bin";
+    const std::string command           = std::string("'") + exePath + "' " + g_profileStartupArg;
+    const std::string cachedCommand     = command + " '" + cacheFilename + "'";
+    const unsigned int processes        = 20;
+
+    PrintProfileStartup("Cold query", MeasureProfileStartup(command, processes, false));
+
+    /* The first process with the cache enabled writes the cache file for all subsequent processes */
+    MeasureProfileStartup(cachedCommand, 1, false);
+    PrintProfileStartup("Cached load", MeasureProfileStartup(cachedCommand, processes, true));
+
+    std::printf("\n");
+
+    /* Measure the cache file functions within this process */
+    PrintDistributionHeader("Hardware profile cache file");
+
+    const InformationSnapshot& profile = GetHardwareProfile();
+    InformationSnapshot loadedProfile;
+
+    PrintDistribution(
+        "SaveHardwareProfile",
+        MeasureDistribution(
+            [&]()
+            {
+                g_sink += SaveHardwareProfile(cacheFilename.c_str(), profile);
+            }
+        )
+    );
+
+    PrintDistribution(
+        "LoadHardwareProfile",
+        MeasureDistribution(
+            [&]()
+            {
+                g_sink += LoadHardwareProfile(cacheFilename.c_str(), loadedProfile);
+            }
+        )
+    );
+
+    RemoveSyntheticTree(root);
+
+    std::printf("\n");
+}
+
+#endif
+
+// Memory-bound kernel (STREAM triad) that each worker runs on its own arrays.
+static void RunTriadWorker(const CPUSet& mask, std::size_t count, unsigned int repetitions, std::atomic<unsigned int>& ready, std::atomic<bool>& start)
+{
+    SetThreadAffinity(mask);
+
+    /* Allocate arrays after pinning, so the pages are allocated on the local NUMA node */
+    std::vector<double> a(count, 1.0), b(count, 2.0), c(count, 0.0);
+
+    ++ready;
+    while (!start.load())
+        std::this_thread::yield();
+
+    for (unsigned int r = 0; r < repetitions; ++r)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            c[i] = a[i] + 3.0 * b[i];
+        a.swap(c);
+    }
+
+    g_sink += static_cast<unsigned long long>(a[count / 2]);
+}
+
+/*
+Total working set of the triad kernel (192 MB), which is divided among the workers so memory usage doesn't grow with the worker count.
+Each worker keeps at least 3 MB, which still exceeds the private caches, and the number of workers is limited.
+*/
+static const std::size_t    g_triadTotalCount   = 8*1024*1024;
+static const std::size_t    g_triadMinCount     = 128*1024;
+static const unsigned int   g_triadMaxWorkers   = 64;
+
+// Returns the bandwidth (in GB/s) of the triad kernel with the specified worker affinity masks.
+static double MeasureTriadBandwidth(const std::vector<CPUSet>& masks)
+{
+    static const unsigned int repetitions = 10;
+
+    const std::size_t count = std::max(g_triadTotalCount / masks.size(), g_triadMinCount);
+
+    std::atomic<unsigned int> ready(0);
+    std::atomic<bool> start(false);
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < masks.size(); ++i)
+        workers.push_back(std::thread(RunTriadWorker, std::cref(masks[i]), count, repetitions, std::ref(ready), std::ref(start)));
+
+    while (ready.load() < masks.size())
+        std::this_thread::yield();
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point startTime = Clock::now();
+
+    start = true;
+    for (std::thread& worker : workers)
+        worker.join();
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    const double bytes = static_cast<double>(masks.size()) * repetitions * count * sizeof(double) * 3;
+
+    return bytes / seconds * 1.0e-9;
+}
+
+static void BenchPlacementScaling()
+{
+    std::printf("Placement scaling (STREAM triad, 192 MB divided among the workers):\n");
+
+    CPUTopology topology;
+    if (!QueryCPUTopology(topology))
+    {
+        std::printf("  CPU topology not available\n\n");
+        return;
+    }
+
+    const unsigned int maxWorkers = std::min(static_cast<unsigned int>(topology.online.Count()), g_triadMaxWorkers);
+
+    std::printf("  %-16s", "workers");
+    for (unsigned int workers = 1; workers <= maxWorkers; workers *= 2)
+        std::printf(" %12u", workers);
+    std::printf("\n");
+
+    std::vector<CPUSet> masks;
+
+    for (int policy = PLACEMENT_ONE_PER_CORE; policy <= PLACEMENT_COMPACT_NODE; ++policy)
+    {
+        std::printf("  %-16s", PlacementPolicyName(static_cast<PlacementPolicy>(policy)));
+
+        for (unsigned int workers = 1; workers <= maxWorkers; workers *= 2)
+        {
+            PlacementRequest request;
+            request.workers = workers;
+            request.policy  = static_cast<PlacementPolicy>(policy);
+
+            if (PlanThreadPlacement(request, masks))
+                std::printf(" %7.1f GB/s", MeasureTriadBandwidth(masks));
+            else
+                std::printf(" %12s", "n/a");
+        }
+
+        std::printf("\n");
+    }
+
+    std::printf("\n");
+}
+
+// Reads snapshots from the background collector and accumulates the elapsed time (in nanoseconds) of all reads.
+static void RunCollectorReader(const BackgroundCollector& collector, bool fullSnapshot, unsigned int reads, std::atomic<bool>& start, std::atomic<unsigned long long>& elapsed)
+{
+    InformationSnapshot snapshot;
+
+    while (!start.load())
+        std::this_thread::yield();
+
+    const double ns = MeasureNanoseconds(
+        reads, [&]()
+        {
+            if (fullSnapshot)
+            {
+                collector.Read(snapshot);
+                g_sink += snapshot.GetNumber(ENTRY_FREE_MEMORY);
+            }
+            else
+                g_sink += collector.GetNumber(ENTRY_FREE_MEMORY);
+        }
+    );
+
+    elapsed += static_cast<unsigned long long>(ns * reads);
+}
+
+// Returns the average duration (in nanoseconds) of a read with the specified number of concurrent reader threads.
+static double MeasureCollectorReads(const BackgroundCollector& collector, bool fullSnapshot, unsigned int readers)
+{
+    static const unsigned int reads = 20000;
+
+    std::atomic<bool> start(false);
+    std::atomic<unsigned long long> elapsed(0);
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < readers; ++i)
+        threads.push_back(std::thread(RunCollectorReader, std::cref(collector), fullSnapshot, reads, std::ref(start), std::ref(elapsed)));
+
+    start = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    return static_cast<double>(elapsed.load()) / (static_cast<double>(reads) * readers);
+}
+
+static void BenchBackgroundCollector()
+{
+    std::printf("Background collector (1 writer without interval, %u hardware threads):\n", std::thread::hardware_concurrency());
+
+    BackgroundCollectorConfig config;
+    config.interval = 0;
+
+    BackgroundCollector collector(config);
+    collector.Start();
+
+    while (collector.GetSampleCount() == 0)
+        std::this_thread::yield();
+
+    std::printf("  %-10s %16s %16s\n", "readers", "Read", "GetNumber");
+
+    for (unsigned int readers = 1; readers <= 64; readers *= 2)
+    {
+        const double readNs     = MeasureCollectorReads(collector, true, readers);
+        const double numberNs   = MeasureCollectorReads(collector, false, readers);
+        std::printf("  %-10u %13.1f ns %13.1f ns\n", readers, readNs, numberNs);
+    }
+
+    collector.Stop();
+
+    std::printf("  %-36s %12llu\n", "Published snapshots", collector.GetSampleCount());
+    std::printf("\n");
+}
+
+static void BenchMemoryProbe()
+{
+    MemoryProbeConfig config;
+    config.latencyCurve = true;
+
+    MemoryProbe probe;
+
+    const double ns = MeasureNanoseconds(
+        1, [&]()
+        {
+            MeasureMemoryHierarchy(probe, config);
+        }
+    );
+
+    std::printf("Memory hierarchy probe (%.0f ms):\n", ns * 1.0e-6);
+
+    for (const MemoryLevelLatency& level : probe.levels)
+    {
+        char name[128];
+        if (level.level > 0)
+            std::snprintf(name, sizeof(name), "L%u latency (%llu KB nominal, %llu KB set)", level.level, level.nominalSize / 1024, level.workingSet / 1024);
+        else
+            std::snprintf(name, sizeof(name), "DRAM latency (%llu KB set)", level.workingSet / 1024);
+        PrintResult(name, level.latency);
+    }
+
+    std::printf("  %-36s", "Latency curve (KB: ns)");
+    for (std::size_t i = 0; i < probe.latencyCurve.size(); ++i)
+        std::printf("%s %llu: %.1f", (i % 6 == 0 && i > 0 ? "\n  " : (i > 0 ? "," : "")), probe.latencyCurve[i].workingSet / 1024, probe.latencyCurve[i].latency);
+    std::printf("\n");
+
+    std::printf("  %-36s %9.1f GB/s %9.1f GB/s %9.1f GB/s\n", "Bandwidth read/write/copy (1 thread)", probe.singleThread.read, probe.singleThread.write, probe.singleThread.copy);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "Bandwidth read/write/copy (%u threads)", probe.threads);
+    std::printf("  %-36s %9.1f GB/s %9.1f GB/s %9.1f GB/s\n", name, probe.allThreads.read, probe.allThreads.write, probe.allThreads.copy);
+
+    std::printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    #ifdef __linux__
+    if (argc >= 2 && std::strcmp(argv[1], g_profileStartupArg) == 0)
+        return RunProfileStartup(argc >= 3 ? argv[2] : NULL);
+    #endif
+
+    BenchCollectors();
+    BenchQueries();
+    BenchExporters();
+    BenchMemoryInfo();
+    BenchPressure();
+    BenchStorage();
+    BenchNetwork();
+    BenchProcess();
+    BenchCPUSampler();
+    BenchTimestampCounter();
+    #ifdef __linux__
+    BenchSyntheticTopology();
+    BenchSyntheticSampler();
+    BenchSyntheticCPUFreq();
+    BenchSyntheticDisks();
+    BenchSyntheticInterfaces();
+    BenchProfileCache();
+    #endif
+    BenchBackgroundCollector();
+    BenchPlacementScaling();
+    BenchMemoryProbe();
+    return 0;
+}
@@ -6,17 +6,234 @@
  */
 
 #include <SystemIndicator.h>
+#include <SystemIndicatorDispatch.h>
+#include <SystemIndicatorExport.h>
+#include <SystemIndicatorTopology.h>
+#include <SystemIndicatorFrequency.h>
+#include <SystemIndicatorLimits.h>
+#include <SystemIndicatorMemory.h>
+#include <SystemIndicatorPressure.h>
+#include <SystemIndicatorNetwork.h>
+#include <SystemIndicatorProcess.h>
+#include <SystemIndicatorSampler.h>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <thread>
+
+static const char* KernelScalar()
+{
+    return "scalar kernel";
+}
+
+static const char* KernelAVX2()
+{
+    return "AVX2 kernel";
+}
 
 int main()
 {
     std::cout << SystemIndicator::QueryInformation();
 
+    /* Bind kernel for the host CPU */
+    SystemIndicator::FunctionDispatcher<const char*()> kernel(KernelScalar);
+    kernel.Register(SystemIndicator::DISPATCH_TIER_AVX2, KernelAVX2);
+
+    std::cout << std::endl << "Dispatch Tier:    " << SystemIndicator::DispatchTierName(SystemIndicator::GetSupportedDispatchTier()) << " (" << kernel() << ')' << std::endl;
+
+    /* Print CPU topology */
+    SystemIndicator::CPUTopology topology;
+    if (SystemIndicator::QueryCPUTopology(topology))
+    {
+        std::cout << std::endl << "Topology:         " << topology.packages.size() << " package(s), " << topology.dies.size() << " die(s), ";
+        std::cout << topology.cores.size() << " core(s), " << topology.online.Count() << " logical CPU(s), " << topology.nodes.size() << " node(s)" << std::endl;
+    }
+
+    /* Print resource limits */
+    SystemIndicator::ResourceLimits limits;
+    if (SystemIndicator::QueryResourceLimits(limits))
+    {
+        std::cout << "Resource Limits:  cgroup v" << limits.cgroupVersion << ", " << limits.effectiveCPUs << " of " << limits.hostCPUs << " CPU(s)";
+        if (limits.cpuQuota > 0.0)
+            std::cout << " (quota " << limits.cpuQuota << ')';
+        std::cout << ", " << limits.effectiveMemory / 1024 << " of " << limits.hostMemory / 1024 << " MB";
+        std::cout << ", throttled " << limits.throttledPeriods << '/' << limits.periods << " periods (" << limits.throttledTime << " us)" << std::endl;
+    }
+
+    /* Print pressure stall information of the cgroup */
+    SystemIndicator::PressureInfo pressure;
+    if (SystemIndicator::QueryPressure(pressure, SystemIndicator::PRESSURE_SCOPE_CGROUP))
+    {
+        std::cout << "Cgroup Pressure:  cpu " << pressure.cpu.some.avg10 << "%, memory " << pressure.memory.some.avg10 << "% (full ";
+        std::cout << pressure.memory.full.avg10 << "%), io " << pressure.io.some.avg10 << "% (full " << pressure.io.full.avg10 << "%) over 10s" << std::endl;
+    }
+
+    /* Print CPU utilization over a short interval */
+    SystemIndicator::CPUSampler sampler;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (sampler.Sample())
+    {
+        const auto& usage = sampler.GetTotalUsage();
+        std::cout << "CPU Usage:         " << usage.busy << "% busy (" << usage.user << "% user, " << usage.system << "% system, " << usage.iowait << "% iowait)";
+        for (std::size_t i = 0; i < sampler.GetCPUCount(); ++i)
+            std::cout << (i == 0 ? ", per CPU:" : "") << ' ' << sampler.GetUsage(i).busy << '%';
+        std::cout << std::endl;
+    }
+
+    /* Print CPU frequencies */
+    std::vector<SystemIndicator::CPUFrequency> frequencies;
+    if (SystemIndicator::QueryCPUFrequencies(frequencies))
+    {
+        for (const auto& frequency : frequencies)
+        {
+            std::cout << "CPU " << frequency.cpu << " Frequency:   " << frequency.current / 1000 << " MHz";
+            if (frequency.maximum > 0)
+                std::cout << " (" << frequency.minimum / 1000 << " - " << frequency.maximum / 1000 << " MHz, hardware " << frequency.hardwareMin / 1000 << " - " << frequency.hardwareMax / 1000 << " MHz)";
+            if (frequency.governor[0] != '\0')
+                std::cout << ", governor " << frequency.governor;
+            std::cout << std::endl;
+        }
+    }
+
+    const SystemIndicator::TSCInfo& tsc = SystemIndicator::QueryTSCInfo();
+    if (tsc.frequency > 0)
+        std::cout << "TSC Frequency:     " << tsc.frequency << " Hz (" << SystemIndicator::TSCSourceName(tsc.source) << (tsc.invariant ? ", invariant" : "") << ')' << std::endl;
+
+    /* Print NUMA nodes */
+    SystemIndicator::NUMAInfo numa;
+    if (SystemIndicator::QueryNUMAInfo(numa))
+    {
+        for (std::size_t i = 0; i < numa.nodes.size(); ++i)
+        {
+            const auto& node = numa.nodes[i];
+            char cpus[256];
+            node.cpus.Format(cpus, sizeof(cpus));
+            std::cout << "NUMA Node " << node.id << ":      " << node.free / 1024 << " / " << node.total / 1024 << " MB free, " << node.filePages / 1024 << " MB file pages, CPUs [" << cpus << "], distances";
+            for (std::size_t j = 0; j < numa.nodes.size(); ++j)
+                std::cout << ' ' << numa.GetDistance(i, j);
+            std::cout << std::endl;
+        }
+    }
+
+    /* Print huge page pools, transparent huge pages, and whether a huge page can be allocated without compaction */
+    SystemIndicator::HugePageInfo hugePages;
+    if (SystemIndicator::QueryHugePageInfo(hugePages))
+    {
+        static const char* modeNames[]      = { "unknown", "always", "madvise", "never" };
+        static const char* defragNames[]    = { "unknown", "always", "defer", "defer+madvise", "madvise", "never" };
+
+        std::cout << "Page Sizes:        " << hugePages.basePageSize << " KB";
+        for (const auto& pool : hugePages.pools)
+            std::cout << ", " << pool.pageSize << " KB (" << pool.free << " / " << pool.total << " free, " << pool.reserved << " reserved)";
+        std::cout << std::endl;
+
+        for (const auto& pool : hugePages.nodePools)
+            std::cout << "  NUMA Node " << pool.node << ": " << pool.pageSize << " KB (" << pool.free << " / " << pool.total << " free)" << std::endl;
+
+        const auto& thp = hugePages.transparent;
+        std::cout << "Transparent Huge:  " << modeNames[thp.mode] << ", defrag " << defragNames[thp.defrag] << ", " << thp.pageSize << " KB pages, ";
+        std::cout << thp.anonHugePages / 1024 << " MB anonymous" << std::endl;
+    }
+
+    SystemIndicator::MemoryFragmentation fragmentation;
+    if (SystemIndicator::QueryMemoryFragmentation(fragmentation))
+    {
+        for (const auto& zone : fragmentation.zones)
+        {
+            std::cout << "Memory Zone " << zone.node << '/' << zone.zone << ": " << zone.GetFreePages() << " free page(s), " << zone.GetAvailableBlocks(9) << " free order-9 block(s), ";
+            std::cout << static_cast<int>(zone.GetUnusableFreeSpace(9) * 100.0 + 0.5) << "% unusable for order 9" << std::endl;
+        }
+    }
+
+    /* Print network interfaces */
+    std::vector<SystemIndicator::NetworkInterface> interfaces;
+    if (SystemIndicator::QueryNetworkInterfaces(interfaces))
+    {
+        for (const auto& networkInterface : interfaces)
+        {
+            SystemIndicator::NetworkCounters counters;
+            SystemIndicator::QueryNetworkInterfaceCounters(networkInterface.name, counters);
+
+            std::cout << "Network " << networkInterface.name << ":  ";
+            std::cout << (networkInterface.up ? "up" : "down") << (networkInterface.loopback ? " (loopback)" : "") << ", MTU " << networkInterface.mtu;
+            if (networkInterface.speed > 0)
+                std::cout << ", " << networkInterface.speed << " Mbit/s";
+            std::cout << ", " << networkInterface.rxQueues << " rx / " << networkInterface.txQueues << " tx queue(s)";
+            if (networkInterface.numaNode >= 0)
+                std::cout << ", NUMA node " << networkInterface.numaNode;
+            std::cout << ", " << counters.rxBytes << " B received, " << counters.txBytes << " B sent" << std::endl;
+        }
+    }
+
+    /* Print TCP/IP stack health over a short interval */
+    SystemIndicator::NetworkStackSampler stackSampler;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (stackSampler.Sample())
+    {
+        const auto& delta = stackSampler.GetDelta();
+        std::cout << "TCP/IP Stack:      " << delta.tcp.retransmittedSegments << " of " << delta.tcp.outSegments << " segment(s) retransmitted, ";
+        std::cout << delta.tcp.listenOverflows << " listen overflow(s), " << delta.tcp.backlogDrops << " backlog drop(s), ";
+        std::cout << delta.sockets.tcpInUse << " TCP socket(s), " << delta.sockets.udpInUse << " UDP socket(s) in " << stackSampler.GetInterval() << " s" << std::endl;
+    }
+
+    /* Print resource usage of this process and the CPU usage of its threads over a short interval */
+    SystemIndicator::ProcessSampler processSampler;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (processSampler.Sample())
+    {
+        const auto& usage = processSampler.GetUsage();
+        std::cout << "Process:           " << usage.residentMemory / 1024 << " KB resident (peak " << usage.peakResidentMemory / 1024 << " KB), ";
+        std::cout << usage.minorFaults << " minor/" << usage.majorFaults << " major fault(s), ";
+        std::cout << usage.voluntaryContextSwitches << " voluntary/" << usage.involuntaryContextSwitches << " involuntary switch(es), ";
+        std::cout << usage.openFiles << " open file(s)" << std::endl;
+
+        for (std::size_t i = 0; i < processSampler.GetThreadCount(); ++i)
+        {
+            const auto& thread = processSampler.GetThread(i);
+            std::cout << "  Thread " << thread.id << " (" << thread.name << "): " << thread.cpuUsage << "% CPU, state " << thread.state;
+            std::cout << ", last on CPU " << thread.processor << std::endl;
+        }
+    }
+
+    SystemIndicator::ProcessMemoryDetails memoryDetails;
+    if (SystemIndicator::QueryProcessMemoryDetails(memoryDetails))
+    {
+        std::cout << "Process Memory:    " << memoryDetails.rss / 1024 << " KB RSS, " << memoryDetails.pss / 1024 << " KB PSS, ";
+        std::cout << memoryDetails.privateDirty / 1024 << " KB private dirty, " << memoryDetails.swap / 1024 << " KB swapped" << std::endl;
+    }
+
+    /* Print cache hierarchy */
+    std::vector<SystemIndicator::CacheInfo> caches;
+    if (SystemIndicator::QueryCacheInfo(caches))
+    {
+        static const char* typeNames[] = { "Unified", "Data", "Instruction" };
+
+        std::cout << std::endl;
+        for (const auto& cache : caches)
+        {
+            std::cout << "L" << cache.level << ' ' << typeNames[cache.type] << ": " << cache.instanceCount << "x " << cache.size / 1024 << " KB";
+            std::cout << ", " << cache.lineSize << " B line, " << cache.ways << "-way";
+            for (const auto& instance : cache.instances)
+            {
+                char cpus[256];
+                instance.cpus.Format(cpus, sizeof(cpus));
+                std::cout << " [" << cpus << ']';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /* Print snapshot as JSON */
+    SystemIndicator::InformationSnapshot snapshot;
+    SystemIndicator::QueryInformation(snapshot);
+
+    char json[8192];
+    SystemIndicator::ExportInformation(snapshot, SystemIndicator::EXPORT_FORMAT_JSON, json, sizeof(json));
+    std::cout << std::endl << json;
+
     #ifdef _WIN32
     system("pause");
     #endif
 
     return 0;
 }
-